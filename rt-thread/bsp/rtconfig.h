@@ -39,6 +39,14 @@
 //  <i>Default: 512
 #define RT_MAIN_THREAD_STACK_SIZE     256
 
+// <c1>Using deferred components initialization
+//  <i>Run the INIT_DEFERRED_EXPORT functions in a low priority thread after main starts
+//#define RT_USING_DEFERRED_INIT
+// </c>
+// <o>the stack size of deferred initialization thread<1-4086>
+//  <i>Default: 2048
+#define RT_DEFERRED_INIT_STACK_SIZE   1024
+
 // </h>
 
 // <h>Debug Configuration
@@ -49,10 +57,30 @@
 // <o>enable components initialization debug configuration<0-1>
 //  <i>Default: 0
 #define RT_DEBUG_INIT 0
+// <c1>boot time profiler
+//  <i>Time of each components initialization function, msh command: bootprof
+//#define RT_USING_BOOT_PROFILE
+// </c>
 // <c1>thread stack over flow detect
 //  <i> Diable Thread stack over flow detect
 //#define RT_USING_OVERFLOW_CHECK
 // </c>
+// <c1>scheduling latency measurement
+//  <i>Per-priority wakeup-to-run latency histogram, msh command: sched_latency
+//#define RT_USING_SCHED_LATENCY
+// </c>
+// <c1>kernel event trace
+//  <i>Record kernel events to a ring buffer (components/trace), msh command: trace
+//#define RT_USING_TRACE
+// </c>
+// <c1>binary log
+//  <i>Record the format address and arguments of rt_binlog (components/binlog), rendered on host by tools/binlog2txt.py
+//#define RT_USING_BINLOG
+// </c>
+// <c1>runtime log level of tags
+//  <i>LOG_X of rtdbg.h are filtered by the runtime level of DBG_TAG, msh command: dbg_level
+//#define RT_USING_DBG_TAG_LEVEL
+// </c>
 // </h>
 
 // <h>Hook Configuration
@@ -112,10 +140,52 @@
 //  <i>using small memory
 #define RT_USING_SMALL_MEM
 // </c>
+// <c1>recycle the memory of dynamic threads
+//  <i>Reuse the object and stack of deleted threads in rt_thread_create
+//#define RT_USING_THREAD_CACHE
+// </c>
+// <c1>allocate thread object with its stack
+//  <i>One memory block for the object and stack of a dynamic thread
+//#define RT_USING_THREAD_COLOCATED_STACK
+// </c>
+// <c1>allocate kernel objects from object caches
+//  <i>Dynamic kernel objects are allocated from per class caches based on memory pool
+//  <i>Requires RT_USING_MEMPOOL
+//#define RT_USING_KMEM_CACHE
+// </c>
+// <c1>cache small heap chunks in magazines
+//  <i>Recently freed small chunks are cached per size class, and filled or drained in batches
+//#define RT_USING_HEAP_MAGAZINE
+// </c>
+// <c1>heap fragmentation information
+//  <i>Count the free blocks and the heap used by each thread incrementally, shown by "list heap"
+//#define RT_USING_HEAP_INFO
+// </c>
+// <c1>sampled heap profiler
+//  <i>Sample the allocations by call site, shown by msh command "heapprof"
+//#define RT_USING_HEAP_PROFILE
+// </c>
+// <c1>memory pool set
+//  <i>Serve small allocations from the smallest fitting memory pool of power-of-two block sizes
+//  <i>Requires RT_USING_MEMPOOL
+//#define RT_USING_MPSET
+// </c>
 // <c1>using tiny size of memory
 //  <i>using tiny size of memory
 //#define RT_USING_TINY_SIZE
 // </c>
+// <c1>optimized memory routines of CPU
+//  <i>rt_memcpy/rt_memset/rt_memmove/rt_memcmp of libcpu override the generic ones
+//#define RT_USING_CPU_MEMFUNC
+// </c>
+// <c1>compact thread control block
+//  <i>Scheduler fields first and a minimal timeout node instead of the built-in timer
+//#define RT_USING_THREAD_COMPACT
+// </c>
+// <c1>refer to object names
+//  <i>Objects keep the pointer of name instead of a copy, the name shall be a constant string
+//#define RT_USING_OBJECT_NAME_REF
+// </c>
 // </h>
 
 // <h>Console Configuration
@@ -127,6 +197,10 @@
 //  <i>the buffer size of console
 //  <i>Default: 128  (128Byte)
 #define RT_CONSOLEBUF_SIZE          128
+// <c1>asynchronous console
+//  <i>Console output is buffered and written out by a low priority thread, msh command: console_stat
+//#define RT_USING_CONSOLE_ASYNC
+// </c>
 // </h>
 
 #if defined(RT_USING_FINSH)
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "binlog.h"
+
+#ifdef RT_USING_BINLOG
+
+#if (RT_BINLOG_BUFFER_SIZE & (RT_BINLOG_BUFFER_SIZE - 1)) != 0
+#error "RT_BINLOG_BUFFER_SIZE must be power of 2"
+#endif
+
+#define BINLOG_MASK                     (RT_BINLOG_BUFFER_SIZE - 1)
+
+/*
+ * The log buffer is a ring of words, a record is the format address, the
+ * number of arguments, the timestamp and the arguments. The writer never
+ * waits: a record which does not fit is dropped, so the records in buffer
+ * are always whole. The indexes are free running and only masked when the
+ * buffer is accessed.
+ *
+ * A record is written in one piece, the words past the end of ring go to
+ * the spare words behind it, and are moved to the start of ring at last.
+ */
+static rt_ubase_t binlog_buffer[RT_BINLOG_BUFFER_SIZE + RT_BINLOG_HEADER_SIZE + RT_BINLOG_ARGS_MAX];
+static rt_uint32_t binlog_write_index;
+static rt_uint32_t binlog_read_index;
+static rt_uint32_t binlog_dropped;
+
+/* write the header of a record, return its arguments or RT_NULL if it is dropped */
+rt_inline rt_ubase_t *_binlog_reserve(const char *fmt, rt_ubase_t argc, rt_uint32_t stamp)
+{
+    rt_ubase_t *record;
+
+    if (RT_BINLOG_BUFFER_SIZE - (binlog_write_index - binlog_read_index) < RT_BINLOG_HEADER_SIZE + argc)
+    {
+        binlog_dropped ++;
+        return RT_NULL;
+    }
+
+    record = &binlog_buffer[binlog_write_index & BINLOG_MASK];
+    record[0] = (rt_ubase_t)fmt;
+    record[1] = argc;
+    record[2] = stamp;
+
+    return &record[RT_BINLOG_HEADER_SIZE];
+}
+
+/* move the words past the end of ring to its start, and publish the record */
+rt_inline void _binlog_commit(rt_ubase_t argc)
+{
+    rt_uint32_t end;
+
+    end = (binlog_write_index & BINLOG_MASK) + RT_BINLOG_HEADER_SIZE + argc;
+    if (end > RT_BINLOG_BUFFER_SIZE)
+    {
+        rt_memcpy(&binlog_buffer[0], &binlog_buffer[RT_BINLOG_BUFFER_SIZE],
+                  (end - RT_BINLOG_BUFFER_SIZE) * sizeof(rt_ubase_t));
+    }
+    binlog_write_index += RT_BINLOG_HEADER_SIZE + argc;
+}
+
+/**
+ * This function will record a log without argument into binary log buffer,
+ * it is invoked by rt_binlog. It can be invoked in thread or interrupt
+ * context, so do the other rt_binlog_write functions.
+ *
+ * @param fmt the format of log
+ */
+void rt_binlog_write0(const char *fmt)
+{
+    rt_base_t level;
+    rt_uint32_t stamp;
+
+    stamp = rt_hw_timestamp_get();
+
+    level = rt_hw_interrupt_disable();
+    if (_binlog_reserve(fmt, 0, stamp) != RT_NULL)
+        _binlog_commit(0);
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will record a log of 1 argument into binary log buffer.
+ *
+ * @param fmt the format of log
+ * @param a0 the argument of log
+ */
+void rt_binlog_write1(const char *fmt, rt_ubase_t a0)
+{
+    rt_base_t level;
+    rt_ubase_t *args;
+    rt_uint32_t stamp;
+
+    stamp = rt_hw_timestamp_get();
+
+    level = rt_hw_interrupt_disable();
+    args = _binlog_reserve(fmt, 1, stamp);
+    if (args != RT_NULL)
+    {
+        args[0] = a0;
+        _binlog_commit(1);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will record a log of 2 arguments into binary log buffer.
+ *
+ * @param fmt the format of log
+ * @param a0 the first argument of log
+ * @param a1 the second argument of log
+ */
+void rt_binlog_write2(const char *fmt, rt_ubase_t a0, rt_ubase_t a1)
+{
+    rt_base_t level;
+    rt_ubase_t *args;
+    rt_uint32_t stamp;
+
+    stamp = rt_hw_timestamp_get();
+
+    level = rt_hw_interrupt_disable();
+    args = _binlog_reserve(fmt, 2, stamp);
+    if (args != RT_NULL)
+    {
+        args[0] = a0;
+        args[1] = a1;
+        _binlog_commit(2);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will record a log of 3 arguments into binary log buffer.
+ *
+ * @param fmt the format of log
+ * @param a0 the first argument of log
+ * @param a1 the second argument of log
+ * @param a2 the third argument of log
+ */
+void rt_binlog_write3(const char *fmt, rt_ubase_t a0, rt_ubase_t a1, rt_ubase_t a2)
+{
+    rt_base_t level;
+    rt_ubase_t *args;
+    rt_uint32_t stamp;
+
+    stamp = rt_hw_timestamp_get();
+
+    level = rt_hw_interrupt_disable();
+    args = _binlog_reserve(fmt, 3, stamp);
+    if (args != RT_NULL)
+    {
+        args[0] = a0;
+        args[1] = a1;
+        args[2] = a2;
+        _binlog_commit(3);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will record a log of 4 arguments into binary log buffer.
+ *
+ * @param fmt the format of log
+ * @param a0 the first argument of log
+ * @param a1 the second argument of log
+ * @param a2 the third argument of log
+ * @param a3 the fourth argument of log
+ */
+void rt_binlog_write4(const char *fmt, rt_ubase_t a0, rt_ubase_t a1, rt_ubase_t a2, rt_ubase_t a3)
+{
+    rt_base_t level;
+    rt_ubase_t *args;
+    rt_uint32_t stamp;
+
+    stamp = rt_hw_timestamp_get();
+
+    level = rt_hw_interrupt_disable();
+    args = _binlog_reserve(fmt, 4, stamp);
+    if (args != RT_NULL)
+    {
+        args[0] = a0;
+        args[1] = a1;
+        args[2] = a2;
+        args[3] = a3;
+        _binlog_commit(4);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will record a log of more arguments into binary log buffer,
+ * it is invoked by rt_binlog for the logs of 5 to 8 arguments.
+ *
+ * @param fmt the format of log
+ * @param args the arguments of log
+ * @param argc the number of arguments
+ */
+void rt_binlog_write(const char *fmt, const rt_ubase_t *args, rt_ubase_t argc)
+{
+    rt_base_t level;
+    rt_ubase_t *record;
+    rt_uint32_t stamp;
+    rt_ubase_t index;
+
+    RT_ASSERT(argc <= RT_BINLOG_ARGS_MAX);
+
+    stamp = rt_hw_timestamp_get();
+
+    level = rt_hw_interrupt_disable();
+    record = _binlog_reserve(fmt, argc, stamp);
+    if (record != RT_NULL)
+    {
+        for (index = 0; index < argc; index ++)
+            record[index] = args[index];
+        _binlog_commit(argc);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will drop all logs in binary log buffer.
+ */
+void rt_binlog_clear(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    binlog_read_index = binlog_write_index;
+    binlog_dropped = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will read the records from binary log buffer in time order,
+ * only whole records are read and removed from buffer. The records can be
+ * sent to host by any transport and decoded by tools/binlog2txt.py.
+ *
+ * @param buffer the buffer to save records
+ * @param size the size of buffer in words
+ *
+ * @return the number of words read
+ */
+rt_size_t rt_binlog_read(rt_ubase_t *buffer, rt_size_t size)
+{
+    rt_base_t level;
+    rt_size_t count = 0;
+    rt_size_t length;
+
+    RT_ASSERT(buffer != RT_NULL);
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        if (binlog_read_index == binlog_write_index)
+        {
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+
+        length = RT_BINLOG_HEADER_SIZE + binlog_buffer[(binlog_read_index + 1) & BINLOG_MASK];
+        if (count + length > size)
+        {
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+
+        while (length --)
+            buffer[count ++] = binlog_buffer[binlog_read_index ++ & BINLOG_MASK];
+        rt_hw_interrupt_enable(level);
+    }
+
+    return count;
+}
+
+/**
+ * This function will dump the records in binary log buffer to console, in
+ * the text format read by tools/binlog2txt.py, one record per line. The
+ * records logged during the dump are kept in buffer.
+ */
+void rt_binlog_dump(void)
+{
+    rt_ubase_t record[RT_BINLOG_HEADER_SIZE + RT_BINLOG_ARGS_MAX];
+    rt_uint32_t end;
+    rt_size_t index, length;
+    rt_base_t level;
+
+    rt_kprintf("#RTBINLOG %d %u %d\n", RT_BINLOG_VERSION, rt_hw_timestamp_freq(), (int)sizeof(rt_ubase_t));
+
+    end = binlog_write_index;
+    while ((rt_int32_t)(end - binlog_read_index) > 0)
+    {
+        /* read one record for one line */
+        level = rt_hw_interrupt_disable();
+        length = RT_BINLOG_HEADER_SIZE + binlog_buffer[(binlog_read_index + 1) & BINLOG_MASK];
+        rt_hw_interrupt_enable(level);
+        if (rt_binlog_read(record, length) != length)
+            break;
+
+        rt_kprintf("L");
+        for (index = 0; index < length; index ++)
+            rt_kprintf(" %lx", record[index]);
+        rt_kprintf("\n");
+    }
+
+    rt_kprintf("#END %u\n", binlog_dropped);
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static long binlog(int argc, char **argv)
+{
+    if (argc == 2)
+    {
+        if (rt_strcmp(argv[1], "clear") == 0)
+        {
+            rt_binlog_clear();
+            return 0;
+        }
+        else if (rt_strcmp(argv[1], "dump") == 0)
+        {
+            rt_binlog_dump();
+            return 0;
+        }
+    }
+
+    rt_kprintf("Usage: binlog <clear|dump>\n");
+    return -RT_EINVAL;
+}
+MSH_CMD_EXPORT(binlog, binary log: binlog <clear|dump>);
+#endif
+
+#endif /* RT_USING_BINLOG */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+#ifndef __BINLOG_H__
+#define __BINLOG_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the number of words in binary log buffer, must be power of 2 */
+#ifndef RT_BINLOG_BUFFER_SIZE
+#define RT_BINLOG_BUFFER_SIZE           1024
+#endif
+
+/* the maximal number of arguments of one log, no more than 8 */
+#define RT_BINLOG_ARGS_MAX              8
+
+/* version of the binary record layout, shall be changed with the layout */
+#define RT_BINLOG_VERSION               1
+
+/* the number of words of record header: format, number of arguments, timestamp */
+#define RT_BINLOG_HEADER_SIZE           3
+
+#define _RT_BINLOG_CAT_(a, b)           a##b
+#define _RT_BINLOG_CAT(a, b)            _RT_BINLOG_CAT_(a, b)
+
+#define _RT_BINLOG_NARG_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+#define _RT_BINLOG_NARG(...)            _RT_BINLOG_NARG_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define _RT_BINLOG_ARGS0()
+#define _RT_BINLOG_ARGS1(a)             (rt_ubase_t)(a)
+#define _RT_BINLOG_ARGS2(a, ...)        (rt_ubase_t)(a), _RT_BINLOG_ARGS1(__VA_ARGS__)
+#define _RT_BINLOG_ARGS3(a, ...)        (rt_ubase_t)(a), _RT_BINLOG_ARGS2(__VA_ARGS__)
+#define _RT_BINLOG_ARGS4(a, ...)        (rt_ubase_t)(a), _RT_BINLOG_ARGS3(__VA_ARGS__)
+#define _RT_BINLOG_ARGS5(a, ...)        (rt_ubase_t)(a), _RT_BINLOG_ARGS4(__VA_ARGS__)
+#define _RT_BINLOG_ARGS6(a, ...)        (rt_ubase_t)(a), _RT_BINLOG_ARGS5(__VA_ARGS__)
+#define _RT_BINLOG_ARGS7(a, ...)        (rt_ubase_t)(a), _RT_BINLOG_ARGS6(__VA_ARGS__)
+#define _RT_BINLOG_ARGS8(a, ...)        (rt_ubase_t)(a), _RT_BINLOG_ARGS7(__VA_ARGS__)
+
+/* the logs of up to 4 arguments pass them in registers, the others in an array */
+#define _RT_BINLOG_WRITE0(fmt)                  rt_binlog_write0(fmt)
+#define _RT_BINLOG_WRITE1(fmt, a)               rt_binlog_write1(fmt, (rt_ubase_t)(a))
+#define _RT_BINLOG_WRITE2(fmt, a, b)            rt_binlog_write2(fmt, (rt_ubase_t)(a), (rt_ubase_t)(b))
+#define _RT_BINLOG_WRITE3(fmt, a, b, c)                                                        \
+    rt_binlog_write3(fmt, (rt_ubase_t)(a), (rt_ubase_t)(b), (rt_ubase_t)(c))
+#define _RT_BINLOG_WRITE4(fmt, a, b, c, d)                                                     \
+    rt_binlog_write4(fmt, (rt_ubase_t)(a), (rt_ubase_t)(b), (rt_ubase_t)(c), (rt_ubase_t)(d))
+#define _RT_BINLOG_WRITEN(fmt, n, ...)                                                          \
+    do                                                                                          \
+    {                                                                                           \
+        const rt_ubase_t _binlog_args[] = {_RT_BINLOG_ARGS##n(__VA_ARGS__)};                    \
+        rt_binlog_write(fmt, _binlog_args, n);                                                  \
+    }                                                                                           \
+    while (0)
+#define _RT_BINLOG_WRITE5(fmt, ...)             _RT_BINLOG_WRITEN(fmt, 5, __VA_ARGS__)
+#define _RT_BINLOG_WRITE6(fmt, ...)             _RT_BINLOG_WRITEN(fmt, 6, __VA_ARGS__)
+#define _RT_BINLOG_WRITE7(fmt, ...)             _RT_BINLOG_WRITEN(fmt, 7, __VA_ARGS__)
+#define _RT_BINLOG_WRITE8(fmt, ...)             _RT_BINLOG_WRITEN(fmt, 8, __VA_ARGS__)
+
+/**
+ * Log a message in binary form. Only the address of format, a timestamp and
+ * the arguments are recorded, the message is formatted on host by
+ * tools/binlog2txt.py with the ELF image. So the format shall be a string
+ * literal, the arguments shall be integers or pointers, and a "%s" argument
+ * shall point to a constant string in the image.
+ */
+#define rt_binlog(fmt, ...)                                                                     \
+    _RT_BINLOG_CAT(_RT_BINLOG_WRITE, _RT_BINLOG_NARG(__VA_ARGS__))("" fmt, ##__VA_ARGS__)
+
+void rt_binlog_write0(const char *fmt);
+void rt_binlog_write1(const char *fmt, rt_ubase_t a0);
+void rt_binlog_write2(const char *fmt, rt_ubase_t a0, rt_ubase_t a1);
+void rt_binlog_write3(const char *fmt, rt_ubase_t a0, rt_ubase_t a1, rt_ubase_t a2);
+void rt_binlog_write4(const char *fmt, rt_ubase_t a0, rt_ubase_t a1, rt_ubase_t a2, rt_ubase_t a3);
+void rt_binlog_write(const char *fmt, const rt_ubase_t *args, rt_ubase_t argc);
+void rt_binlog_clear(void);
+rt_size_t rt_binlog_read(rt_ubase_t *buffer, rt_size_t size);
+void rt_binlog_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -606,8 +606,13 @@ long list_memheap(void)
 
     maxlen = RT_NAME_MAX;
 
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+    rt_kprintf("%-*.s  pool size  max used size available size region   alloc   fallback\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(      " ---------- ------------- -------------- ------ -------- --------\n");
+#else
     rt_kprintf("%-*.s  pool size  max used size available size\n", maxlen, item_title); object_split(maxlen);
     rt_kprintf(      " ---------- ------------- --------------\n");
+#endif
     do
     {
         next = list_get_next(next, &find_arg);
@@ -630,6 +635,23 @@ long list_memheap(void)
 
                 mh = (struct rt_memheap *)obj;
 
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+                if (mh->region_flags & RT_MEM_REGION)
+                {
+                    rt_kprintf("%-*.*s %-010d %-013d %-014d %c%c%c    %-8d %-8d\n",
+                            maxlen, RT_NAME_MAX,
+                            mh->parent.name,
+                            mh->pool_size,
+                            mh->max_used_size,
+                            mh->available_size,
+                            (mh->region_flags & RT_MEM_FAST) ? 'F' : '-',
+                            (mh->region_flags & RT_MEM_DMA) ? 'D' : '-',
+                            (mh->region_flags & RT_MEM_BULK) ? 'B' : '-',
+                            mh->alloc_count,
+                            mh->fallback_count);
+                    continue;
+                }
+#endif
                 rt_kprintf("%-*.*s %-010d %-013d %-05d\n",
                         maxlen, RT_NAME_MAX,
                         mh->parent.name,
@@ -661,8 +683,8 @@ long list_mempool(void)
 
     maxlen = RT_NAME_MAX;
 
-    rt_kprintf("%-*.s block total free suspend thread\n", maxlen, item_title); object_split(maxlen);
-    rt_kprintf(     " ----  ----  ---- --------------\n");
+    rt_kprintf("%-*.s block total free  max used suspend thread\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(     " ----  ----  ---- --------- --------------\n");
     do
     {
         next = list_get_next(next, &find_arg);
@@ -695,24 +717,26 @@ long list_mempool(void)
 
                 if (suspend_thread_count > 0)
                 {
-                    rt_kprintf("%-*.*s %04d  %04d  %04d %d:",
+                    rt_kprintf("%-*.*s %04d  %04d  %04d %04d      %d:",
                             maxlen, RT_NAME_MAX,
                             mp->parent.name,
                             mp->block_size,
                             mp->block_total_count,
                             mp->block_free_count,
+                            mp->block_used_max,
                             suspend_thread_count);
                     show_wait_queue(&(mp->suspend_thread));
                     rt_kprintf("\n");
                 }
                 else
                 {
-                    rt_kprintf("%-*.*s %04d  %04d  %04d %d\n",
+                    rt_kprintf("%-*.*s %04d  %04d  %04d %04d      %d\n",
                             maxlen, RT_NAME_MAX,
                             mp->parent.name,
                             mp->block_size,
                             mp->block_total_count,
                             mp->block_free_count,
+                            mp->block_used_max,
                             suspend_thread_count);
                 }
             }
@@ -724,6 +748,74 @@ long list_mempool(void)
 }
 #endif
 
+#ifdef RT_USING_HEAP_INFO
+long list_heap(void)
+{
+    int bin;
+    rt_ubase_t level;
+    struct rt_heap_info info;
+    list_get_next_t find_arg;
+    rt_list_t *obj_list[LIST_FIND_OBJ_NR];
+    rt_list_t *next = (rt_list_t*)RT_NULL;
+    const char *item_title = "thread";
+    int maxlen;
+
+    rt_heap_info_get(&info);
+
+    rt_kprintf("total memory : %d\n", info.total);
+    rt_kprintf("used memory  : %d\n", info.used);
+    rt_kprintf("max used     : %d\n", info.max_used);
+    rt_kprintf("free memory  : %d in %d blocks\n", info.free_size, info.free_count);
+    rt_kprintf("largest free : %d\n", info.largest_free);
+    rt_kprintf("fragmentation: %d%%\n", info.fragmentation);
+
+    rt_kprintf("free block size  count\n");
+    rt_kprintf("--------------- --------\n");
+    for (bin = 0; bin < RT_HEAP_INFO_BINS; bin ++)
+    {
+        if (info.histogram[bin] == 0)
+            continue;
+
+        rt_kprintf(">= %-12d %-8d\n", bin == 0 ? 0 : 16 << bin, info.histogram[bin]);
+    }
+
+    list_find_init(&find_arg, RT_Object_Class_Thread, obj_list, sizeof(obj_list)/sizeof(obj_list[0]));
+
+    maxlen = RT_NAME_MAX;
+
+    rt_kprintf("\n%-*.s heap used\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(     " ----------\n");
+
+    do
+    {
+        next = list_get_next(next, &find_arg);
+        {
+            int i;
+            for (i = 0; i < find_arg.nr_out; i++)
+            {
+                struct rt_object *obj;
+                struct rt_thread *thread;
+
+                obj = rt_list_entry(obj_list[i], struct rt_object, list);
+                level = rt_hw_interrupt_disable();
+                if ((obj->type & ~RT_Object_Class_Static) != find_arg.type)
+                {
+                    rt_hw_interrupt_enable(level);
+                    continue;
+                }
+                rt_hw_interrupt_enable(level);
+
+                thread = (struct rt_thread *)obj;
+                rt_kprintf("%-*.*s %d\n", maxlen, RT_NAME_MAX, thread->name, thread->heap_used);
+            }
+        }
+    }
+    while (next != (rt_list_t*)RT_NULL);
+
+    return 0;
+}
+#endif
+
 long list_timer(void)
 {
     rt_ubase_t level;
@@ -978,6 +1070,12 @@ int cmd_list(int argc, char **argv)
             list_mempool();
         }
 #endif /* RT_USING_MEMPOOL */
+#ifdef RT_USING_HEAP_INFO
+        else if(strcmp(argv[1], "heap") == 0)
+        {
+            list_heap();
+        }
+#endif /* RT_USING_HEAP_INFO */
 #ifdef RT_USING_DEVICE
         else if(strcmp(argv[1], "device") == 0)
         {
@@ -1025,6 +1123,9 @@ _usage:
 #ifdef RT_USING_MEMPOOL
     rt_kprintf("    %-12s - list memory pools\n", "mempool");
 #endif /* RT_USING_MEMPOOL */
+#ifdef RT_USING_HEAP_INFO
+    rt_kprintf("    %-12s - list heap fragmentation\n", "heap");
+#endif /* RT_USING_HEAP_INFO */
 #ifdef RT_USING_DEVICE
     rt_kprintf("    %-12s - list devices\n", "device");
 #endif /* RT_USING_DEVICE */
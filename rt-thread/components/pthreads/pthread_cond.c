@@ -15,8 +15,13 @@ const pthread_condattr_t pthread_default_condattr = PTHREAD_PROCESS_PRIVATE;
 int pthread_cond_init(pthread_cond_t *cond, const pthread_condattr_t *attr)
 {
     rt_err_t result;
+#ifdef RT_USING_OBJECT_NAME_REF
+    /* the semaphore keeps this pointer as its name */
+    const char *cond_name = "pcond";
+#else
     char cond_name[RT_NAME_MAX];
     static rt_uint16_t pthread_cond_num = 0;
+#endif
 
     /* check pointer not null */
     if (!cond)
@@ -28,8 +33,10 @@ int pthread_cond_init(pthread_cond_t *cond, const pthread_condattr_t *attr)
     else
         cond->attr = *attr;
 
+#ifndef RT_USING_OBJECT_NAME_REF
     /* build cond name */
     rt_snprintf(cond_name, sizeof(cond_name), "pmtx%02d", pthread_cond_num++);
+#endif
 
     /* init cond sem */
     result = rt_sem_init(&cond->sem, cond_name, 0, RT_IPC_FLAG_FIFO);
@@ -217,10 +224,7 @@ rt_err_t _pthread_cond_timedwait(pthread_cond_t *cond,
                 if (time > 0)
                 {
                     /* reset the timeout of thread timer and start it */
-                    rt_timer_control(&(thread->thread_timer),
-                                     RT_TIMER_CTRL_SET_TIME,
-                                     &time);
-                    rt_timer_start(&(thread->thread_timer));
+                    rt_thread_timeout_start(thread, time);
                 }
 
                 /* to avoid the lost of singal< cond->sem > */
@@ -19,8 +19,13 @@ const pthread_mutexattr_t pthread_default_mutexattr = PTHREAD_PROCESS_PRIVATE;
 int pthread_mutex_init(pthread_mutex_t *mutex, const pthread_mutexattr_t *attr)
 {
     rt_err_t result;
+#ifdef RT_USING_OBJECT_NAME_REF
+    /* the object refers to its name, which shall not be on the stack */
+    const char *mutex_name = "pmtx";
+#else
     char mutex_name[RT_NAME_MAX];
     static rt_uint16_t pthread_mutex_number = 0;
+#endif
 
     /* check pointer not null */
     if (!mutex)
@@ -32,8 +37,10 @@ int pthread_mutex_init(pthread_mutex_t *mutex, const pthread_mutexattr_t *attr)
     else
         mutex->attr = *attr;
 
+#ifndef RT_USING_OBJECT_NAME_REF
     /* build mutex name */
     rt_snprintf(mutex_name, sizeof(mutex_name), "pmtx%02d", pthread_mutex_number++);
+#endif
 
     /* init mutex lock */
     result = rt_mutex_init(&(mutex->lock), mutex_name, RT_IPC_FLAG_PRIO);
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "trace.h"
+
+#ifdef RT_USING_TRACE
+
+#ifndef RT_USING_HOOK
+#error "The trace component requires RT_USING_HOOK"
+#endif
+
+#if (RT_TRACE_BUFFER_SIZE & (RT_TRACE_BUFFER_SIZE - 1)) != 0
+#error "RT_TRACE_BUFFER_SIZE must be power of 2"
+#endif
+
+#if defined(RT_USING_HEAP) && !defined(RT_USING_MEMHEAP_AS_HEAP) && \
+    (defined(RT_USING_SMALL_MEM) || defined(RT_USING_SLAB))
+#define TRACE_USING_HEAP_HOOK
+#endif
+
+/*
+ * The trace buffer is a flight recorder: the writer never waits for the
+ * reader, the oldest events are overwritten when it is full. The indexes
+ * are free running and only masked when the buffer is accessed.
+ */
+static struct rt_trace_event trace_buffer[RT_TRACE_BUFFER_SIZE];
+static rt_uint32_t trace_write_index;
+static rt_uint32_t trace_read_index;
+static rt_uint32_t trace_lost;
+static volatile rt_uint8_t trace_enable;
+
+/**
+ * This function will record an event into trace buffer. It can be invoked
+ * in thread or interrupt context.
+ *
+ * @param type the event type
+ * @param data the small payload of event
+ * @param arg0 the first argument of event
+ * @param arg1 the second argument of event
+ */
+void rt_trace_record(rt_uint16_t type, rt_uint16_t data, rt_ubase_t arg0, rt_ubase_t arg1)
+{
+    rt_base_t level;
+    struct rt_trace_event *event;
+
+    if (!trace_enable)
+        return;
+
+    /* the slot is owned by this writer once the index is moved */
+    level = rt_hw_interrupt_disable();
+    event = &trace_buffer[trace_write_index & (RT_TRACE_BUFFER_SIZE - 1)];
+    trace_write_index ++;
+
+    event->timestamp = rt_hw_timestamp_get();
+    event->type      = type;
+    event->data      = data;
+    event->arg0      = arg0;
+    event->arg1      = arg1;
+    rt_hw_interrupt_enable(level);
+}
+
+static void _trace_switch(struct rt_thread *from, struct rt_thread *to)
+{
+    rt_trace_record(RT_TRACE_EVENT_SWITCH, to->current_priority,
+                    (rt_ubase_t)from, (rt_ubase_t)to);
+}
+
+static void _trace_irq_enter(void)
+{
+    rt_trace_record(RT_TRACE_EVENT_IRQ_ENTER, rt_interrupt_get_nest(), 0, 0);
+}
+
+static void _trace_irq_leave(void)
+{
+    rt_trace_record(RT_TRACE_EVENT_IRQ_LEAVE, rt_interrupt_get_nest(), 0, 0);
+}
+
+static void _trace_ipc_trytake(struct rt_object *object)
+{
+    rt_trace_record(RT_TRACE_EVENT_IPC_TRYTAKE, object->type, (rt_ubase_t)object, 0);
+}
+
+static void _trace_ipc_take(struct rt_object *object)
+{
+    rt_trace_record(RT_TRACE_EVENT_IPC_TAKE, object->type, (rt_ubase_t)object, 0);
+}
+
+static void _trace_ipc_release(struct rt_object *object)
+{
+    rt_trace_record(RT_TRACE_EVENT_IPC_RELEASE, object->type, (rt_ubase_t)object, 0);
+}
+
+static void _trace_thread_suspend(rt_thread_t thread)
+{
+    rt_trace_record(RT_TRACE_EVENT_THREAD_SUSPEND, 0, (rt_ubase_t)thread, 0);
+}
+
+static void _trace_thread_resume(rt_thread_t thread)
+{
+    rt_trace_record(RT_TRACE_EVENT_THREAD_RESUME, 0, (rt_ubase_t)thread, 0);
+}
+
+static void _trace_timer_enter(struct rt_timer *timer)
+{
+    rt_trace_record(RT_TRACE_EVENT_TIMER_ENTER, 0,
+                    (rt_ubase_t)timer, (rt_ubase_t)timer->timeout_func);
+}
+
+static void _trace_timer_exit(struct rt_timer *timer)
+{
+    rt_trace_record(RT_TRACE_EVENT_TIMER_EXIT, 0, (rt_ubase_t)timer, 0);
+}
+
+#ifdef TRACE_USING_HEAP_HOOK
+static void _trace_malloc(void *ptr, rt_size_t size)
+{
+    rt_trace_record(RT_TRACE_EVENT_MALLOC, 0, (rt_ubase_t)ptr, size);
+}
+
+static void _trace_free(void *ptr)
+{
+    rt_trace_record(RT_TRACE_EVENT_FREE, 0, (rt_ubase_t)ptr, 0);
+}
+#endif
+
+/* remove the trace hooks, the ones not installed are not found */
+static void _trace_hooks_delete(void)
+{
+    rt_scheduler_delhook(_trace_switch);
+    rt_interrupt_enter_delhook(_trace_irq_enter);
+    rt_interrupt_leave_delhook(_trace_irq_leave);
+    rt_object_trytake_delhook(_trace_ipc_trytake);
+    rt_object_take_delhook(_trace_ipc_take);
+    rt_object_put_delhook(_trace_ipc_release);
+    rt_thread_suspend_delhook(_trace_thread_suspend);
+    rt_thread_resume_delhook(_trace_thread_resume);
+    rt_timer_enter_delhook(_trace_timer_enter);
+    rt_timer_exit_delhook(_trace_timer_exit);
+#ifdef TRACE_USING_HEAP_HOOK
+    rt_malloc_delhook(_trace_malloc);
+    rt_free_delhook(_trace_free);
+#endif
+}
+
+/**
+ * This function will install the trace hooks and start recording.
+ *
+ * @return RT_EOK on successful, -RT_EFULL if a hook list is full. No hook is
+ *         left installed on failure, as the trace would miss events.
+ */
+rt_err_t rt_trace_start(void)
+{
+    if (trace_enable)
+        return RT_EOK;
+
+    if (rt_scheduler_sethook(_trace_switch) != RT_EOK ||
+        rt_interrupt_enter_sethook(_trace_irq_enter) != RT_EOK ||
+        rt_interrupt_leave_sethook(_trace_irq_leave) != RT_EOK ||
+        rt_object_trytake_sethook(_trace_ipc_trytake) != RT_EOK ||
+        rt_object_take_sethook(_trace_ipc_take) != RT_EOK ||
+        rt_object_put_sethook(_trace_ipc_release) != RT_EOK ||
+        rt_thread_suspend_sethook(_trace_thread_suspend) != RT_EOK ||
+        rt_thread_resume_sethook(_trace_thread_resume) != RT_EOK ||
+        rt_timer_enter_sethook(_trace_timer_enter) != RT_EOK ||
+#ifdef TRACE_USING_HEAP_HOOK
+        rt_malloc_sethook(_trace_malloc) != RT_EOK ||
+        rt_free_sethook(_trace_free) != RT_EOK ||
+#endif
+        rt_timer_exit_sethook(_trace_timer_exit) != RT_EOK)
+    {
+        _trace_hooks_delete();
+
+        return -RT_EFULL;
+    }
+
+    trace_enable = 1;
+
+    return RT_EOK;
+}
+
+/**
+ * This function will stop recording and remove the trace hooks.
+ */
+void rt_trace_stop(void)
+{
+    if (!trace_enable)
+        return;
+
+    trace_enable = 0;
+
+    _trace_hooks_delete();
+}
+
+/**
+ * This function will drop all events in trace buffer.
+ */
+void rt_trace_clear(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    trace_read_index = trace_write_index;
+    trace_lost = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will read the events from trace buffer in time order, the
+ * events read are removed from trace buffer.
+ *
+ * @param events the buffer to save events
+ * @param count the maximal number of events to read
+ *
+ * @return the number of events read
+ */
+rt_size_t rt_trace_read(struct rt_trace_event *events, rt_size_t count)
+{
+    rt_base_t level;
+    rt_size_t index;
+
+    RT_ASSERT(events != RT_NULL);
+
+    for (index = 0; index < count; index ++)
+    {
+        level = rt_hw_interrupt_disable();
+        /* skip the events overwritten by writer */
+        if (trace_write_index - trace_read_index > RT_TRACE_BUFFER_SIZE)
+        {
+            trace_lost += trace_write_index - trace_read_index - RT_TRACE_BUFFER_SIZE;
+            trace_read_index = trace_write_index - RT_TRACE_BUFFER_SIZE;
+        }
+
+        if (trace_read_index == trace_write_index)
+        {
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+
+        events[index] = trace_buffer[trace_read_index & (RT_TRACE_BUFFER_SIZE - 1)];
+        trace_read_index ++;
+        rt_hw_interrupt_enable(level);
+    }
+
+    return index;
+}
+
+static void _trace_dump_names(enum rt_object_class_type type)
+{
+    struct rt_list_node *node;
+    struct rt_object *object;
+    struct rt_object_information *information;
+
+    information = rt_object_get_information(type);
+    if (information == RT_NULL)
+        return;
+
+    rt_enter_critical();
+    for (node = information->object_list.next;
+         node != &(information->object_list);
+         node = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        rt_kprintf("N %lx %x %.*s\n", (rt_ubase_t)object, type, RT_NAME_MAX, object->name);
+    }
+    rt_exit_critical();
+}
+
+/**
+ * This function will dump the events in trace buffer and the names of kernel
+ * objects to console, in the text format read by tools/trace2json.py.
+ */
+void rt_trace_dump(void)
+{
+    rt_uint8_t enable;
+    struct rt_trace_event event;
+
+    /* pause the recording, the dump itself shall not be traced */
+    enable = trace_enable;
+    trace_enable = 0;
+
+    rt_kprintf("#RTTRACE %d %u %d\n", RT_TRACE_VERSION, rt_hw_timestamp_freq(), RT_NAME_MAX);
+
+    _trace_dump_names(RT_Object_Class_Thread);
+    _trace_dump_names(RT_Object_Class_Timer);
+#ifdef RT_USING_SEMAPHORE
+    _trace_dump_names(RT_Object_Class_Semaphore);
+#endif
+#ifdef RT_USING_MUTEX
+    _trace_dump_names(RT_Object_Class_Mutex);
+#endif
+#ifdef RT_USING_EVENT
+    _trace_dump_names(RT_Object_Class_Event);
+#endif
+#ifdef RT_USING_MAILBOX
+    _trace_dump_names(RT_Object_Class_MailBox);
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+    _trace_dump_names(RT_Object_Class_MessageQueue);
+#endif
+
+    while (rt_trace_read(&event, 1) == 1)
+    {
+        rt_kprintf("E %08x %x %x %lx %lx\n", event.timestamp, event.type, event.data,
+                   event.arg0, event.arg1);
+    }
+
+    rt_kprintf("#END %u\n", trace_lost);
+
+    trace_enable = enable;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static long trace(int argc, char **argv)
+{
+    if (argc == 2)
+    {
+        if (rt_strcmp(argv[1], "start") == 0)
+        {
+            if (rt_trace_start() != RT_EOK)
+            {
+                rt_kprintf("trace: a hook list is full\n");
+                return -RT_EFULL;
+            }
+            return 0;
+        }
+        else if (rt_strcmp(argv[1], "stop") == 0)
+        {
+            rt_trace_stop();
+            return 0;
+        }
+        else if (rt_strcmp(argv[1], "clear") == 0)
+        {
+            rt_trace_clear();
+            return 0;
+        }
+        else if (rt_strcmp(argv[1], "dump") == 0)
+        {
+            rt_trace_dump();
+            return 0;
+        }
+    }
+
+    rt_kprintf("Usage: trace <start|stop|clear|dump>\n");
+    return -RT_EINVAL;
+}
+MSH_CMD_EXPORT(trace, kernel event trace: trace <start|stop|clear|dump>);
+#endif
+
+#endif /* RT_USING_TRACE */
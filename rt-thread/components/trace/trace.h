@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the number of events in trace buffer, must be power of 2 */
+#ifndef RT_TRACE_BUFFER_SIZE
+#define RT_TRACE_BUFFER_SIZE            1024
+#endif
+
+/* version of the binary event layout, shall be changed with the layout */
+#define RT_TRACE_VERSION                1
+
+/**
+ * trace event type
+ */
+enum rt_trace_event_type
+{
+    RT_TRACE_EVENT_SWITCH = 1,                          /**< context switch, arg0: from thread, arg1: to thread */
+    RT_TRACE_EVENT_IRQ_ENTER,                           /**< interrupt enter, data: interrupt nest */
+    RT_TRACE_EVENT_IRQ_LEAVE,                           /**< interrupt leave, data: interrupt nest */
+    RT_TRACE_EVENT_IPC_TRYTAKE,                         /**< try to take an IPC object, arg0: object */
+    RT_TRACE_EVENT_IPC_TAKE,                            /**< IPC object taken, arg0: object */
+    RT_TRACE_EVENT_IPC_RELEASE,                         /**< IPC object released, arg0: object */
+    RT_TRACE_EVENT_THREAD_SUSPEND,                      /**< thread blocked, arg0: thread */
+    RT_TRACE_EVENT_THREAD_RESUME,                       /**< thread resumed, arg0: thread */
+    RT_TRACE_EVENT_TIMER_ENTER,                         /**< timer fires, arg0: timer, arg1: timeout function */
+    RT_TRACE_EVENT_TIMER_EXIT,                          /**< timeout function returns, arg0: timer */
+    RT_TRACE_EVENT_MALLOC,                              /**< memory allocated, arg0: pointer, arg1: size */
+    RT_TRACE_EVENT_FREE,                                /**< memory freed, arg0: pointer */
+};
+
+/**
+ * trace event, the record saved in trace buffer
+ */
+struct rt_trace_event
+{
+    rt_uint32_t timestamp;                              /**< timestamp of rt_hw_timestamp_get */
+    rt_uint16_t type;                                   /**< event type */
+    rt_uint16_t data;                                   /**< small payload of event */
+    rt_ubase_t  arg0;                                   /**< first argument of event */
+    rt_ubase_t  arg1;                                   /**< second argument of event */
+};
+
+rt_err_t rt_trace_start(void);
+void rt_trace_stop(void);
+void rt_trace_clear(void);
+void rt_trace_record(rt_uint16_t type, rt_uint16_t data, rt_ubase_t arg0, rt_ubase_t arg1);
+rt_size_t rt_trace_read(struct rt_trace_event *events, rt_size_t count);
+void rt_trace_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
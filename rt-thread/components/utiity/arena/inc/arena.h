@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+#ifndef ARENA_H__
+#define ARENA_H__
+
+#include "rtthread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the default size of arena chunk allocated from heap */
+#ifndef RT_ARENA_CHUNK_SIZE
+#define RT_ARENA_CHUNK_SIZE             1024
+#endif
+
+/* arena chunk, the memory of allocations follows the header */
+struct rt_arena_chunk
+{
+    struct rt_arena_chunk *next;                        /**< the older chunk */
+    rt_uint8_t            *end;                         /**< end of the chunk */
+};
+
+/**
+ * Arena (bump) allocator
+ *
+ * The memory is allocated by bumping a pointer in the current chunk, and is
+ * only released as a whole by rt_arena_rewind or rt_arena_reset. The chunks
+ * are allocated from heap or from a memory pool. An arena shall be used by
+ * one thread only, it has no lock.
+ */
+struct rt_arena
+{
+    struct rt_arena_chunk *chunk;                       /**< current chunk, the list of chunks */
+    rt_uint8_t            *ptr;                         /**< the bump pointer in current chunk */
+    rt_size_t              chunk_size;                  /**< size of the chunks */
+#ifdef RT_USING_MEMPOOL
+    rt_mp_t                mp;                          /**< the memory pool of chunks */
+#endif
+    rt_uint16_t            chunk_count;                 /**< number of chunks */
+    rt_uint16_t            chunk_max;                   /**< maximal number of chunks */
+};
+typedef struct rt_arena *rt_arena_t;
+
+/* the position of arena, which can be rewound to */
+struct rt_arena_mark
+{
+    struct rt_arena_chunk *chunk;
+    struct rt_arena_chunk *next;                        /**< the chunk behind, before the dedicated chunks */
+    rt_uint8_t            *ptr;
+};
+
+#ifdef RT_USING_HEAP
+void rt_arena_init(rt_arena_t arena, rt_size_t chunk_size);
+#endif
+#ifdef RT_USING_MEMPOOL
+void rt_arena_init_mp(rt_arena_t arena, rt_mp_t mp);
+#endif
+void rt_arena_detach(rt_arena_t arena);
+
+void *rt_arena_alloc(rt_arena_t arena, rt_size_t size);
+void *rt_arena_calloc(rt_arena_t arena, rt_size_t count, rt_size_t size);
+char *rt_arena_strdup(rt_arena_t arena, const char *s);
+
+void rt_arena_mark(rt_arena_t arena, struct rt_arena_mark *mark);
+void rt_arena_rewind(rt_arena_t arena, const struct rt_arena_mark *mark);
+void rt_arena_reset(rt_arena_t arena);
+
+void rt_arena_bind(rt_arena_t arena);
+rt_arena_t rt_arena_self(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARENA_H__ */
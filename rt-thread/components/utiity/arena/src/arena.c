@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <rtthread.h>
+#include "arena.h"
+
+#define ARENA_CHUNK_HEADER      RT_ALIGN(sizeof(struct rt_arena_chunk), RT_ALIGN_SIZE)
+#define ARENA_CHUNK_DATA(chunk) ((rt_uint8_t *)(chunk) + ARENA_CHUNK_HEADER)
+
+static void _arena_chunk_free(rt_arena_t arena, struct rt_arena_chunk *chunk)
+{
+    arena->chunk_count --;
+
+#ifdef RT_USING_MEMPOOL
+    if (arena->mp != RT_NULL)
+    {
+        rt_mp_free(chunk);
+        return;
+    }
+#endif
+#ifdef RT_USING_HEAP
+    rt_free(chunk);
+#endif
+}
+
+/*
+ * allocate a new chunk for size bytes, which becomes the current chunk. The
+ * dedicated chunk of an allocation larger than a chunk is linked behind the
+ * current chunk instead, so the rest of the current chunk is still used.
+ */
+static void *_arena_grow(rt_arena_t arena, rt_size_t size)
+{
+    rt_size_t chunk_size;
+    struct rt_arena_chunk *chunk = RT_NULL;
+
+    chunk_size = ARENA_CHUNK_HEADER + size;
+    if (chunk_size < arena->chunk_size)
+        chunk_size = arena->chunk_size;
+
+#ifdef RT_USING_MEMPOOL
+    if (arena->mp != RT_NULL)
+    {
+        /* the chunk of memory pool can not be larger than its block */
+        if (chunk_size > arena->chunk_size)
+            return RT_NULL;
+
+        chunk = (struct rt_arena_chunk *)rt_mp_alloc(arena->mp, RT_WAITING_NO);
+    }
+    else
+#endif
+    {
+#ifdef RT_USING_HEAP
+        /* the allocation larger than a chunk takes a dedicated chunk */
+        chunk = (struct rt_arena_chunk *)rt_malloc(chunk_size);
+#endif
+    }
+
+    if (chunk == RT_NULL)
+        return RT_NULL;
+
+    arena->chunk_count ++;
+    if (arena->chunk_count > arena->chunk_max)
+        arena->chunk_max = arena->chunk_count;
+
+    chunk->end = (rt_uint8_t *)chunk + chunk_size;
+    if (chunk_size > arena->chunk_size && arena->chunk != RT_NULL)
+    {
+        chunk->next        = arena->chunk->next;
+        arena->chunk->next = chunk;
+    }
+    else
+    {
+        chunk->next  = arena->chunk;
+        arena->chunk = chunk;
+        arena->ptr   = ARENA_CHUNK_DATA(chunk) + size;
+    }
+
+    return ARENA_CHUNK_DATA(chunk);
+}
+
+#ifdef RT_USING_HEAP
+/**
+ * This function will initialize an arena, which allocates its chunks from
+ * heap.
+ *
+ * @param arena the arena
+ * @param chunk_size the size of chunks, 0 for RT_ARENA_CHUNK_SIZE
+ */
+void rt_arena_init(rt_arena_t arena, rt_size_t chunk_size)
+{
+    RT_ASSERT(arena != RT_NULL);
+
+    if (chunk_size == 0)
+        chunk_size = RT_ARENA_CHUNK_SIZE;
+    RT_ASSERT(chunk_size > ARENA_CHUNK_HEADER);
+
+    rt_memset(arena, 0, sizeof(struct rt_arena));
+    arena->chunk_size = RT_ALIGN_DOWN(chunk_size, RT_ALIGN_SIZE);
+}
+#endif
+
+#ifdef RT_USING_MEMPOOL
+/**
+ * This function will initialize an arena, which takes the blocks of a
+ * memory pool as its chunks. An allocation larger than the block fails.
+ *
+ * @param arena the arena
+ * @param mp the memory pool
+ */
+void rt_arena_init_mp(rt_arena_t arena, rt_mp_t mp)
+{
+    RT_ASSERT(arena != RT_NULL);
+    RT_ASSERT(mp != RT_NULL);
+    RT_ASSERT(mp->block_size > ARENA_CHUNK_HEADER);
+
+    rt_memset(arena, 0, sizeof(struct rt_arena));
+    arena->chunk_size = RT_ALIGN_DOWN(mp->block_size, RT_ALIGN_SIZE);
+    arena->mp         = mp;
+}
+#endif
+
+/**
+ * This function will release all chunks of an arena.
+ *
+ * @param arena the arena
+ */
+void rt_arena_detach(rt_arena_t arena)
+{
+    struct rt_arena_chunk *chunk;
+
+    RT_ASSERT(arena != RT_NULL);
+
+    while (arena->chunk != RT_NULL)
+    {
+        chunk        = arena->chunk;
+        arena->chunk = chunk->next;
+        _arena_chunk_free(arena, chunk);
+    }
+    arena->ptr = RT_NULL;
+}
+
+/**
+ * This function will allocate a memory block from an arena. The block is
+ * released when the arena is rewound before it, or reset.
+ *
+ * @param arena the arena
+ * @param size the size of memory block
+ *
+ * @return the allocated memory block on successful, otherwise RT_NULL
+ */
+void *rt_arena_alloc(rt_arena_t arena, rt_size_t size)
+{
+    rt_uint8_t *ptr;
+
+    RT_ASSERT(arena != RT_NULL);
+
+    size = RT_ALIGN(size, RT_ALIGN_SIZE);
+    if (rt_likely(arena->chunk != RT_NULL && (rt_size_t)(arena->chunk->end - arena->ptr) >= size))
+    {
+        ptr = arena->ptr;
+        arena->ptr += size;
+
+        return ptr;
+    }
+
+    return _arena_grow(arena, size);
+}
+
+/**
+ * This function will allocate a zeroed memory block from an arena.
+ *
+ * @param arena the arena
+ * @param count the number of objects
+ * @param size the size of one object
+ *
+ * @return the allocated memory block on successful, otherwise RT_NULL
+ */
+void *rt_arena_calloc(rt_arena_t arena, rt_size_t count, rt_size_t size)
+{
+    void *ptr;
+
+    ptr = rt_arena_alloc(arena, count * size);
+    if (ptr != RT_NULL)
+        rt_memset(ptr, 0, count * size);
+
+    return ptr;
+}
+
+/**
+ * This function will duplicate a string in an arena.
+ *
+ * @param arena the arena
+ * @param s the string to be duplicated
+ *
+ * @return the duplicated string on successful, otherwise RT_NULL
+ */
+char *rt_arena_strdup(rt_arena_t arena, const char *s)
+{
+    rt_size_t size;
+    char *str;
+
+    size = rt_strlen(s) + 1;
+    str  = (char *)rt_arena_alloc(arena, size);
+    if (str != RT_NULL)
+        rt_memcpy(str, s, size);
+
+    return str;
+}
+
+/**
+ * This function will save the current position of an arena.
+ *
+ * @param arena the arena
+ * @param mark the saved position
+ */
+void rt_arena_mark(rt_arena_t arena, struct rt_arena_mark *mark)
+{
+    RT_ASSERT(arena != RT_NULL);
+    RT_ASSERT(mark != RT_NULL);
+
+    mark->chunk = arena->chunk;
+    mark->next  = arena->chunk != RT_NULL ? arena->chunk->next : RT_NULL;
+    mark->ptr   = arena->ptr;
+}
+
+/**
+ * This function will rewind an arena to a saved position, all memory blocks
+ * allocated after the position are released. A chunk of the normal size is
+ * kept for the following allocations when the arena is rewound to empty.
+ *
+ * @param arena the arena
+ * @param mark the position saved by rt_arena_mark
+ */
+void rt_arena_rewind(rt_arena_t arena, const struct rt_arena_mark *mark)
+{
+    struct rt_arena_chunk *chunk, *keep = RT_NULL;
+
+    RT_ASSERT(arena != RT_NULL);
+    RT_ASSERT(mark != RT_NULL);
+
+    /* the chunks allocated after the position are before the marked chunk */
+    while (arena->chunk != mark->chunk)
+    {
+        chunk = arena->chunk;
+        RT_ASSERT(chunk != RT_NULL);
+        arena->chunk = chunk->next;
+
+        if (mark->chunk == RT_NULL && keep == RT_NULL &&
+            (rt_size_t)(chunk->end - (rt_uint8_t *)chunk) == arena->chunk_size)
+            keep = chunk;
+        else
+            _arena_chunk_free(arena, chunk);
+    }
+
+    if (keep != RT_NULL)
+    {
+        keep->next   = RT_NULL;
+        arena->chunk = keep;
+        arena->ptr   = ARENA_CHUNK_DATA(keep);
+
+        return;
+    }
+
+    /* and the dedicated chunks are behind it */
+    if (mark->chunk != RT_NULL)
+    {
+        while (mark->chunk->next != mark->next)
+        {
+            chunk = mark->chunk->next;
+            RT_ASSERT(chunk != RT_NULL);
+            mark->chunk->next = chunk->next;
+            _arena_chunk_free(arena, chunk);
+        }
+    }
+
+    arena->ptr = mark->ptr;
+}
+
+/**
+ * This function will release all memory blocks allocated from an arena.
+ *
+ * @param arena the arena
+ */
+void rt_arena_reset(rt_arena_t arena)
+{
+    struct rt_arena_mark mark = {RT_NULL, RT_NULL, RT_NULL};
+
+    rt_arena_rewind(arena, &mark);
+}
+
+/**
+ * This function will bind an arena to current thread, through the user_data
+ * of thread. The arena shall be unbound by RT_NULL before it is detached.
+ *
+ * @param arena the arena, RT_NULL to unbind
+ */
+void rt_arena_bind(rt_arena_t arena)
+{
+    rt_thread_t thread;
+
+    thread = rt_thread_self();
+    RT_ASSERT(thread != RT_NULL);
+
+    thread->user_data = (rt_ubase_t)arena;
+}
+
+/**
+ * This function will return the arena bound to current thread.
+ *
+ * @return the arena of current thread, RT_NULL if there is none
+ */
+rt_arena_t rt_arena_self(void)
+{
+    rt_thread_t thread;
+
+    thread = rt_thread_self();
+    if (thread == RT_NULL)
+        return RT_NULL;
+
+    return (rt_arena_t)thread->user_data;
+}
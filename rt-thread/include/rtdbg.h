@@ -25,6 +25,11 @@
  * Then in your C/C++ file, you can use LOG_X macro to print out logs:
  * LOG_D("this is a debug log!");
  * LOG_E("this is a error log!");
+ *
+ * When RT_USING_DBG_TAG_LEVEL is defined, all levels are compiled in and
+ * DBG_LVL is only the initial level of the tag. The level of a tag can be
+ * changed at runtime by rt_dbg_tag_set_level or msh command "dbg_level",
+ * once the tag is registered by its first log.
  */
 
 #ifndef RT_DBG_H__
@@ -81,6 +86,19 @@ extern "C" {
 #endif
 #endif /* DBG_LVL */
 
+#ifdef RT_USING_DBG_TAG_LEVEL
+#include <rtthread.h>
+
+static struct rt_dbg_tag _dbg_tag RT_UNUSED =
+    {DBG_SECTION_NAME, RT_DBG_TAG_UNREGISTERED, DBG_LEVEL, RT_NULL};
+
+/* one load and compare before the arguments are evaluated */
+#define _DBG_ON(lv)                                        \
+    (_dbg_tag.level >= (lv) && rt_dbg_tag_check(&_dbg_tag, (lv)))
+#else
+#define _DBG_ON(lv)             ((lv) <= DBG_LEVEL)
+#endif /* RT_USING_DBG_TAG_LEVEL */
+
 /*
  * The color for terminal (foreground)
  * BLACK    30
@@ -112,7 +130,7 @@ extern "C" {
  *       It will be DISCARDED later. Because it will take up more resources.
  */
 #define dbg_log(level, fmt, ...)                            \
-    if ((level) <= DBG_LEVEL)                               \
+    if (_DBG_ON(level))                                     \
     {                                                       \
         switch(level)                                       \
         {                                                   \
@@ -127,7 +145,7 @@ extern "C" {
     }
 
 #define dbg_here                                            \
-    if ((DBG_LEVEL) <= DBG_LOG){                            \
+    if (_DBG_ON(DBG_LOG)){                                  \
         rt_kprintf(DBG_SECTION_NAME " Here %s:%d\n",        \
             __FUNCTION__, __LINE__);                        \
     }
@@ -152,6 +170,20 @@ extern "C" {
 #define dbg_raw(...)
 #endif /* DBG_ENABLE */
 
+#if defined(DBG_ENABLE) && defined(RT_USING_DBG_TAG_LEVEL)
+#define _DBG_LOG_X(lv, lvl, color_n, fmt, ...)             \
+    do                                                      \
+    {                                                       \
+        if (_DBG_ON(lv))                                    \
+            dbg_log_line(lvl, color_n, fmt, ##__VA_ARGS__); \
+    }                                                       \
+    while (0)
+
+#define LOG_D(fmt, ...)      _DBG_LOG_X(DBG_LOG, "D", 0, fmt, ##__VA_ARGS__)
+#define LOG_I(fmt, ...)      _DBG_LOG_X(DBG_INFO, "I", 32, fmt, ##__VA_ARGS__)
+#define LOG_W(fmt, ...)      _DBG_LOG_X(DBG_WARNING, "W", 33, fmt, ##__VA_ARGS__)
+#define LOG_E(fmt, ...)      _DBG_LOG_X(DBG_ERROR, "E", 31, fmt, ##__VA_ARGS__)
+#else
 #if (DBG_LEVEL >= DBG_LOG)
 #define LOG_D(fmt, ...)      dbg_log_line("D", 0, fmt, ##__VA_ARGS__)
 #else
@@ -175,6 +207,7 @@ extern "C" {
 #else
 #define LOG_E(...)
 #endif
+#endif /* defined(DBG_ENABLE) && defined(RT_USING_DBG_TAG_LEVEL) */
 
 #define LOG_RAW(...)         dbg_raw(__VA_ARGS__)
 
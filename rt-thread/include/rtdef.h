@@ -179,13 +179,22 @@ typedef rt_base_t                       rt_off_t;       /**< Type for offset */
     #error not supported tool chain
 #endif
 
+/* branch prediction hints */
+#if defined(__GNUC__) || defined(__CC_ARM) || defined(__CLANG_ARM)
+    #define rt_likely(x)                __builtin_expect(!!(x), 1)
+    #define rt_unlikely(x)              __builtin_expect(!!(x), 0)
+#else
+    #define rt_likely(x)                (x)
+    #define rt_unlikely(x)              (x)
+#endif
+
 /* initialization export */
 #ifdef RT_USING_COMPONENTS_INIT
 typedef int (*init_fn_t)(void);
 #ifdef _MSC_VER /* we do not support MS VC++ compiler */
     #define INIT_EXPORT(fn, level)
 #else
-    #if RT_DEBUG_INIT
+    #if RT_DEBUG_INIT || defined(RT_USING_BOOT_PROFILE)
         struct rt_init_desc
         {
             const char* fn_name;
@@ -218,6 +227,8 @@ typedef int (*init_fn_t)(void);
 #define INIT_ENV_EXPORT(fn)             INIT_EXPORT(fn, "5")
 /* appliation initialization (rtgui application etc ...) */
 #define INIT_APP_EXPORT(fn)             INIT_EXPORT(fn, "6")
+/* deferred initialization (non-critical, run in a low priority thread after main starts) */
+#define INIT_DEFERRED_EXPORT(fn)        INIT_EXPORT(fn, "7")
 
 #if !defined(RT_USING_FINSH)
 /* define these to empty, even if not include finsh.h file */
@@ -333,7 +344,11 @@ typedef struct rt_slist_node rt_slist_t;                /**< Type for single lis
  */
 struct rt_object
 {
+#ifdef RT_USING_OBJECT_NAME_REF
+    const char *name;                                   /**< name of kernel object, not copied */
+#else
     char       name[RT_NAME_MAX];                       /**< name of kernel object */
+#endif
     rt_uint8_t type;                                    /**< type of kernel object */
     rt_uint8_t flag;                                    /**< flag of kernel object */
 
@@ -385,13 +400,112 @@ struct rt_object_information
 };
 
 /**
- * The hook function call macro
+ * The hook list and hook function call macros
  */
 #ifdef RT_USING_HOOK
-#define RT_OBJECT_HOOK_CALL(func, argv) \
-    do { if ((func) != RT_NULL) func argv; } while (0)
+#ifndef RT_HOOK_LIST_SIZE
+#define RT_HOOK_LIST_SIZE               4               /**< maximal hooks on one hook list */
+#endif
+
+/* the type of hook list, the macro parameters are the parameters of hook function */
+#define RT_OBJECT_HOOK_LIST(...)                                            \
+    struct                                                                  \
+    {                                                                       \
+        volatile rt_uint8_t nr;                                             \
+        void (*volatile hook[RT_HOOK_LIST_SIZE])(__VA_ARGS__);              \
+    }
+
+/*
+ * call all hooks on the list, only one branch is taken if the list is empty.
+ * The scan stops once the counted hooks are called. Each slot is read once,
+ * as a hook may be deleted by an interrupt between the test and the call.
+ */
+#define RT_OBJECT_HOOK_CALL(list, argv)                                     \
+    do                                                                      \
+    {                                                                       \
+        if (rt_unlikely((list).nr != 0))                                    \
+        {                                                                   \
+            rt_ubase_t __index, __nr = (list).nr;                           \
+            for (__index = 0; __nr != 0 && __index < RT_HOOK_LIST_SIZE;     \
+                 __index ++)                                                \
+            {                                                               \
+                __typeof__(*(list).hook[0]) *__hook = (list).hook[__index];  \
+                if (__hook != RT_NULL)                                      \
+                {                                                           \
+                    __hook argv;                                            \
+                    __nr --;                                                \
+                }                                                           \
+            }                                                               \
+        }                                                                   \
+    } while (0)
+
+/*
+ * add a hook function to the list, err is set to -RT_EFULL if the list is
+ * full. A hook already on the list is not added twice. A RT_NULL hook clears
+ * the list, as setting a RT_NULL hook did when only one hook was allowed.
+ */
+#define RT_OBJECT_HOOK_LIST_ADD(list, func, err)                            \
+    do                                                                      \
+    {                                                                       \
+        rt_base_t __level;                                                  \
+        rt_ubase_t __index, __slot = RT_HOOK_LIST_SIZE;                     \
+        (err) = RT_EOK;                                                     \
+        __level = rt_hw_interrupt_disable();                                \
+        for (__index = 0; __index < RT_HOOK_LIST_SIZE; __index ++)          \
+        {                                                                   \
+            if ((func) == RT_NULL)                                          \
+                (list).hook[__index] = RT_NULL;                             \
+            else if ((list).hook[__index] == (func))                        \
+                break;                                                      \
+            else if ((list).hook[__index] == RT_NULL &&                     \
+                     __slot == RT_HOOK_LIST_SIZE)                           \
+                __slot = __index;                                           \
+        }                                                                   \
+        if ((func) == RT_NULL)                                              \
+        {                                                                   \
+            (list).nr = 0;                                                  \
+        }                                                                   \
+        else if (__index == RT_HOOK_LIST_SIZE)                              \
+        {                                                                   \
+            if (__slot == RT_HOOK_LIST_SIZE)                                \
+            {                                                               \
+                (err) = -RT_EFULL;                                          \
+            }                                                               \
+            else                                                            \
+            {                                                               \
+                (list).hook[__slot] = (func);                               \
+                (list).nr ++;                                               \
+            }                                                               \
+        }                                                                   \
+        rt_hw_interrupt_enable(__level);                                    \
+    } while (0)
+
+/*
+ * delete a hook function from the list, err is set to -RT_ENOSYS if not found.
+ * A RT_NULL hook is never on the list, so the empty slots are not matched.
+ */
+#define RT_OBJECT_HOOK_LIST_DEL(list, func, err)                            \
+    do                                                                      \
+    {                                                                       \
+        rt_base_t __level;                                                  \
+        rt_ubase_t __index;                                                 \
+        (err) = -RT_ENOSYS;                                                 \
+        __level = rt_hw_interrupt_disable();                                \
+        for (__index = 0; (func) != RT_NULL && __index < RT_HOOK_LIST_SIZE; \
+             __index ++)                                                    \
+        {                                                                   \
+            if ((list).hook[__index] == (func))                             \
+            {                                                               \
+                (list).hook[__index] = RT_NULL;                             \
+                (list).nr --;                                               \
+                (err) = RT_EOK;                                             \
+                break;                                                      \
+            }                                                               \
+        }                                                                   \
+        rt_hw_interrupt_enable(__level);                                    \
+    } while (0)
 #else
-#define RT_OBJECT_HOOK_CALL(func, argv)
+#define RT_OBJECT_HOOK_CALL(list, argv)
 #endif
 
 /**@}*/
@@ -479,10 +593,76 @@ typedef struct rt_timer *rt_timer_t;
 /**
  * Thread structure
  */
+#ifdef RT_USING_THREAD_COMPACT
+/*
+ * The compact layout: the fields used by the scheduler and the context switch
+ * follow the object header, the fields used at creation and exit are at the
+ * end. The built-in timer is replaced by a timeout node of the thread timeout
+ * list in timer.c, which has no object header and no timeout callback.
+ */
 struct rt_thread
 {
     /* rt object */
+#ifdef RT_USING_OBJECT_NAME_REF
+    const char *name;                                   /**< the name of thread, not copied */
+#else
     char        name[RT_NAME_MAX];                      /**< the name of thread */
+#endif
+    rt_uint8_t  type;                                   /**< type of object */
+    rt_uint8_t  flags;                                  /**< thread's flags */
+
+    rt_list_t   list;                                   /**< the object list */
+
+    /* the fields of scheduler */
+    rt_list_t   tlist;                                  /**< the thread list */
+    void       *sp;                                     /**< stack point */
+    rt_uint8_t  stat;                                   /**< thread status */
+    rt_uint8_t  current_priority;                       /**< current priority */
+#if RT_THREAD_PRIORITY_MAX > 32
+    rt_uint8_t  number;
+    rt_uint8_t  high_mask;
+#endif
+    rt_uint32_t number_mask;
+    rt_ubase_t  remaining_tick;                         /**< remaining tick */
+    rt_ubase_t  init_tick;                              /**< thread's initialized tick */
+#ifdef RT_USING_SCHED_LATENCY
+    rt_uint32_t ready_stamp;                            /**< timestamp of being made ready */
+    rt_uint8_t  ready_pending;                          /**< waiting for the latency sample */
+#endif
+
+    /* the fields of suspend and resume */
+    rt_err_t    error;                                  /**< error code */
+    rt_list_t   timeout_list;                           /**< the node of thread timeout list */
+    rt_tick_t   timeout_tick;                           /**< the tick of timeout */
+#if defined(RT_USING_EVENT)
+    rt_uint32_t event_set;
+    rt_uint8_t  event_info;
+#endif
+    rt_uint8_t  init_priority;                          /**< initialized priority */
+
+    /* the fields of creation and exit */
+    void       *entry;                                  /**< entry */
+    void       *parameter;                              /**< parameter */
+    void       *stack_addr;                             /**< stack address */
+    rt_uint32_t stack_size;                             /**< stack size */
+
+    void (*cleanup)(struct rt_thread *tid);             /**< cleanup function when thread exit */
+
+    rt_ubase_t  user_data;                              /**< private user data beyond this thread */
+
+#ifdef RT_USING_HEAP_INFO
+    rt_base_t   heap_used;                              /**< heap bytes of the blocks allocated by this thread */
+#endif
+};
+#else
+struct rt_thread
+{
+    /* rt object */
+#ifdef RT_USING_OBJECT_NAME_REF
+    const char *name;                                   /**< the name of thread, not copied */
+#else
+    char        name[RT_NAME_MAX];                      /**< the name of thread */
+#endif
     rt_uint8_t  type;                                   /**< type of object */
     rt_uint8_t  flags;                                  /**< thread's flags */
 
@@ -523,10 +703,38 @@ struct rt_thread
 
     void (*cleanup)(struct rt_thread *tid);             /**< cleanup function when thread exit */
 
-    rt_uint32_t user_data;                              /**< private user data beyond this thread */
+    rt_ubase_t  user_data;                              /**< private user data beyond this thread */
+
+#ifdef RT_USING_HEAP_INFO
+    rt_base_t   heap_used;                              /**< heap bytes of the blocks allocated by this thread */
+#endif
+
+#ifdef RT_USING_SCHED_LATENCY
+    rt_uint32_t ready_stamp;                            /**< timestamp of being made ready */
+    rt_uint8_t  ready_pending;                          /**< waiting for the latency sample */
+#endif
 };
+#endif /* RT_USING_THREAD_COMPACT */
 typedef struct rt_thread *rt_thread_t;
 
+#ifdef RT_USING_SCHED_LATENCY
+#define RT_SCHED_LATENCY_BUCKETS        32                  /**< one bucket per bit of the timestamp */
+
+/**
+ * Wakeup-to-run latency statistics of one priority level, in timestamp units.
+ * Bucket n counts the samples in [2^(n-1), 2^n), bucket 0 counts zero latency.
+ */
+struct rt_sched_latency
+{
+    rt_uint32_t count;                                  /**< number of samples */
+    rt_uint32_t min;                                    /**< minimal latency */
+    rt_uint32_t max;                                    /**< maximal latency */
+    rt_uint64_t sum;                                    /**< sum of all samples */
+
+    rt_uint32_t histogram[RT_SCHED_LATENCY_BUCKETS];    /**< log2 histogram */
+};
+#endif
+
 /**@}*/
 
 /**
@@ -667,7 +875,91 @@ typedef struct rt_messagequeue *rt_mq_t;
  * heap & partition
  */
 
+#ifdef RT_USING_HEAP_MAGAZINE
+/*
+ * magazine cache of small heap chunks
+ */
+#ifndef RT_HEAP_MAGAZINE_MAX
+#define RT_HEAP_MAGAZINE_MAX            128             /**< the largest size class, power of 2 */
+#endif
+#ifndef RT_HEAP_MAGAZINE_SIZE
+#define RT_HEAP_MAGAZINE_SIZE           8               /**< maximal chunks cached in a size class */
+#endif
+#ifndef RT_HEAP_MAGAZINE_BATCH
+#define RT_HEAP_MAGAZINE_BATCH          (RT_HEAP_MAGAZINE_SIZE / 2) /**< chunks filled or drained at once */
+#endif
+#endif
+
+#ifdef RT_USING_HEAP_PROFILE
+/*
+ * sampled allocation-site profiler
+ */
+#ifndef RT_HEAP_PROFILE_SITES
+#define RT_HEAP_PROFILE_SITES           64              /**< call sites recorded, power of 2 */
+#endif
+#ifndef RT_HEAP_PROFILE_BLOCKS
+#define RT_HEAP_PROFILE_BLOCKS          128             /**< live sampled blocks recorded, power of 2 */
+#endif
+
+/**
+ * the estimated bytes of a call site of heap API
+ */
+struct rt_heap_profile_site
+{
+    void       *caller;                 /**< return address of heap API */
+    rt_size_t   live;                   /**< estimated live bytes */
+    rt_size_t   total;                  /**< estimated allocated bytes */
+    rt_uint32_t count;                  /**< live sampled blocks */
+};
+#endif
+
+#ifdef RT_USING_HEAP_INFO
+#define RT_HEAP_INFO_BINS               16              /**< power of 2 size classes of free blocks, from 16 bytes */
+
+/**
+ * statistics of the free blocks in a heap, updated when a free block is
+ * created or removed
+ */
+struct rt_heap_stat
+{
+    rt_uint32_t count[RT_HEAP_INFO_BINS];               /**< number of free blocks in size class */
+    rt_size_t   size[RT_HEAP_INFO_BINS];                /**< bytes of free blocks in size class */
+    rt_size_t   largest;                                /**< size of the largest free block */
+    rt_uint32_t largest_count;                          /**< number of largest free blocks, 0 if it is lost */
+};
+
+/**
+ * heap introspection information
+ */
+struct rt_heap_info
+{
+    rt_size_t   total;                                  /**< size of heap */
+    rt_size_t   used;                                   /**< used bytes */
+    rt_size_t   max_used;                               /**< maximal used bytes */
+
+    rt_size_t   free_size;                              /**< bytes of free blocks */
+    rt_uint32_t free_count;                             /**< number of free blocks */
+    rt_size_t   largest_free;                           /**< size of the largest free block */
+    rt_uint8_t  fragmentation;                          /**< external fragmentation in percent */
+    rt_uint32_t histogram[RT_HEAP_INFO_BINS];           /**< number of free blocks in size class */
+};
+#endif
+
 #ifdef RT_USING_MEMHEAP
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+/*
+ * attributes of the memory regions in system heap set
+ */
+#define RT_MEM_FAST                     0x01            /**< fast memory, such as CCM or DTCM */
+#define RT_MEM_DMA                      0x02            /**< memory accessible by DMA */
+#define RT_MEM_BULK                     0x04            /**< large and slow memory, such as SDRAM */
+#define RT_MEM_REGION                   0x80            /**< the memory heap is a region of system heap */
+#endif
+
+#ifdef RT_USING_MEMHEAP_BINS
+#define RT_MEMHEAP_BINS                 32              /**< free lists of power of 2 size classes */
+#endif
+
 /**
  * memory item on the heap
  */
@@ -681,6 +973,9 @@ struct rt_memheap_item
 
     struct rt_memheap_item *next_free;                  /**< next free memheap item */
     struct rt_memheap_item *prev_free;                  /**< prev free memheap item */
+#ifdef RT_USING_HEAP_INFO
+    struct rt_thread       *owner;                      /**< thread charged for the allocated item */
+#endif
 };
 
 /**
@@ -701,7 +996,21 @@ struct rt_memheap
     struct rt_memheap_item *free_list;                  /**< free block list */
     struct rt_memheap_item  free_header;                /**< free block list header */
 
+#ifdef RT_USING_MEMHEAP_BINS
+    rt_uint32_t             bin_bitmap;                 /**< bitmap of non-empty free lists */
+    struct rt_memheap_item *bin[RT_MEMHEAP_BINS];       /**< free lists segregated by size */
+#endif
+#ifdef RT_USING_HEAP_INFO
+    struct rt_heap_stat     stat;                       /**< statistics of free blocks */
+#endif
+
     struct rt_semaphore     lock;                       /**< semaphore lock */
+
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+    rt_uint32_t             region_flags;               /**< attributes of region in system heap */
+    rt_uint32_t             alloc_count;                /**< allocations of system heap */
+    rt_uint32_t             fallback_count;             /**< allocations without the requested attributes */
+#endif
 };
 #endif
 
@@ -721,14 +1030,75 @@ struct rt_mempool
 
     rt_size_t        block_total_count;                 /**< numbers of memory block */
     rt_size_t        block_free_count;                  /**< numbers of free memory block */
+    rt_size_t        block_used_max;                    /**< maximal numbers of used memory block */
 
     rt_list_t        suspend_thread;                    /**< threads pended on this resource */
 };
 typedef struct rt_mempool *rt_mp_t;
+
+#ifdef RT_USING_MPSET
+#ifndef RT_MPSET_CLASSES
+#define RT_MPSET_CLASSES                8
+#endif
+
+/**
+ * Set of memory pools with power-of-two block sizes, an allocation is served
+ * by the smallest block which fits it.
+ */
+struct rt_mpset
+{
+    rt_mp_t          mp[RT_MPSET_CLASSES];              /**< memory pools sorted by block size */
+    rt_uint8_t       count;                             /**< numbers of memory pools */
+};
+typedef struct rt_mpset *rt_mpset_t;
+#endif
+
+#if defined(RT_USING_KMEM_CACHE) && defined(RT_USING_HEAP)
+/**
+ * Cache of fixed-size objects, the objects are carved from slabs which are
+ * memory pools allocated from system heap on demand.
+ */
+struct rt_kmem_cache
+{
+    const char      *name;                              /**< name of the cache */
+
+    rt_size_t        object_size;                       /**< size of cached objects */
+    rt_size_t        slab_objects;                      /**< numbers of objects in one slab */
+
+    rt_list_t        slab_list;                         /**< slabs of the cache */
+    rt_uint16_t      slab_count;                        /**< numbers of slabs */
+
+    rt_uint32_t      used_count;                        /**< numbers of objects in use */
+    rt_uint32_t      hit_count;                         /**< allocations served by the slabs */
+    rt_uint32_t      miss_count;                        /**< allocations which need a new slab */
+};
+typedef struct rt_kmem_cache *rt_kmem_cache_t;
+#endif
 #endif
 
 /**@}*/
 
+#ifdef RT_USING_DBG_TAG_LEVEL
+#ifndef RT_DBG_TAG_MAX
+#define RT_DBG_TAG_MAX                  32              /**< distinct log tags with runtime level */
+#endif
+
+/* the level of a log tag which is not registered yet, it passes any level check */
+#define RT_DBG_TAG_UNREGISTERED         0x7f
+
+/**
+ * The log tag of a translation unit which includes rtdbg.h, the units of the
+ * same tag are linked and share the level.
+ */
+struct rt_dbg_tag
+{
+    const char         *name;                           /**< name of tag */
+    volatile rt_int8_t  level;                          /**< current level of tag */
+    rt_int8_t           init_level;                     /**< the level defined by DBG_LVL */
+    struct rt_dbg_tag  *next;                           /**< next unit of the same tag */
+};
+#endif
+
 #ifdef RT_USING_DEVICE
 /**
  * @addtogroup Device
@@ -117,6 +117,12 @@ void rt_hw_exception_install(rt_err_t (*exception_handle)(void *context));
  */
 void rt_hw_us_delay(rt_uint32_t us);
 
+/*
+ * timestamp interfaces
+ */
+rt_uint32_t rt_hw_timestamp_get(void);
+rt_uint32_t rt_hw_timestamp_freq(void);
+
 #define RT_DEFINE_SPINLOCK(x)
 #define RT_DECLARE_SPINLOCK(x)    rt_ubase_t x
 
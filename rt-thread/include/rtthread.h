@@ -52,13 +52,21 @@ void rt_object_delete(rt_object_t object);
 rt_bool_t rt_object_is_systemobject(rt_object_t object);
 rt_uint8_t rt_object_get_type(rt_object_t object);
 rt_object_t rt_object_find(const char *name, rt_uint8_t type);
+#if defined(RT_USING_KMEM_CACHE) && defined(RT_USING_MEMPOOL) && defined(RT_USING_HEAP)
+void rt_object_cache_dump(void);
+#endif
 
 #ifdef RT_USING_HOOK
-void rt_object_attach_sethook(void (*hook)(struct rt_object *object));
-void rt_object_detach_sethook(void (*hook)(struct rt_object *object));
-void rt_object_trytake_sethook(void (*hook)(struct rt_object *object));
-void rt_object_take_sethook(void (*hook)(struct rt_object *object));
-void rt_object_put_sethook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_attach_sethook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_attach_delhook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_detach_sethook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_detach_delhook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_trytake_sethook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_trytake_delhook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_take_sethook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_take_delhook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_put_sethook(void (*hook)(struct rt_object *object));
+rt_err_t rt_object_put_delhook(void (*hook)(struct rt_object *object));
 #endif
 
 /**@}*/
@@ -99,11 +107,15 @@ rt_err_t rt_timer_stop(rt_timer_t timer);
 rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg);
 
 rt_tick_t rt_timer_next_timeout_tick(void);
+void rt_thread_timeout_start(rt_thread_t thread, rt_tick_t tick);
+void rt_thread_timeout_stop(rt_thread_t thread);
 void rt_timer_check(void);
 
 #ifdef RT_USING_HOOK
-void rt_timer_enter_sethook(void (*hook)(struct rt_timer *timer));
-void rt_timer_exit_sethook(void (*hook)(struct rt_timer *timer));
+rt_err_t rt_timer_enter_sethook(void (*hook)(struct rt_timer *timer));
+rt_err_t rt_timer_enter_delhook(void (*hook)(struct rt_timer *timer));
+rt_err_t rt_timer_exit_sethook(void (*hook)(struct rt_timer *timer));
+rt_err_t rt_timer_exit_delhook(void (*hook)(struct rt_timer *timer));
 #endif
 
 /**@}*/
@@ -147,9 +159,12 @@ rt_err_t rt_thread_resume(rt_thread_t thread);
 void rt_thread_timeout(void *parameter);
 
 #ifdef RT_USING_HOOK
-void rt_thread_suspend_sethook(void (*hook)(rt_thread_t thread));
-void rt_thread_resume_sethook (void (*hook)(rt_thread_t thread));
-void rt_thread_inited_sethook (void (*hook)(rt_thread_t thread));
+rt_err_t rt_thread_suspend_sethook(void (*hook)(rt_thread_t thread));
+rt_err_t rt_thread_suspend_delhook(void (*hook)(rt_thread_t thread));
+rt_err_t rt_thread_resume_sethook(void (*hook)(rt_thread_t thread));
+rt_err_t rt_thread_resume_delhook(void (*hook)(rt_thread_t thread));
+rt_err_t rt_thread_inited_sethook(void (*hook)(rt_thread_t thread));
+rt_err_t rt_thread_inited_delhook(void (*hook)(rt_thread_t thread));
 #endif
 
 /*
@@ -178,7 +193,14 @@ void rt_exit_critical(void);
 rt_uint16_t rt_critical_level(void);
 
 #ifdef RT_USING_HOOK
-void rt_scheduler_sethook(void (*hook)(rt_thread_t from, rt_thread_t to));
+rt_err_t rt_scheduler_sethook(void (*hook)(rt_thread_t from, rt_thread_t to));
+rt_err_t rt_scheduler_delhook(void (*hook)(rt_thread_t from, rt_thread_t to));
+#endif
+
+#ifdef RT_USING_SCHED_LATENCY
+rt_err_t rt_sched_latency_get(rt_uint8_t priority, struct rt_sched_latency *latency);
+rt_uint32_t rt_sched_latency_p99(const struct rt_sched_latency *latency);
+void rt_sched_latency_reset(void);
 #endif
 
 /**@}*/
@@ -211,8 +233,34 @@ void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time);
 void rt_mp_free(void *block);
 
 #ifdef RT_USING_HOOK
-void rt_mp_alloc_sethook(void (*hook)(struct rt_mempool *mp, void *block));
-void rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block));
+rt_err_t rt_mp_alloc_sethook(void (*hook)(struct rt_mempool *mp, void *block));
+rt_err_t rt_mp_alloc_delhook(void (*hook)(struct rt_mempool *mp, void *block));
+rt_err_t rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block));
+rt_err_t rt_mp_free_delhook(void (*hook)(struct rt_mempool *mp, void *block));
+#endif
+
+#ifdef RT_USING_MPSET
+/*
+ * memory pool set interface
+ */
+void rt_mpset_init(rt_mpset_t set);
+rt_err_t rt_mpset_add(rt_mpset_t set, rt_mp_t mp);
+void *rt_mpset_alloc(rt_mpset_t set, rt_size_t size, rt_int32_t time);
+void rt_mpset_free(void *block);
+#endif
+
+#if defined(RT_USING_KMEM_CACHE) && defined(RT_USING_HEAP)
+/*
+ * kernel object cache interface
+ */
+void rt_kmem_cache_init(rt_kmem_cache_t cache,
+                        const char     *name,
+                        rt_size_t       object_size,
+                        rt_size_t       slab_objects);
+void rt_kmem_cache_detach(rt_kmem_cache_t cache);
+void *rt_kmem_cache_alloc(rt_kmem_cache_t cache);
+void rt_kmem_cache_free(rt_kmem_cache_t cache, void *object);
+rt_size_t rt_kmem_cache_footprint(rt_kmem_cache_t cache);
 #endif
 
 #endif
@@ -226,6 +274,7 @@ void rt_system_heap_init(void *begin_addr, void *end_addr);
 void *rt_malloc(rt_size_t nbytes);
 void rt_free(void *ptr);
 void *rt_realloc(void *ptr, rt_size_t nbytes);
+void *rt_realloc_inplace(void *ptr, rt_size_t nbytes);
 void *rt_calloc(rt_size_t count, rt_size_t size);
 void *rt_malloc_align(rt_size_t size, rt_size_t align);
 void rt_free_align(void *ptr);
@@ -234,14 +283,77 @@ void rt_memory_info(rt_uint32_t *total,
                     rt_uint32_t *used,
                     rt_uint32_t *max_used);
 
+#ifdef RT_USING_HEAP_MAGAZINE
+void *rt_heap_magazine_get(rt_size_t *size);
+rt_err_t rt_heap_magazine_put(void *ptr, rt_size_t size, void **flush);
+void rt_heap_magazine_fill(void *heap, rt_size_t size,
+                           void *(*alloc)(void *heap, rt_size_t size));
+void *rt_heap_magazine_drain(void);
+void rt_heap_magazine_dump(void);
+#endif
+
+#ifdef RT_USING_HEAP_INFO
+void rt_heap_stat_add(struct rt_heap_stat *stat, rt_size_t size);
+void rt_heap_stat_del(struct rt_heap_stat *stat, rt_size_t size);
+rt_bool_t rt_heap_stat_largest_lost(struct rt_heap_stat *stat);
+void rt_heap_stat_largest_found(struct rt_heap_stat *stat, rt_size_t size);
+void rt_heap_stat_merge(const struct rt_heap_stat *stat, struct rt_heap_info *info);
+void rt_heap_stat_charge(rt_thread_t *owner, rt_size_t size);
+void rt_heap_stat_uncharge(rt_thread_t owner, rt_size_t size);
+void rt_heap_info_get(struct rt_heap_info *info);
+#endif
+
+#ifdef RT_USING_HEAP_PROFILE
+extern rt_size_t rt_heap_profile_rate;
+
+void rt_heap_profile_set(rt_size_t rate);
+void rt_heap_profile_reset(void);
+void rt_heap_profile_alloc(void *ptr, rt_size_t size, void *caller);
+void rt_heap_profile_free(void *ptr);
+void rt_heap_profile_caller(void *ptr, void *caller);
+int rt_heap_profile_top(struct rt_heap_profile_site *sites, int count);
+rt_uint32_t rt_heap_profile_dropped(void);
+void rt_heap_profile_dump(int count);
+
+/*
+ * The heaps record the allocations and frees of heap API through these
+ * macros, which is one branch when the profiler is stopped. The caller is
+ * the return address of the heap API which uses the macro.
+ */
+#define RT_HEAP_PROFILE_ALLOC(ptr, size)                                    \
+    do                                                                      \
+    {                                                                       \
+        if (rt_unlikely(rt_heap_profile_rate != 0))                         \
+            rt_heap_profile_alloc((ptr), (size), __builtin_return_address(0)); \
+    } while (0)
+#define RT_HEAP_PROFILE_FREE(ptr)                                           \
+    do                                                                      \
+    {                                                                       \
+        if (rt_unlikely(rt_heap_profile_rate != 0))                         \
+            rt_heap_profile_free(ptr);                                      \
+    } while (0)
+#define RT_HEAP_PROFILE_CALLER(ptr)                                         \
+    do                                                                      \
+    {                                                                       \
+        if (rt_unlikely(rt_heap_profile_rate != 0))                         \
+            rt_heap_profile_caller((ptr), __builtin_return_address(0));     \
+    } while (0)
+#else
+#define RT_HEAP_PROFILE_ALLOC(ptr, size)
+#define RT_HEAP_PROFILE_FREE(ptr)
+#define RT_HEAP_PROFILE_CALLER(ptr)
+#endif
+
 #ifdef RT_USING_SLAB
 void *rt_page_alloc(rt_size_t npages);
 void rt_page_free(void *addr, rt_size_t npages);
 #endif
 
 #ifdef RT_USING_HOOK
-void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size));
-void rt_free_sethook(void (*hook)(void *ptr));
+rt_err_t rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size));
+rt_err_t rt_malloc_delhook(void (*hook)(void *ptr, rt_size_t size));
+rt_err_t rt_free_sethook(void (*hook)(void *ptr));
+rt_err_t rt_free_delhook(void (*hook)(void *ptr));
 #endif
 
 #endif
@@ -256,8 +368,15 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
                          rt_size_t         size);
 rt_err_t rt_memheap_detach(struct rt_memheap *heap);
 void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size);
+void *rt_memheap_alloc_align(struct rt_memheap *heap, rt_size_t size, rt_size_t align);
 void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize);
+void *rt_memheap_realloc_inplace(struct rt_memheap *heap, void *ptr, rt_size_t newsize);
 void rt_memheap_free(void *ptr);
+
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+rt_err_t rt_memheap_region_add(struct rt_memheap *heap, rt_uint32_t flags);
+void *rt_malloc_region(rt_size_t size, rt_uint32_t flags);
+#endif
 #endif
 
 /**@}*/
@@ -432,8 +551,10 @@ void rt_interrupt_leave(void);
 rt_uint8_t rt_interrupt_get_nest(void);
 
 #ifdef RT_USING_HOOK
-void rt_interrupt_enter_sethook(void (*hook)(void));
-void rt_interrupt_leave_sethook(void (*hook)(void));
+rt_err_t rt_interrupt_enter_sethook(void (*hook)(void));
+rt_err_t rt_interrupt_enter_delhook(void (*hook)(void));
+rt_err_t rt_interrupt_leave_sethook(void (*hook)(void));
+rt_err_t rt_interrupt_leave_delhook(void (*hook)(void));
 #endif
 
 #ifdef RT_USING_COMPONENTS_INIT
@@ -466,6 +587,12 @@ rt_int32_t rt_snprintf(char *buf, rt_size_t size, const char *format, ...);
 rt_device_t rt_console_set_device(const char *name);
 rt_device_t rt_console_get_device(void);
 #endif
+#ifdef RT_USING_CONSOLE_ASYNC
+int rt_console_async_init(void);
+rt_bool_t rt_console_async_puts(const char *str, rt_size_t length);
+rt_bool_t rt_console_async_vprintf(const char *fmt, va_list args);
+void rt_console_flush(void);
+#endif
 
 rt_err_t rt_get_errno(void);
 void rt_set_errno(rt_err_t no);
@@ -507,6 +634,11 @@ void rt_assert_set_hook(void (*hook)(const char *ex, const char *func, rt_size_t
 void rt_assert_handler(const char *ex, const char *func, rt_size_t line);
 #endif /* RT_DEBUG */
 
+#ifdef RT_USING_DBG_TAG_LEVEL
+rt_bool_t rt_dbg_tag_check(struct rt_dbg_tag *tag, int level);
+rt_err_t rt_dbg_tag_set_level(const char *name, int level);
+#endif
+
 #ifdef RT_USING_FINSH
 #include <finsh_api.h>
 #endif
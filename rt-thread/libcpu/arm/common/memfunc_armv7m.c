@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Memory routines for ARMv7-M (Cortex-M3/M4/M7), they override the weak
+ * versions of kservice.c. The aligned blocks are moved by LDM/STM of four
+ * registers, unrolled to 32 bytes. The unaligned source is read by LDR, so
+ * the UNALIGN_TRP bit of SCB->CCR shall be cleared, which is the default.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_CPU_MEMFUNC) && defined(__GNUC__) && \
+    (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)) && !defined(__ARMEB__)
+
+/* the word at an address of any alignment, the compiler emits a LDR */
+struct _unaligned_word
+{
+    rt_uint32_t value;
+} __attribute__((packed));
+
+#define LOAD_WORD(p)    (((const struct _unaligned_word *)(p))->value)
+
+/**
+ * This function will copy memory content from source address to destination
+ * address.
+ *
+ * @param dst the address of destination memory
+ * @param src the address of source memory
+ * @param count the copied length
+ *
+ * @return the address of destination memory
+ */
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dst;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    rt_ubase_t blocks;
+
+    if (count >= 16)
+    {
+        /* align the destination, the stores are always aligned */
+        while ((rt_ubase_t)d & 0x03)
+        {
+            *d++ = *s++;
+            count--;
+        }
+
+        if (((rt_ubase_t)s & 0x03) == 0 && count >= 32)
+        {
+            blocks = count >> 5;
+            count &= 31;
+
+            __asm volatile(
+                "1:                             \n"
+                "    ldmia  %[s]!, {r3-r6}      \n"
+                "    stmia  %[d]!, {r3-r6}      \n"
+                "    ldmia  %[s]!, {r3-r6}      \n"
+                "    stmia  %[d]!, {r3-r6}      \n"
+                "    subs   %[n], %[n], #1      \n"
+                "    bne    1b                  \n"
+                : [s] "+r" (s), [d] "+r" (d), [n] "+r" (blocks)
+                :
+                : "r3", "r4", "r5", "r6", "cc", "memory");
+        }
+
+        while (count >= 4)
+        {
+            *(rt_uint32_t *)d = LOAD_WORD(s);
+            d += 4;
+            s += 4;
+            count -= 4;
+        }
+    }
+
+    while (count--)
+        *d++ = *s++;
+
+    return dst;
+}
+
+/**
+ * This function will set the content of memory to specified value
+ *
+ * @param s the address of source memory
+ * @param c the value shall be set in content
+ * @param count the copied length
+ *
+ * @return the address of source memory
+ */
+void *rt_memset(void *s, int c, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)s;
+    rt_uint32_t word;
+    rt_ubase_t blocks;
+
+    if (count >= 16)
+    {
+        while ((rt_ubase_t)d & 0x03)
+        {
+            *d++ = (rt_uint8_t)c;
+            count--;
+        }
+
+        word = (rt_uint8_t)c * 0x01010101UL;
+
+        if (count >= 32)
+        {
+            blocks = count >> 5;
+            count &= 31;
+
+            __asm volatile(
+                "    mov    r3, %[w]            \n"
+                "    mov    r4, %[w]            \n"
+                "    mov    r5, %[w]            \n"
+                "    mov    r6, %[w]            \n"
+                "1:                             \n"
+                "    stmia  %[d]!, {r3-r6}      \n"
+                "    stmia  %[d]!, {r3-r6}      \n"
+                "    subs   %[n], %[n], #1      \n"
+                "    bne    1b                  \n"
+                : [d] "+r" (d), [n] "+r" (blocks)
+                : [w] "r" (word)
+                : "r3", "r4", "r5", "r6", "cc", "memory");
+        }
+
+        while (count >= 4)
+        {
+            *(rt_uint32_t *)d = word;
+            d += 4;
+            count -= 4;
+        }
+    }
+
+    while (count--)
+        *d++ = (rt_uint8_t)c;
+
+    return s;
+}
+
+/**
+ * This function will move memory content from source address to destination
+ * address.
+ *
+ * @param dest the address of destination memory
+ * @param src the address of source memory
+ * @param n the copied length
+ *
+ * @return the address of destination memory
+ */
+void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dest;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    rt_ubase_t blocks;
+
+    /* rt_memcpy reads each block before writing below it */
+    if (d <= s || d >= s + n)
+        return rt_memcpy(dest, src, n);
+
+    d += n;
+    s += n;
+
+    if (n >= 16)
+    {
+        while ((rt_ubase_t)d & 0x03)
+        {
+            *(--d) = *(--s);
+            n--;
+        }
+
+        if (((rt_ubase_t)s & 0x03) == 0 && n >= 32)
+        {
+            blocks = n >> 5;
+            n &= 31;
+
+            __asm volatile(
+                "1:                             \n"
+                "    ldmdb  %[s]!, {r3-r6}      \n"
+                "    stmdb  %[d]!, {r3-r6}      \n"
+                "    ldmdb  %[s]!, {r3-r6}      \n"
+                "    stmdb  %[d]!, {r3-r6}      \n"
+                "    subs   %[n], %[n], #1      \n"
+                "    bne    1b                  \n"
+                : [s] "+r" (s), [d] "+r" (d), [n] "+r" (blocks)
+                :
+                : "r3", "r4", "r5", "r6", "cc", "memory");
+        }
+
+        while (n >= 4)
+        {
+            d -= 4;
+            s -= 4;
+            *(rt_uint32_t *)d = LOAD_WORD(s);
+            n -= 4;
+        }
+    }
+
+    while (n--)
+        *(--d) = *(--s);
+
+    return dest;
+}
+
+/**
+ * This function will compare two areas of memory
+ *
+ * @param cs one area of memory
+ * @param ct another area of memory
+ * @param count the size of the area
+ *
+ * @return the result
+ */
+rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count)
+{
+    const rt_uint8_t *s1 = (const rt_uint8_t *)cs;
+    const rt_uint8_t *s2 = (const rt_uint8_t *)ct;
+    rt_uint32_t w1, w2, shift;
+
+    while (count >= 4)
+    {
+        w1 = LOAD_WORD(s1);
+        w2 = LOAD_WORD(s2);
+        if (w1 != w2)
+        {
+            /* the first different byte is the lowest one in little endian */
+            shift = __builtin_ctz(w1 ^ w2) & ~0x07;
+            return (rt_int32_t)((w1 >> shift) & 0xff) - (rt_int32_t)((w2 >> shift) & 0xff);
+        }
+        s1 += 4;
+        s2 += 4;
+        count -= 4;
+    }
+
+    while (count--)
+    {
+        if (*s1 != *s2)
+            return *s1 - *s2;
+        s1++;
+        s2++;
+    }
+
+    return 0;
+}
+
+#endif
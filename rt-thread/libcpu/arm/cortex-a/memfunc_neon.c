@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Memory routines for Cortex-A with NEON, they override the weak versions
+ * of kservice.c. The memory is moved by 16 bytes NEON registers, unrolled to
+ * 64 bytes. VLD1/VST1 of bytes have no alignment requirement on normal
+ * memory, so the NEON unit shall be enabled before the first call.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_CPU_MEMFUNC) && defined(__ARM_NEON)
+#include <arm_neon.h>
+
+/**
+ * This function will copy memory content from source address to destination
+ * address.
+ *
+ * @param dst the address of destination memory
+ * @param src the address of source memory
+ * @param count the copied length
+ *
+ * @return the address of destination memory
+ */
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dst;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    uint8x16_t v0, v1, v2, v3;
+
+    while (count >= 64)
+    {
+        v0 = vld1q_u8(s);
+        v1 = vld1q_u8(s + 16);
+        v2 = vld1q_u8(s + 32);
+        v3 = vld1q_u8(s + 48);
+        vst1q_u8(d, v0);
+        vst1q_u8(d + 16, v1);
+        vst1q_u8(d + 32, v2);
+        vst1q_u8(d + 48, v3);
+        d += 64;
+        s += 64;
+        count -= 64;
+    }
+
+    while (count >= 16)
+    {
+        vst1q_u8(d, vld1q_u8(s));
+        d += 16;
+        s += 16;
+        count -= 16;
+    }
+
+    while (count--)
+        *d++ = *s++;
+
+    return dst;
+}
+
+/**
+ * This function will set the content of memory to specified value
+ *
+ * @param s the address of source memory
+ * @param c the value shall be set in content
+ * @param count the copied length
+ *
+ * @return the address of source memory
+ */
+void *rt_memset(void *s, int c, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)s;
+    uint8x16_t v = vdupq_n_u8((rt_uint8_t)c);
+
+    while (count >= 64)
+    {
+        vst1q_u8(d, v);
+        vst1q_u8(d + 16, v);
+        vst1q_u8(d + 32, v);
+        vst1q_u8(d + 48, v);
+        d += 64;
+        count -= 64;
+    }
+
+    while (count >= 16)
+    {
+        vst1q_u8(d, v);
+        d += 16;
+        count -= 16;
+    }
+
+    while (count--)
+        *d++ = (rt_uint8_t)c;
+
+    return s;
+}
+
+/**
+ * This function will move memory content from source address to destination
+ * address.
+ *
+ * @param dest the address of destination memory
+ * @param src the address of source memory
+ * @param n the copied length
+ *
+ * @return the address of destination memory
+ */
+void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dest;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    uint8x16_t v0, v1, v2, v3;
+
+    /* rt_memcpy reads each block before writing below it */
+    if (d <= s || d >= s + n)
+        return rt_memcpy(dest, src, n);
+
+    d += n;
+    s += n;
+
+    while (n >= 64)
+    {
+        d -= 64;
+        s -= 64;
+        v0 = vld1q_u8(s);
+        v1 = vld1q_u8(s + 16);
+        v2 = vld1q_u8(s + 32);
+        v3 = vld1q_u8(s + 48);
+        vst1q_u8(d, v0);
+        vst1q_u8(d + 16, v1);
+        vst1q_u8(d + 32, v2);
+        vst1q_u8(d + 48, v3);
+        n -= 64;
+    }
+
+    while (n >= 16)
+    {
+        d -= 16;
+        s -= 16;
+        vst1q_u8(d, vld1q_u8(s));
+        n -= 16;
+    }
+
+    while (n--)
+        *(--d) = *(--s);
+
+    return dest;
+}
+
+/**
+ * This function will compare two areas of memory
+ *
+ * @param cs one area of memory
+ * @param ct another area of memory
+ * @param count the size of the area
+ *
+ * @return the result
+ */
+rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count)
+{
+    const rt_uint8_t *s1 = (const rt_uint8_t *)cs;
+    const rt_uint8_t *s2 = (const rt_uint8_t *)ct;
+    uint64x2_t diff;
+
+    /* skip the equal blocks, the different block is compared bytewise */
+    while (count >= 16)
+    {
+        diff = vreinterpretq_u64_u8(veorq_u8(vld1q_u8(s1), vld1q_u8(s2)));
+        if ((vgetq_lane_u64(diff, 0) | vgetq_lane_u64(diff, 1)) != 0)
+            break;
+        s1 += 16;
+        s2 += 16;
+        count -= 16;
+    }
+
+    while (count--)
+    {
+        if (*s1 != *s2)
+            return *s1 - *s2;
+        s1++;
+        s2++;
+    }
+
+    return 0;
+}
+
+#endif
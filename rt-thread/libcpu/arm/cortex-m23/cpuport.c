@@ -98,6 +98,10 @@ extern rt_thread_t rt_current_thread;
  */
 void rt_hw_hard_fault_exception(struct exception_stack_frame *contex)
 {
+#ifdef RT_USING_CONSOLE_ASYNC
+    rt_console_flush();
+#endif
+
     rt_kprintf("psr: 0x%08x\n", contex->psr);
     rt_kprintf(" pc: 0x%08x\n", contex->pc);
     rt_kprintf(" lr: 0x%08x\n", contex->lr);
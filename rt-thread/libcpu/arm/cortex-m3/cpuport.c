@@ -303,6 +303,10 @@ void rt_hw_hard_fault_exception(struct exception_info * exception_info)
             return;
     }
 
+#ifdef RT_USING_CONSOLE_ASYNC
+    rt_console_flush();
+#endif
+
     rt_kprintf("psr: 0x%08x\n", context->exception_stack_frame.psr);
 
     rt_kprintf("r00: 0x%08x\n", context->exception_stack_frame.r0);
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Memory routines for RISC-V, they override the weak versions of kservice.c.
+ * A misaligned access traps or is emulated slowly on most RISC-V cores, so
+ * the words are always accessed aligned: a source which is not aligned with
+ * the destination is read by aligned words and merged by shifts.
+ */
+
+#include <rtthread.h>
+
+#ifdef RT_USING_CPU_MEMFUNC
+
+#define WSIZE           sizeof(rt_ubase_t)
+#define WMASK           (WSIZE - 1)
+#define WBITS           (WSIZE * 8)
+
+/**
+ * This function will copy memory content from source address to destination
+ * address.
+ *
+ * @param dst the address of destination memory
+ * @param src the address of source memory
+ * @param count the copied length
+ *
+ * @return the address of destination memory
+ */
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dst;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    rt_ubase_t *wd;
+    const rt_ubase_t *ws;
+    rt_ubase_t offset, shift, prev, next;
+
+    if (count >= WSIZE * 2)
+    {
+        /* align the destination, the stores are always aligned */
+        while ((rt_ubase_t)d & WMASK)
+        {
+            *d++ = *s++;
+            count--;
+        }
+
+        wd = (rt_ubase_t *)d;
+        offset = (rt_ubase_t)s & WMASK;
+        if (offset == 0)
+        {
+            ws = (const rt_ubase_t *)s;
+            while (count >= WSIZE * 4)
+            {
+                wd[0] = ws[0];
+                wd[1] = ws[1];
+                wd[2] = ws[2];
+                wd[3] = ws[3];
+                wd += 4;
+                ws += 4;
+                count -= WSIZE * 4;
+            }
+
+            while (count >= WSIZE)
+            {
+                *wd++ = *ws++;
+                count -= WSIZE;
+            }
+            s = (const rt_uint8_t *)ws;
+        }
+        else
+        {
+            /*
+             * merge two aligned source words into one destination word, in
+             * little endian. The aligned word read ahead never crosses the
+             * page of the last source byte.
+             */
+            shift = offset * 8;
+            ws = (const rt_ubase_t *)(s - offset);
+            prev = *ws++;
+            while (count >= WSIZE)
+            {
+                next = *ws++;
+                *wd++ = (prev >> shift) | (next << (WBITS - shift));
+                prev = next;
+                s += WSIZE;
+                count -= WSIZE;
+            }
+        }
+
+        d = (rt_uint8_t *)wd;
+    }
+
+    while (count--)
+        *d++ = *s++;
+
+    return dst;
+}
+
+/**
+ * This function will set the content of memory to specified value
+ *
+ * @param s the address of source memory
+ * @param c the value shall be set in content
+ * @param count the copied length
+ *
+ * @return the address of source memory
+ */
+void *rt_memset(void *s, int c, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)s;
+    rt_ubase_t *wd;
+    rt_ubase_t word;
+
+    if (count >= WSIZE * 2)
+    {
+        while ((rt_ubase_t)d & WMASK)
+        {
+            *d++ = (rt_uint8_t)c;
+            count--;
+        }
+
+        word = (rt_uint8_t)c;
+        word |= word << 8;
+        word |= word << 16;
+        if (WSIZE > 4)
+            word |= word << (WBITS / 2);
+
+        wd = (rt_ubase_t *)d;
+        while (count >= WSIZE * 4)
+        {
+            wd[0] = word;
+            wd[1] = word;
+            wd[2] = word;
+            wd[3] = word;
+            wd += 4;
+            count -= WSIZE * 4;
+        }
+
+        while (count >= WSIZE)
+        {
+            *wd++ = word;
+            count -= WSIZE;
+        }
+        d = (rt_uint8_t *)wd;
+    }
+
+    while (count--)
+        *d++ = (rt_uint8_t)c;
+
+    return s;
+}
+
+/**
+ * This function will move memory content from source address to destination
+ * address.
+ *
+ * @param dest the address of destination memory
+ * @param src the address of source memory
+ * @param n the copied length
+ *
+ * @return the address of destination memory
+ */
+void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dest;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+
+    /* rt_memcpy reads each word before writing below it */
+    if (d <= s || d >= s + n)
+        return rt_memcpy(dest, src, n);
+
+    d += n;
+    s += n;
+
+    /* copy backward word by word when they can be aligned together */
+    if (n >= WSIZE * 2 && (((rt_ubase_t)d ^ (rt_ubase_t)s) & WMASK) == 0)
+    {
+        while ((rt_ubase_t)d & WMASK)
+        {
+            *(--d) = *(--s);
+            n--;
+        }
+
+        while (n >= WSIZE)
+        {
+            d -= WSIZE;
+            s -= WSIZE;
+            *(rt_ubase_t *)d = *(const rt_ubase_t *)s;
+            n -= WSIZE;
+        }
+    }
+
+    while (n--)
+        *(--d) = *(--s);
+
+    return dest;
+}
+
+/**
+ * This function will compare two areas of memory
+ *
+ * @param cs one area of memory
+ * @param ct another area of memory
+ * @param count the size of the area
+ *
+ * @return the result
+ */
+rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count)
+{
+    const rt_uint8_t *s1 = (const rt_uint8_t *)cs;
+    const rt_uint8_t *s2 = (const rt_uint8_t *)ct;
+    const rt_ubase_t *w2;
+    rt_ubase_t offset, shift, prev, next, w;
+
+    if (count >= WSIZE * 2)
+    {
+        while ((rt_ubase_t)s1 & WMASK)
+        {
+            if (*s1 != *s2)
+                return *s1 - *s2;
+            s1++;
+            s2++;
+            count--;
+        }
+
+        /* skip the equal words, the different word is compared bytewise */
+        offset = (rt_ubase_t)s2 & WMASK;
+        if (offset == 0)
+        {
+            while (count >= WSIZE && *(const rt_ubase_t *)s1 == *(const rt_ubase_t *)s2)
+            {
+                s1 += WSIZE;
+                s2 += WSIZE;
+                count -= WSIZE;
+            }
+        }
+        else
+        {
+            shift = offset * 8;
+            w2 = (const rt_ubase_t *)(s2 - offset);
+            prev = *w2++;
+            while (count >= WSIZE)
+            {
+                next = *w2++;
+                w = (prev >> shift) | (next << (WBITS - shift));
+                if (*(const rt_ubase_t *)s1 != w)
+                    break;
+                prev = next;
+                s1 += WSIZE;
+                s2 += WSIZE;
+                count -= WSIZE;
+            }
+        }
+    }
+
+    while (count--)
+    {
+        if (*s1 != *s2)
+            return *s1 - *s2;
+        s1++;
+        s2++;
+    }
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The simulator runs the kernel as a Linux process on x86-64 or i386 host
+ * without C library, so the kernel and the programs on it are built as for
+ * a target. There is no real interrupt, the board simulates the OS tick and
+ * calls rt_interrupt_enter/rt_interrupt_leave around it.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "cpuport.h"
+
+struct stack_frame
+{
+#if defined(__x86_64__)
+    rt_ubase_t r15;
+    rt_ubase_t r14;
+    rt_ubase_t r13;                 /* parameter */
+    rt_ubase_t r12;                 /* entry */
+    rt_ubase_t rbx;
+    rt_ubase_t rbp;
+#else
+    rt_ubase_t edi;                 /* exit */
+    rt_ubase_t esi;                 /* parameter */
+    rt_ubase_t ebx;                 /* entry */
+    rt_ubase_t ebp;
+#endif
+    rt_ubase_t pc;
+};
+
+#if defined(__x86_64__)
+#define SYS_WRITE           1
+#define SYS_MMAP            9
+#define SYS_MPROTECT        10
+#define SYS_CLOCK_GETTIME   228
+#define SYS_EXIT_GROUP      231
+#else
+#define SYS_WRITE           4
+#define SYS_MMAP            192     /* mmap2 */
+#define SYS_MPROTECT        125
+#define SYS_CLOCK_GETTIME   265
+#define SYS_EXIT_GROUP      252
+#endif
+
+#define SIM_PAGE_SIZE       4096
+#define SIM_PROT_NONE       0x0
+#define SIM_PROT_RW         0x3
+#define SIM_MAP_ANONYMOUS   0x22    /* MAP_PRIVATE | MAP_ANONYMOUS */
+#define SIM_CLOCK_MONOTONIC 1
+
+/* flag in interrupt handling */
+rt_ubase_t rt_interrupt_from_thread, rt_interrupt_to_thread;
+rt_uint32_t rt_thread_switch_interrupt_flag;
+/* the simulated interrupt mask, it is set until the first thread runs */
+static volatile rt_base_t sim_interrupt_mask = 1;
+
+extern volatile rt_uint8_t rt_interrupt_nest;
+extern void rt_hw_thread_start(void);
+
+/* a system call with up to 5 arguments, the 6th one is always 0 */
+static long _syscall(long number, long a1, long a2, long a3, long a4, long a5)
+{
+    long ret;
+
+#if defined(__x86_64__)
+    register long r10 __asm__("r10") = a4;
+    register long r8  __asm__("r8")  = a5;
+    register long r9  __asm__("r9")  = 0;
+
+    __asm__ volatile("syscall"
+                     : "=a"(ret)
+                     : "a"(number), "D"(a1), "S"(a2), "d"(a3), "r"(r10), "r"(r8), "r"(r9)
+                     : "rcx", "r11", "memory");
+#else
+    __asm__ volatile("push %%ebp\n\t"
+                     "xor %%ebp, %%ebp\n\t"
+                     "int $0x80\n\t"
+                     "pop %%ebp"
+                     : "=a"(ret)
+                     : "a"(number), "b"(a1), "c"(a2), "d"(a3), "S"(a4), "D"(a5)
+                     : "memory");
+#endif
+
+    return ret;
+}
+
+/**
+ * This function will initialize thread stack
+ *
+ * @param tentry the entry of thread
+ * @param parameter the parameter of entry
+ * @param stack_addr the beginning stack address
+ * @param texit the function will be called when thread exit
+ *
+ * @return stack address
+ */
+rt_uint8_t *rt_hw_stack_init(void       *tentry,
+                             void       *parameter,
+                             rt_uint8_t *stack_addr,
+                             void       *texit)
+{
+    struct stack_frame *stack_frame;
+    rt_uint8_t         *stk;
+
+    /* the stack is 16 bytes aligned when the thread start returns to its entry */
+    stk  = stack_addr + sizeof(rt_ubase_t);
+    stk  = (rt_uint8_t *)RT_ALIGN_DOWN((rt_ubase_t)stk, 16);
+    stk -= sizeof(struct stack_frame);
+
+    stack_frame = (struct stack_frame *)stk;
+    rt_memset(stack_frame, 0, sizeof(struct stack_frame));
+
+#if defined(__x86_64__)
+    stack_frame->r12 = (rt_ubase_t)tentry;
+    stack_frame->r13 = (rt_ubase_t)parameter;
+    stack_frame->r14 = (rt_ubase_t)texit;
+#else
+    stack_frame->ebx = (rt_ubase_t)tentry;
+    stack_frame->esi = (rt_ubase_t)parameter;
+    stack_frame->edi = (rt_ubase_t)texit;
+#endif
+    stack_frame->pc = (rt_ubase_t)rt_hw_thread_start;
+
+    /* return task's current stack address */
+    return stk;
+}
+
+/* the C part of rt_hw_thread_start, a thread starts with interrupt enabled */
+void rt_hw_thread_entry(void (*tentry)(void *), void *parameter, void (*texit)(void))
+{
+    rt_hw_interrupt_enable(0);
+
+    tentry(parameter);
+    texit();
+}
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    rt_base_t level;
+
+    level = sim_interrupt_mask;
+    sim_interrupt_mask = 1;
+
+    return level;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    sim_interrupt_mask = level;
+
+    /*
+     * a switch requested in interrupt is done once the interrupt returns and
+     * the mask is cleared, as PendSV does on Cortex-M.
+     */
+    if (level == 0 && rt_thread_switch_interrupt_flag && rt_interrupt_nest == 0)
+    {
+        sim_interrupt_mask = 1;
+        rt_thread_switch_interrupt_flag = 0;
+        rt_hw_context_switch(rt_interrupt_from_thread, rt_interrupt_to_thread);
+        sim_interrupt_mask = 0;
+    }
+}
+
+void rt_hw_context_switch_interrupt(rt_ubase_t from, rt_ubase_t to)
+{
+    if (rt_thread_switch_interrupt_flag == 0)
+    {
+        rt_thread_switch_interrupt_flag = 1;
+        rt_interrupt_from_thread = from;
+    }
+
+    rt_interrupt_to_thread = to;
+}
+
+void rt_hw_console_output(const char *str)
+{
+    _syscall(SYS_WRITE, 1, (long)str, (long)rt_strlen(str), 0, 0);
+}
+
+/*
+ * the timestamp is the time stamp counter of host, as a cycle counter on
+ * target. A test may replace it with a clock of its own.
+ */
+RT_WEAK rt_uint32_t rt_hw_timestamp_get(void)
+{
+    rt_uint32_t low;
+
+    __asm__ volatile ("rdtsc" : "=a" (low) : : "edx");
+
+    return low;
+}
+
+/* the frequency of time stamp counter is measured once against host time */
+rt_uint32_t rt_hw_timestamp_freq(void)
+{
+    static rt_uint32_t freq;
+    rt_uint64_t start, now;
+    rt_uint32_t stamp;
+
+    if (freq == 0)
+    {
+        start = sim_time_ns();
+        stamp = rt_hw_timestamp_get();
+        do
+        {
+            now = sim_time_ns();
+        }
+        while (now - start < 10000000);
+        stamp = rt_hw_timestamp_get() - stamp;
+
+        freq = (rt_uint32_t)((rt_uint64_t)stamp * 1000000000 / (now - start));
+    }
+
+    return freq;
+}
+
+void rt_hw_cpu_shutdown(void)
+{
+    sim_exit(0);
+}
+
+/**
+ * This function will terminate the simulator.
+ *
+ * @param status the exit status of process
+ */
+void sim_exit(int status)
+{
+    for (;;)
+        _syscall(SYS_EXIT_GROUP, status, 0, 0, 0, 0);
+}
+
+/**
+ * This function will return the monotonic time of host.
+ *
+ * @return the time in nanoseconds
+ */
+rt_uint64_t sim_time_ns(void)
+{
+    long ts[2];
+
+    _syscall(SYS_CLOCK_GETTIME, SIM_CLOCK_MONOTONIC, (long)ts, 0, 0, 0);
+
+    return (rt_uint64_t)ts[0] * 1000000000 + (rt_uint64_t)ts[1];
+}
+
+/**
+ * This function will allocate memory which ends right before an inaccessible
+ * page, any access past the end of it faults.
+ *
+ * @param size the size of memory
+ *
+ * @return the memory, RT_NULL on failure
+ */
+void *sim_guard_alloc(rt_size_t size)
+{
+    long page;
+    rt_size_t length;
+
+    length = RT_ALIGN(size, SIM_PAGE_SIZE);
+    page = _syscall(SYS_MMAP, 0, (long)(length + SIM_PAGE_SIZE), SIM_PROT_RW,
+                    SIM_MAP_ANONYMOUS, -1);
+    if ((unsigned long)page > (unsigned long)-SIM_PAGE_SIZE)
+        return RT_NULL;
+
+    _syscall(SYS_MPROTECT, page + (long)length, SIM_PAGE_SIZE, SIM_PROT_NONE, 0, 0);
+
+    return (rt_uint8_t *)page + length - size;
+}
+
+/*
+ * The compiler may emit calls of the C library memory functions for the
+ * structure copy and initialization.
+ */
+void *memcpy(void *dst, const void *src, rt_size_t count)
+{
+    return rt_memcpy(dst, src, count);
+}
+
+void *memmove(void *dst, const void *src, rt_size_t count)
+{
+    return rt_memmove(dst, src, count);
+}
+
+void *memset(void *s, int c, rt_size_t count)
+{
+    return rt_memset(s, c, count);
+}
+
+int memcmp(const void *cs, const void *ct, rt_size_t count)
+{
+    return rt_memcmp(cs, ct, count);
+}
+
+#if defined(__i386__)
+/* the 64 bits division of libgcc, there is no 32 bits libgcc on the host */
+static rt_uint64_t _udivmod64(rt_uint64_t n, rt_uint64_t d, rt_uint64_t *rem)
+{
+    rt_uint64_t q = 0, bit = 1;
+
+    if (d == 0)
+        sim_exit(-1);
+
+    while (d < n && !(d & (1ULL << 63)))
+    {
+        d <<= 1;
+        bit <<= 1;
+    }
+
+    while (bit)
+    {
+        if (n >= d)
+        {
+            n -= d;
+            q |= bit;
+        }
+        d >>= 1;
+        bit >>= 1;
+    }
+
+    if (rem)
+        *rem = n;
+
+    return q;
+}
+
+rt_uint64_t __udivdi3(rt_uint64_t n, rt_uint64_t d)
+{
+    return _udivmod64(n, d, RT_NULL);
+}
+
+rt_uint64_t __umoddi3(rt_uint64_t n, rt_uint64_t d)
+{
+    rt_uint64_t rem;
+
+    _udivmod64(n, d, &rem);
+
+    return rem;
+}
+
+rt_uint64_t __udivmoddi4(rt_uint64_t n, rt_uint64_t d, rt_uint64_t *rem)
+{
+    return _udivmod64(n, d, rem);
+}
+
+rt_int64_t __divdi3(rt_int64_t n, rt_int64_t d)
+{
+    rt_uint64_t q;
+
+    q = _udivmod64(n < 0 ? -(rt_uint64_t)n : (rt_uint64_t)n,
+                   d < 0 ? -(rt_uint64_t)d : (rt_uint64_t)d, RT_NULL);
+
+    return (n < 0) != (d < 0) ? -(rt_int64_t)q : (rt_int64_t)q;
+}
+
+rt_int64_t __moddi3(rt_int64_t n, rt_int64_t d)
+{
+    rt_uint64_t rem;
+
+    _udivmod64(n < 0 ? -(rt_uint64_t)n : (rt_uint64_t)n,
+               d < 0 ? -(rt_uint64_t)d : (rt_uint64_t)d, &rem);
+
+    return n < 0 ? -(rt_int64_t)rem : (rt_int64_t)rem;
+}
+#endif
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#ifndef CPUPORT_H__
+#define CPUPORT_H__
+
+#include <rtthread.h>
+
+/* the host services of simulator, for the board and the test programs */
+void sim_exit(int status);
+rt_uint64_t sim_time_ns(void);
+void *sim_guard_alloc(rt_size_t size);
+
+#endif
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Memory routines for the simulator on host, they override the weak versions
+ * of kservice.c. The memory is moved by 16 bytes vectors of the GCC/Clang
+ * vector extension, unrolled to 64 bytes, which the compiler maps to the
+ * SIMD registers of host (SSE2, NEON ...).
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_CPU_MEMFUNC) && defined(__GNUC__)
+
+/* the vectors may be at any address, and alias any type */
+typedef rt_uint8_t  vec_u8  __attribute__((vector_size(16), aligned(1), may_alias));
+typedef rt_uint64_t vec_u64 __attribute__((vector_size(16), aligned(1), may_alias));
+
+#define VEC(p)          (*(vec_u8 *)(p))
+#define CVEC(p)         (*(const vec_u8 *)(p))
+
+/**
+ * This function will copy memory content from source address to destination
+ * address.
+ *
+ * @param dst the address of destination memory
+ * @param src the address of source memory
+ * @param count the copied length
+ *
+ * @return the address of destination memory
+ */
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dst;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    vec_u8 v0, v1, v2, v3;
+
+    while (count >= 64)
+    {
+        v0 = CVEC(s);
+        v1 = CVEC(s + 16);
+        v2 = CVEC(s + 32);
+        v3 = CVEC(s + 48);
+        VEC(d) = v0;
+        VEC(d + 16) = v1;
+        VEC(d + 32) = v2;
+        VEC(d + 48) = v3;
+        d += 64;
+        s += 64;
+        count -= 64;
+    }
+
+    while (count >= 16)
+    {
+        VEC(d) = CVEC(s);
+        d += 16;
+        s += 16;
+        count -= 16;
+    }
+
+    while (count--)
+        *d++ = *s++;
+
+    return dst;
+}
+
+/**
+ * This function will set the content of memory to specified value
+ *
+ * @param s the address of source memory
+ * @param c the value shall be set in content
+ * @param count the copied length
+ *
+ * @return the address of source memory
+ */
+void *rt_memset(void *s, int c, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)s;
+    vec_u8 v;
+
+    v = (vec_u8){0} + (rt_uint8_t)c;
+
+    while (count >= 64)
+    {
+        VEC(d) = v;
+        VEC(d + 16) = v;
+        VEC(d + 32) = v;
+        VEC(d + 48) = v;
+        d += 64;
+        count -= 64;
+    }
+
+    while (count >= 16)
+    {
+        VEC(d) = v;
+        d += 16;
+        count -= 16;
+    }
+
+    while (count--)
+        *d++ = (rt_uint8_t)c;
+
+    return s;
+}
+
+/**
+ * This function will move memory content from source address to destination
+ * address.
+ *
+ * @param dest the address of destination memory
+ * @param src the address of source memory
+ * @param n the copied length
+ *
+ * @return the address of destination memory
+ */
+void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dest;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    vec_u8 v0, v1, v2, v3;
+
+    /* rt_memcpy reads each block before writing below it */
+    if (d <= s || d >= s + n)
+        return rt_memcpy(dest, src, n);
+
+    d += n;
+    s += n;
+
+    while (n >= 64)
+    {
+        d -= 64;
+        s -= 64;
+        v0 = CVEC(s);
+        v1 = CVEC(s + 16);
+        v2 = CVEC(s + 32);
+        v3 = CVEC(s + 48);
+        VEC(d) = v0;
+        VEC(d + 16) = v1;
+        VEC(d + 32) = v2;
+        VEC(d + 48) = v3;
+        n -= 64;
+    }
+
+    while (n >= 16)
+    {
+        d -= 16;
+        s -= 16;
+        VEC(d) = CVEC(s);
+        n -= 16;
+    }
+
+    while (n--)
+        *(--d) = *(--s);
+
+    return dest;
+}
+
+/**
+ * This function will compare two areas of memory
+ *
+ * @param cs one area of memory
+ * @param ct another area of memory
+ * @param count the size of the area
+ *
+ * @return the result
+ */
+rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count)
+{
+    const rt_uint8_t *s1 = (const rt_uint8_t *)cs;
+    const rt_uint8_t *s2 = (const rt_uint8_t *)ct;
+    vec_u64 diff;
+
+    /* skip the equal blocks, the different block is compared bytewise */
+    while (count >= 16)
+    {
+        diff = (vec_u64)(CVEC(s1) ^ CVEC(s2));
+        if ((diff[0] | diff[1]) != 0)
+            break;
+        s1 += 16;
+        s2 += 16;
+        count -= 16;
+    }
+
+    while (count--)
+    {
+        if (*s1 != *s2)
+            return *s1 - *s2;
+        s1++;
+        s2++;
+    }
+
+    return 0;
+}
+
+#endif
@@ -48,6 +48,30 @@ rt_tick_t rt_tick_get(void)
     return rt_tick;
 }
 
+/**
+ * This function will return a free-running timestamp used by the kernel
+ * measurement facilities. The default implementation returns the OS tick;
+ * a BSP should override it with a fine grained cycle counter (e.g. DWT
+ * CYCCNT on Cortex-M) to get a useful resolution.
+ *
+ * @return current timestamp
+ */
+RT_WEAK rt_uint32_t rt_hw_timestamp_get(void)
+{
+    return rt_tick;
+}
+
+/**
+ * This function will return the frequency of the timestamp returned by
+ * rt_hw_timestamp_get, it shall be overridden together with it.
+ *
+ * @return the timestamp counts per second
+ */
+RT_WEAK rt_uint32_t rt_hw_timestamp_freq(void)
+{
+    return RT_TICK_PER_SECOND;
+}
+
 /**
  * This function will set current tick
  */
@@ -45,6 +45,10 @@
  *
  * rti_end           --> 6.end
  *
+ * DEFERRED_EXPORT   --> 7
+ *
+ * rti_deferred_end  --> 7.end
+ *
  * These automatically initialization, the driver or component initial function must
  * be defined with:
  * INIT_BOARD_EXPORT(fn);
@@ -52,6 +56,10 @@
  * ...
  * INIT_APP_EXPORT(fn);
  * etc.
+ *
+ * The INIT_DEFERRED_EXPORT(fn) functions are not critical for the startup, they
+ * are run by a low priority thread after main starts when RT_USING_DEFERRED_INIT
+ * is enabled, otherwise right after the other components.
  */
 static int rti_start(void)
 {
@@ -77,28 +85,181 @@ static int rti_end(void)
 }
 INIT_EXPORT(rti_end, "6.end");
 
-/**
- * RT-Thread Components Initialization for board
- */
-void rt_components_board_init(void)
+static int rti_deferred_end(void)
+{
+    return 0;
+}
+INIT_EXPORT(rti_deferred_end, "7.end");
+
+#ifdef RT_USING_DEFERRED_INIT
+#ifndef RT_DEFERRED_INIT_STACK_SIZE
+#define RT_DEFERRED_INIT_STACK_SIZE     2048
+#endif
+#ifndef RT_DEFERRED_INIT_PRIORITY
+#define RT_DEFERRED_INIT_PRIORITY       (RT_THREAD_PRIORITY_MAX - 2)
+#endif
+#endif
+
+#define RTI_STAGE_BOARD     0
+#define RTI_STAGE_COMPONENT 1
+#define RTI_STAGE_DEFERRED  2
+
+#ifdef RT_USING_BOOT_PROFILE
+#ifndef RT_BOOT_PROFILE_ENTRIES
+#define RT_BOOT_PROFILE_ENTRIES         64
+#endif
+
+struct rti_profile
+{
+    const char *name;
+    rt_uint32_t cycles;                                 /**< timestamp units */
+    rt_tick_t ticks;
+    rt_int16_t result;
+    rt_uint8_t stage;
+};
+
+static struct rti_profile rti_profile_table[RT_BOOT_PROFILE_ENTRIES];
+static rt_uint16_t rti_profile_count;
+static rt_uint16_t rti_profile_lost;
+static rt_tick_t rti_main_tick;                         /**< tick when main starts */
+static rt_tick_t rti_deferred_tick;                     /**< tick when the deferred ones are done */
+static rt_bool_t rti_deferred_over;
+
+static void rti_profile_record(const char *name, rt_uint8_t stage,
+                               rt_uint32_t cycles, rt_tick_t ticks, int result)
+{
+    struct rti_profile *profile;
+    rt_base_t level;
+
+    /* the deferred thread records while the shell may be reading */
+    level = rt_hw_interrupt_disable();
+    if (rti_profile_count < RT_BOOT_PROFILE_ENTRIES)
+    {
+        profile = &rti_profile_table[rti_profile_count];
+        profile->name = name;
+        profile->cycles = cycles;
+        profile->ticks = ticks;
+        profile->result = (rt_int16_t)result;
+        profile->stage = stage;
+        rti_profile_count ++;
+    }
+    else
+    {
+        rti_profile_lost ++;
+    }
+    rt_hw_interrupt_enable(level);
+}
+#endif /* RT_USING_BOOT_PROFILE */
+
+/* the markers are empty, so a range starts after its marker */
+#if RT_DEBUG_INIT || defined(RT_USING_BOOT_PROFILE)
+#define RTI_ENTRY(fn)       (&__rt_init_desc_##fn)
+
+static void rti_call(const struct rt_init_desc *desc,
+                     const struct rt_init_desc *end, rt_uint8_t stage)
 {
-#if RT_DEBUG_INIT
     int result;
-    const struct rt_init_desc *desc;
-    for (desc = &__rt_init_desc_rti_board_start; desc < &__rt_init_desc_rti_board_end; desc ++)
+#ifdef RT_USING_BOOT_PROFILE
+    rt_uint32_t stamp;
+    rt_tick_t tick;
+#endif
+
+    for (; desc < end; desc ++)
     {
+#if RT_DEBUG_INIT
         rt_kprintf("initialize %s", desc->fn_name);
+#endif
+#ifdef RT_USING_BOOT_PROFILE
+        tick = rt_tick_get();
+        stamp = rt_hw_timestamp_get();
         result = desc->fn();
+        stamp = rt_hw_timestamp_get() - stamp;
+        tick = rt_tick_get() - tick;
+        rti_profile_record(desc->fn_name, stage, stamp, tick, result);
+#else
+        result = desc->fn();
+#endif
+#if RT_DEBUG_INIT
         rt_kprintf(":%d done\n", result);
+#endif
     }
+
+    (void)stage;
+}
 #else
-    volatile const init_fn_t *fn_ptr;
+#define RTI_ENTRY(fn)       (&__rt_init_##fn)
 
-    for (fn_ptr = &__rt_init_rti_board_start; fn_ptr < &__rt_init_rti_board_end; fn_ptr++)
+static void rti_call(volatile const init_fn_t *fn_ptr,
+                     volatile const init_fn_t *end, rt_uint8_t stage)
+{
+    for (; fn_ptr < end; fn_ptr ++)
     {
         (*fn_ptr)();
     }
+
+    (void)stage;
+}
+#endif
+
+static void rti_deferred_done(void)
+{
+#ifdef RT_USING_BOOT_PROFILE
+    rti_deferred_tick = rt_tick_get();
+    rti_deferred_over = RT_TRUE;
+#endif
+}
+
+#ifdef RT_USING_DEFERRED_INIT
+static void rti_deferred_entry(void *parameter)
+{
+    rti_call(RTI_ENTRY(rti_end) + 1, RTI_ENTRY(rti_deferred_end), RTI_STAGE_DEFERRED);
+    rti_deferred_done();
+}
+
+#ifndef RT_USING_HEAP
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t rti_deferred_stack[RT_DEFERRED_INIT_STACK_SIZE];
+static struct rt_thread rti_deferred_thread;
+#endif
+#endif /* RT_USING_DEFERRED_INIT */
+
+/*
+ * This function starts the deferred initialization. The thread has a lower
+ * priority than main, so it runs once main blocks.
+ */
+static void rti_deferred_start(void)
+{
+#ifdef RT_USING_DEFERRED_INIT
+    rt_thread_t tid;
+
+#ifdef RT_USING_HEAP
+    tid = rt_thread_create("dinit", rti_deferred_entry, RT_NULL,
+                           RT_DEFERRED_INIT_STACK_SIZE, RT_DEFERRED_INIT_PRIORITY, 20);
+#else
+    tid = &rti_deferred_thread;
+    if (rt_thread_init(tid, "dinit", rti_deferred_entry, RT_NULL,
+                       rti_deferred_stack, sizeof(rti_deferred_stack),
+                       RT_DEFERRED_INIT_PRIORITY, 20) != RT_EOK)
+        tid = RT_NULL;
+#endif
+    if (tid != RT_NULL)
+    {
+        rt_thread_startup(tid);
+        return;
+    }
 #endif
+
+    /* no deferred thread, run them right now */
+    rti_call(RTI_ENTRY(rti_end) + 1, RTI_ENTRY(rti_deferred_end), RTI_STAGE_DEFERRED);
+    rti_deferred_done();
+}
+
+/**
+ * RT-Thread Components Initialization for board
+ */
+void rt_components_board_init(void)
+{
+    rti_call(RTI_ENTRY(rti_board_start) + 1, RTI_ENTRY(rti_board_end), RTI_STAGE_BOARD);
 }
 
 /**
@@ -107,25 +268,58 @@ void rt_components_board_init(void)
 void rt_components_init(void)
 {
 #if RT_DEBUG_INIT
-    int result;
-    const struct rt_init_desc *desc;
-
     rt_kprintf("do components initialization.\n");
-    for (desc = &__rt_init_desc_rti_board_end; desc < &__rt_init_desc_rti_end; desc ++)
+#endif
+    rti_call(RTI_ENTRY(rti_board_end) + 1, RTI_ENTRY(rti_end), RTI_STAGE_COMPONENT);
+
+#ifdef RT_USING_BOOT_PROFILE
+    rti_main_tick = rt_tick_get();
+#endif
+    rti_deferred_start();
+}
+
+#if defined(RT_USING_BOOT_PROFILE) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+static long bootprof(int argc, char **argv)
+{
+    static const char *const stage_name[] = {"board", "comp", "defer"};
+    struct rti_profile *profile;
+    rt_uint32_t freq, index, us;
+    rt_uint32_t total_cycles[3] = {0};
+
+    freq = rt_hw_timestamp_freq();
+
+    rt_kprintf("stage function                  ticks     cycles         us result\n");
+    rt_kprintf("----- ------------------------ ------ ---------- ---------- ------\n");
+    for (index = 0; index < rti_profile_count; index ++)
     {
-        rt_kprintf("initialize %s", desc->fn_name);
-        result = desc->fn();
-        rt_kprintf(":%d done\n", result);
+        profile = &rti_profile_table[index];
+        us = freq ? (rt_uint32_t)((rt_uint64_t)profile->cycles * 1000000 / freq) : 0;
+        total_cycles[profile->stage] += profile->cycles;
+
+        rt_kprintf("%-5s %-24.24s %6d %10u %10u %6d\n", stage_name[profile->stage],
+                   profile->name, profile->ticks, profile->cycles, us, profile->result);
     }
-#else
-    volatile const init_fn_t *fn_ptr;
 
-    for (fn_ptr = &__rt_init_rti_board_end; fn_ptr < &__rt_init_rti_end; fn_ptr ++)
+    for (index = 0; index < 3; index ++)
     {
-        (*fn_ptr)();
+        us = freq ? (rt_uint32_t)((rt_uint64_t)total_cycles[index] * 1000000 / freq) : 0;
+        rt_kprintf("%-5s total %36u %10u\n", stage_name[index], total_cycles[index], us);
     }
-#endif
+    rt_kprintf("main started at tick %d, ", rti_main_tick);
+    if (rti_deferred_over)
+        rt_kprintf("deferred done at tick %d\n", rti_deferred_tick);
+    else
+        rt_kprintf("deferred still running\n");
+    if (rti_profile_lost)
+        rt_kprintf("%d functions not recorded, RT_BOOT_PROFILE_ENTRIES is too small\n",
+                   rti_profile_lost);
+
+    return 0;
 }
+MSH_CMD_EXPORT(bootprof, show the time of each initialization function);
+#endif
 #endif   /* RT_USING_COMPONENTS_INIT */
 
 #ifdef RT_USING_USER_MAIN
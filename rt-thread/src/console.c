@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The asynchronous console: rt_kprintf and rt_kputs copy the output to a
+ * ring buffer, which is written out by a low priority thread.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined(RT_USING_CONSOLE_ASYNC) && !defined(RT_USING_CONSOLE)
+#error "RT_USING_CONSOLE_ASYNC requires RT_USING_CONSOLE"
+#endif
+
+#if defined(RT_USING_CONSOLE) && defined(RT_USING_CONSOLE_ASYNC)
+
+/**
+ * @addtogroup KernelService
+ */
+
+/**@{*/
+
+/* the size of asynchronous console buffer, must be power of 2 */
+#ifndef RT_CONSOLE_ASYNC_BUF_SIZE
+#define RT_CONSOLE_ASYNC_BUF_SIZE           2048
+#endif
+
+#ifndef RT_CONSOLE_ASYNC_THREAD_PRIORITY
+#define RT_CONSOLE_ASYNC_THREAD_PRIORITY    (RT_THREAD_PRIORITY_MAX - 2)
+#endif
+
+#ifndef RT_CONSOLE_ASYNC_THREAD_STACK_SIZE
+#define RT_CONSOLE_ASYNC_THREAD_STACK_SIZE  512
+#endif
+
+#if (RT_CONSOLE_ASYNC_BUF_SIZE & (RT_CONSOLE_ASYNC_BUF_SIZE - 1)) != 0
+#error "RT_CONSOLE_ASYNC_BUF_SIZE must be power of 2"
+#endif
+
+#define CONSOLE_ASYNC_MASK                  (RT_CONSOLE_ASYNC_BUF_SIZE - 1)
+
+/*
+ * The output of console is copied into a ring buffer and written out by a
+ * low priority thread in batches. The writer never waits: the output which
+ * does not fit is dropped and counted. The indexes are free running and
+ * only masked when the buffer is accessed.
+ *
+ * rt_kprintf formats right into the ring, the output past the end of ring
+ * goes to the spare bytes behind it and is moved to the start of ring.
+ */
+static char _console_ring[RT_CONSOLE_ASYNC_BUF_SIZE + RT_CONSOLEBUF_SIZE];
+static rt_uint32_t _console_write_index;
+static rt_uint32_t _console_read_index;
+static rt_uint32_t _console_pending_max;
+static rt_uint32_t _console_dropped;
+static rt_uint32_t _console_dropped_bytes;
+/* the output is asynchronous once the flusher is started, until a panic flush */
+static volatile rt_uint8_t _console_async;
+static volatile rt_uint8_t _console_flusher_idle;
+
+static struct rt_semaphore _console_sem;
+static struct rt_thread _console_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _console_thread_stack[RT_CONSOLE_ASYNC_THREAD_STACK_SIZE];
+
+/* copy the output to ring buffer, return RT_FALSE if the console is synchronous */
+rt_bool_t rt_console_async_puts(const char *str, rt_size_t length)
+{
+    rt_base_t level;
+    rt_uint32_t index, first, pending;
+    rt_uint8_t wakeup;
+
+    if (!_console_async)
+        return RT_FALSE;
+
+    level = rt_hw_interrupt_disable();
+    pending = _console_write_index - _console_read_index;
+    if (length > RT_CONSOLE_ASYNC_BUF_SIZE - pending)
+    {
+        _console_dropped ++;
+        _console_dropped_bytes += length;
+        rt_hw_interrupt_enable(level);
+        return RT_TRUE;
+    }
+
+    index = _console_write_index & CONSOLE_ASYNC_MASK;
+    first = RT_CONSOLE_ASYNC_BUF_SIZE - index;
+    if (first > length)
+        first = length;
+    rt_memcpy(&_console_ring[index], str, first);
+    rt_memcpy(&_console_ring[0], str + first, length - first);
+    _console_write_index += length;
+
+    pending += length;
+    if (pending > _console_pending_max)
+        _console_pending_max = pending;
+
+    wakeup = _console_flusher_idle;
+    _console_flusher_idle = 0;
+    rt_hw_interrupt_enable(level);
+
+    if (wakeup)
+        rt_sem_release(&_console_sem);
+
+    return RT_TRUE;
+}
+
+/*
+ * format the output into ring buffer, return RT_FALSE if the console is
+ * synchronous. There is no buffer on the stack of caller, which may be an
+ * interrupt or the idle thread, the output is formatted with interrupt
+ * disabled instead.
+ */
+rt_bool_t rt_console_async_vprintf(const char *fmt, va_list args)
+{
+    rt_base_t level;
+    rt_uint32_t index, pending, size, length;
+    rt_uint8_t wakeup;
+
+    if (!_console_async)
+        return RT_FALSE;
+
+    level = rt_hw_interrupt_disable();
+    pending = _console_write_index - _console_read_index;
+    index = _console_write_index & CONSOLE_ASYNC_MASK;
+
+    /* only the free bytes are written, the terminating null byte included */
+    size = RT_CONSOLE_ASYNC_BUF_SIZE - pending;
+    if (size > RT_CONSOLEBUF_SIZE)
+        size = RT_CONSOLEBUF_SIZE;
+    length = rt_vsnprintf(&_console_ring[index], size, fmt, args);
+    if (length >= size)
+    {
+        if (size < RT_CONSOLEBUF_SIZE)
+        {
+            _console_dropped ++;
+            _console_dropped_bytes += length;
+            rt_hw_interrupt_enable(level);
+            return RT_TRUE;
+        }
+
+        /* the long output is cut, as the synchronous one */
+        length = RT_CONSOLEBUF_SIZE - 1;
+    }
+
+    if (index + length > RT_CONSOLE_ASYNC_BUF_SIZE)
+    {
+        rt_memcpy(&_console_ring[0], &_console_ring[RT_CONSOLE_ASYNC_BUF_SIZE],
+                  index + length - RT_CONSOLE_ASYNC_BUF_SIZE);
+    }
+    _console_write_index += length;
+
+    pending += length;
+    if (pending > _console_pending_max)
+        _console_pending_max = pending;
+
+    wakeup = _console_flusher_idle;
+    _console_flusher_idle = 0;
+    rt_hw_interrupt_enable(level);
+
+    if (wakeup)
+        rt_sem_release(&_console_sem);
+
+    return RT_TRUE;
+}
+
+/* write a piece of output to the console device, or to the low level output */
+static void _console_output(const char *str, rt_size_t length)
+{
+    static char batch[RT_CONSOLEBUF_SIZE];
+#ifdef RT_USING_DEVICE
+    rt_device_t device = rt_console_get_device();
+
+    if (device != RT_NULL)
+    {
+        rt_uint16_t old_flag = device->open_flag;
+
+        device->open_flag |= RT_DEVICE_FLAG_STREAM;
+        rt_device_write(device, 0, str, length);
+        device->open_flag = old_flag;
+        return;
+    }
+#endif
+
+    /* rt_hw_console_output takes a string */
+    while (length > 0)
+    {
+        rt_size_t size = length;
+
+        if (size > sizeof(batch) - 1)
+            size = sizeof(batch) - 1;
+        rt_memcpy(batch, str, size);
+        batch[size] = '\0';
+        rt_hw_console_output(batch);
+
+        str += size;
+        length -= size;
+    }
+}
+
+/* write out the output in ring buffer, in contiguous pieces as large as possible */
+static void _console_drain(void)
+{
+    rt_uint32_t index, length;
+
+    while (_console_read_index != _console_write_index)
+    {
+        index  = _console_read_index & CONSOLE_ASYNC_MASK;
+        length = _console_write_index - _console_read_index;
+        if (length > RT_CONSOLE_ASYNC_BUF_SIZE - index)
+            length = RT_CONSOLE_ASYNC_BUF_SIZE - index;
+
+        _console_output(&_console_ring[index], length);
+
+        /* the space is given back to writers after it is written out */
+        _console_read_index += length;
+    }
+}
+
+static void _console_flusher_entry(void *parameter)
+{
+    rt_base_t level;
+    rt_uint32_t dropped = 0;
+    char note[48];
+    rt_size_t length;
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        if (_console_read_index == _console_write_index)
+        {
+            _console_flusher_idle = 1;
+            rt_hw_interrupt_enable(level);
+
+            rt_sem_take(&_console_sem, RT_WAITING_FOREVER);
+            continue;
+        }
+        rt_hw_interrupt_enable(level);
+
+        _console_drain();
+
+        if (_console_dropped != dropped)
+        {
+            length = rt_snprintf(note, sizeof(note), "\n[console: %d messages dropped]\n",
+                                 _console_dropped - dropped);
+            dropped = _console_dropped;
+            _console_output(note, length);
+        }
+    }
+}
+
+/**
+ * This function will start the asynchronous console. After that, rt_kprintf
+ * and rt_kputs copy the output to a ring buffer, which is written out by a
+ * low priority thread.
+ *
+ * @return RT_EOK
+ */
+int rt_console_async_init(void)
+{
+    if (_console_async)
+        return RT_EOK;
+
+    rt_sem_init(&_console_sem, "console", 0, RT_IPC_FLAG_FIFO);
+    rt_thread_init(&_console_thread,
+                   "console",
+                   _console_flusher_entry,
+                   RT_NULL,
+                   &_console_thread_stack[0],
+                   sizeof(_console_thread_stack),
+                   RT_CONSOLE_ASYNC_THREAD_PRIORITY,
+                   10);
+    rt_thread_startup(&_console_thread);
+
+    _console_async = 1;
+
+    return RT_EOK;
+}
+INIT_PREV_EXPORT(rt_console_async_init);
+
+/**
+ * This function will write out the pending output of asynchronous console
+ * from current context, and make the console synchronous from then on. It is
+ * for the assertion, fault and reboot paths, which can not rely on the
+ * flusher thread any more.
+ */
+void rt_console_flush(void)
+{
+    _console_async = 0;
+    _console_drain();
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static long console_stat(void)
+{
+    rt_kprintf("buffer size: %d\n", RT_CONSOLE_ASYNC_BUF_SIZE);
+    rt_kprintf("pending    : %d\n", _console_write_index - _console_read_index);
+    rt_kprintf("max pending: %d\n", _console_pending_max);
+    rt_kprintf("dropped    : %d messages, %d bytes\n", _console_dropped, _console_dropped_bytes);
+
+    return 0;
+}
+MSH_CMD_EXPORT(console_stat, show asynchronous console statistics);
+#endif
+
+/**@}*/
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The registry of log tags: the tags of rtdbg.h register themselves at their
+ * first log, so the log level of a tag can be changed at runtime.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_DBG_TAG_LEVEL
+
+/**
+ * @addtogroup KernelService
+ */
+
+/**@{*/
+
+/* the first unit of each registered log tag */
+static struct rt_dbg_tag *_dbg_tags[RT_DBG_TAG_MAX];
+
+static void _dbg_tag_register(struct rt_dbg_tag *tag)
+{
+    rt_base_t level;
+    int index;
+
+    level = rt_hw_interrupt_disable();
+    if (tag->level == RT_DBG_TAG_UNREGISTERED)
+    {
+        for (index = 0; index < RT_DBG_TAG_MAX && _dbg_tags[index] != RT_NULL; index ++)
+        {
+            if (rt_strcmp(_dbg_tags[index]->name, tag->name) == 0)
+                break;
+        }
+
+        if (index < RT_DBG_TAG_MAX && _dbg_tags[index] != RT_NULL)
+        {
+            /* join the units of the same tag */
+            tag->next = _dbg_tags[index]->next;
+            _dbg_tags[index]->next = tag;
+            tag->level = _dbg_tags[index]->level;
+        }
+        else
+        {
+            /* the tag keeps its initial level if the table is full */
+            if (index < RT_DBG_TAG_MAX)
+                _dbg_tags[index] = tag;
+            tag->level = tag->init_level;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will check whether a log of the level is enabled for a tag,
+ * it registers the tag at the first log of the tag. It is invoked by LOG_X
+ * macros of rtdbg.h.
+ *
+ * @param tag the log tag of the translation unit
+ * @param level the level of log
+ *
+ * @return RT_TRUE if the log is enabled, otherwise RT_FALSE
+ */
+rt_bool_t rt_dbg_tag_check(struct rt_dbg_tag *tag, int level)
+{
+    if (rt_unlikely(tag->level == RT_DBG_TAG_UNREGISTERED))
+        _dbg_tag_register(tag);
+
+    return tag->level >= level;
+}
+
+/**
+ * This function will set the log level of a registered tag.
+ *
+ * @param name the name of tag
+ * @param level the level, from 0 (error) to 3 (debug)
+ *
+ * @return RT_EOK on successful, -RT_EINVAL on a bad level, -RT_ERROR if the
+ *         tag has not been registered by a log
+ */
+rt_err_t rt_dbg_tag_set_level(const char *name, int level)
+{
+    struct rt_dbg_tag *tag;
+    int index;
+
+    RT_ASSERT(name != RT_NULL);
+
+    if (level < 0 || level > 3)
+        return -RT_EINVAL;
+
+    for (index = 0; index < RT_DBG_TAG_MAX && _dbg_tags[index] != RT_NULL; index ++)
+    {
+        if (rt_strcmp(_dbg_tags[index]->name, name) == 0)
+        {
+            for (tag = _dbg_tags[index]; tag != RT_NULL; tag = tag->next)
+                tag->level = level;
+
+            return RT_EOK;
+        }
+    }
+
+    return -RT_ERROR;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static long dbg_level(int argc, char **argv)
+{
+    const char *names = "EWID";
+    const char *arg;
+    int index, level;
+
+    if (argc == 1)
+    {
+        rt_kprintf("tag              level\n");
+        rt_kprintf("---------------- -----\n");
+        for (index = 0; index < RT_DBG_TAG_MAX && _dbg_tags[index] != RT_NULL; index ++)
+        {
+            rt_kprintf("%-16s %c\n", _dbg_tags[index]->name, names[_dbg_tags[index]->level & 0x03]);
+        }
+        return 0;
+    }
+    else if (argc == 3)
+    {
+        arg = argv[2];
+        for (level = 0; level < 4 && names[level] != arg[0]; level ++);
+        if (level == 4)
+            level = (arg[0] >= '0' && arg[0] <= '9' && arg[1] == '\0') ? arg[0] - '0' : -1;
+
+        switch (rt_dbg_tag_set_level(argv[1], level))
+        {
+        case RT_EOK:
+            return 0;
+        case -RT_ERROR:
+            rt_kprintf("tag %s is not registered, it is registered by its first log\n", argv[1]);
+            return -RT_ERROR;
+        default:
+            break;
+        }
+    }
+
+    rt_kprintf("Usage: dbg_level [<tag> <E|W|I|D|0-3>]\n");
+    return -RT_EINVAL;
+}
+MSH_CMD_EXPORT(dbg_level, runtime log level of tags: dbg_level [<tag> <E|W|I|D|0-3>]);
+#endif
+
+/**@}*/
+
+#endif
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The heap magazines: the small chunks freed to system heap are cached per
+ * size class in front of the heap lock, for each heap allocator (mem.c,
+ * slab.c and memheap.c).
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined(RT_USING_HEAP) && defined(RT_USING_HEAP_MAGAZINE)
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+#define HEAP_MAGAZINE_MIN       16
+#define HEAP_MAGAZINE_CLASSES   8
+
+#if (RT_HEAP_MAGAZINE_MAX & (RT_HEAP_MAGAZINE_MAX - 1)) != 0 || \
+    RT_HEAP_MAGAZINE_MAX < HEAP_MAGAZINE_MIN || \
+    RT_HEAP_MAGAZINE_MAX > (HEAP_MAGAZINE_MIN << (HEAP_MAGAZINE_CLASSES - 1))
+#error "RT_HEAP_MAGAZINE_MAX must be power of 2 between 16 and 2048"
+#endif
+
+#if RT_HEAP_MAGAZINE_BATCH < 1 || RT_HEAP_MAGAZINE_BATCH > RT_HEAP_MAGAZINE_SIZE
+#error "RT_HEAP_MAGAZINE_BATCH must be between 1 and RT_HEAP_MAGAZINE_SIZE"
+#endif
+
+/*
+ * The magazines cache the recently freed small chunks of system heap, one
+ * magazine for each power of 2 size class. The cached chunks are linked
+ * through their first word. The heap fills and drains a magazine in batches
+ * under its lock, so a balanced rt_malloc/rt_free pair only disables the
+ * interrupt for a few instructions and does not take the heap lock.
+ */
+struct heap_magazine
+{
+    void       *chunk;                  /* list of cached chunks */
+    rt_uint16_t count;                  /* number of cached chunks */
+};
+
+static struct heap_magazine _heap_magazine[HEAP_MAGAZINE_CLASSES];
+static rt_uint32_t _heap_magazine_hit;
+static rt_uint32_t _heap_magazine_miss;
+static rt_uint32_t _heap_magazine_flush;
+
+/**
+ * This function will take a cached chunk for an allocation. The small size
+ * is rounded up to its size class, the heap shall allocate the rounded size
+ * on a miss so that the chunk fits the size class when it is freed.
+ *
+ * @param size the allocation size, which is rounded up if it is small
+ *
+ * @return the cached chunk, or RT_NULL if there is no cached chunk
+ */
+void *rt_heap_magazine_get(rt_size_t *size)
+{
+    int index;
+    void *chunk;
+    rt_size_t class_size;
+    rt_base_t level;
+
+    if (*size > RT_HEAP_MAGAZINE_MAX)
+        return RT_NULL;
+
+    for (index = 0, class_size = HEAP_MAGAZINE_MIN; class_size < *size; index ++)
+        class_size <<= 1;
+    *size = class_size;
+
+    level = rt_hw_interrupt_disable();
+    chunk = _heap_magazine[index].chunk;
+    if (chunk != RT_NULL)
+    {
+        _heap_magazine[index].chunk = *(void **)chunk;
+        _heap_magazine[index].count --;
+        _heap_magazine_hit ++;
+    }
+    else
+    {
+        _heap_magazine_miss ++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return chunk;
+}
+
+/**
+ * This function will cache a freed chunk in the magazine of its size class.
+ * Only the chunks of exactly a class size are cached, so a cached chunk has
+ * the alignment which the heap gives to an allocation of that size.
+ *
+ * @param ptr the freed chunk
+ * @param size the usable size of the chunk
+ * @param flush the list of drained chunks, linked through the first word
+ *
+ * @return RT_EOK if the chunk is cached, -RT_ERROR if it is not of a size class.
+ */
+rt_err_t rt_heap_magazine_put(void *ptr, rt_size_t size, void **flush)
+{
+    int index, count;
+    void *tail;
+    rt_base_t level;
+    struct heap_magazine *magazine;
+
+    *flush = RT_NULL;
+    if (size < HEAP_MAGAZINE_MIN || size > RT_HEAP_MAGAZINE_MAX || (size & (size - 1)) != 0)
+        return -RT_ERROR;
+
+    for (index = 0; (HEAP_MAGAZINE_MIN << index) < size; index ++);
+    magazine = &_heap_magazine[index];
+
+    /* a chunk freed twice in a row would be linked to itself */
+    RT_ASSERT(ptr != magazine->chunk);
+
+    level = rt_hw_interrupt_disable();
+    if (magazine->count >= RT_HEAP_MAGAZINE_SIZE)
+    {
+        *flush = magazine->chunk;
+        for (tail = magazine->chunk, count = 1; count < RT_HEAP_MAGAZINE_BATCH; count ++)
+            tail = *(void **)tail;
+
+        magazine->chunk  = *(void **)tail;
+        magazine->count -= RT_HEAP_MAGAZINE_BATCH;
+        *(void **)tail   = RT_NULL;
+        _heap_magazine_flush ++;
+    }
+
+    *(void **)ptr   = magazine->chunk;
+    magazine->chunk = ptr;
+    magazine->count ++;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will fill the magazine of a size class with a batch of
+ * chunks. It shall be invoked with the heap locked.
+ *
+ * @param heap the heap passed to alloc
+ * @param size the size class got by rt_heap_magazine_get
+ * @param alloc the function allocates a chunk from the locked heap
+ */
+void rt_heap_magazine_fill(void *heap, rt_size_t size,
+                           void *(*alloc)(void *heap, rt_size_t size))
+{
+    int index, count;
+    void *chunk;
+    rt_base_t level;
+    struct heap_magazine *magazine;
+
+    for (index = 0; (HEAP_MAGAZINE_MIN << index) < size; index ++);
+    magazine = &_heap_magazine[index];
+
+    for (count = 0; count < RT_HEAP_MAGAZINE_BATCH; count ++)
+    {
+        /* the magazine may be filled by rt_free during refilling */
+        if (magazine->count >= RT_HEAP_MAGAZINE_SIZE)
+            break;
+
+        chunk = alloc(heap, size);
+        if (chunk == RT_NULL)
+            break;
+
+        level = rt_hw_interrupt_disable();
+        *(void **)chunk = magazine->chunk;
+        magazine->chunk = chunk;
+        magazine->count ++;
+        rt_hw_interrupt_enable(level);
+    }
+}
+
+/**
+ * This function will take all cached chunks out of the magazines, so that
+ * the heap can release them when it runs out of memory.
+ *
+ * @return the list of cached chunks linked through the first word, RT_NULL
+ *         if there is no cached chunk.
+ */
+void *rt_heap_magazine_drain(void)
+{
+    int index;
+    void *list = RT_NULL, *chunk, *tail;
+    rt_base_t level;
+
+    for (index = 0; index < HEAP_MAGAZINE_CLASSES; index ++)
+    {
+        level = rt_hw_interrupt_disable();
+        chunk = _heap_magazine[index].chunk;
+        _heap_magazine[index].chunk = RT_NULL;
+        _heap_magazine[index].count = 0;
+        rt_hw_interrupt_enable(level);
+
+        if (chunk == RT_NULL)
+            continue;
+
+        for (tail = chunk; *(void **)tail != RT_NULL; tail = *(void **)tail);
+        *(void **)tail = list;
+        list = chunk;
+    }
+
+    return list;
+}
+
+/**
+ * This function will show the statistics of heap magazines.
+ */
+void rt_heap_magazine_dump(void)
+{
+    int index;
+    rt_uint32_t total;
+
+    total = _heap_magazine_hit + _heap_magazine_miss;
+    rt_kprintf("magazine hit %d%%, miss %d, flush %d\n",
+               total ? (int)((rt_uint64_t)_heap_magazine_hit * 100 / total) : 0,
+               _heap_magazine_miss, _heap_magazine_flush);
+    for (index = 0; (HEAP_MAGAZINE_MIN << index) <= RT_HEAP_MAGAZINE_MAX; index ++)
+    {
+        rt_kprintf("  %4d bytes: %d cached\n", HEAP_MAGAZINE_MIN << index,
+                   _heap_magazine[index].count);
+    }
+}
+
+/**@}*/
+
+#endif
@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The sampled heap profiler: the live bytes of each call site of the heap
+ * API are estimated from the sampled allocations.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined(RT_USING_HEAP) && defined(RT_USING_HEAP_PROFILE)
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+#if !defined(__GNUC__) && !defined(__CC_ARM) && !defined(__CLANG_ARM)
+#error "The heap profiler requires __builtin_return_address"
+#endif
+
+#if (RT_HEAP_PROFILE_SITES & (RT_HEAP_PROFILE_SITES - 1)) != 0 || \
+    (RT_HEAP_PROFILE_BLOCKS & (RT_HEAP_PROFILE_BLOCKS - 1)) != 0
+#error "RT_HEAP_PROFILE_SITES and RT_HEAP_PROFILE_BLOCKS must be power of 2"
+#endif
+
+/*
+ * The heap profiler samples the allocation which crosses a sample point,
+ * the sample points are about every rate bytes allocated. A small sampled
+ * block stands for rate bytes of each sample point it crosses, and a block
+ * not smaller than rate is always sampled for its own size, so the bytes
+ * of a call site are estimated without bias. The call sites and the live
+ * sampled blocks are kept in two open addressing hash tables, a sample is
+ * dropped when a table is full.
+ */
+struct heap_profile_block
+{
+    void       *ptr;                    /* sampled memory block */
+    rt_size_t   weight;                 /* estimated bytes of the sample */
+    rt_uint16_t site;                   /* index of call site */
+};
+
+rt_size_t rt_heap_profile_rate;
+
+static struct rt_heap_profile_site _heap_profile_site[RT_HEAP_PROFILE_SITES];
+static struct heap_profile_block _heap_profile_block[RT_HEAP_PROFILE_BLOCKS];
+static rt_base_t _heap_profile_left;
+static rt_uint32_t _heap_profile_seed = 0x2545f491;
+static rt_uint32_t _heap_profile_dropped;
+
+rt_inline rt_uint32_t _heap_profile_hash(void *key)
+{
+    return ((rt_uint32_t)((rt_ubase_t)key >> 2) * 2654435761u) >> 16;
+}
+
+/* the bytes until next sample, randomized around rate against periodic patterns */
+static rt_base_t _heap_profile_interval(void)
+{
+    _heap_profile_seed ^= _heap_profile_seed << 13;
+    _heap_profile_seed ^= _heap_profile_seed >> 17;
+    _heap_profile_seed ^= _heap_profile_seed << 5;
+
+    return rt_heap_profile_rate / 2 + _heap_profile_seed % rt_heap_profile_rate + 1;
+}
+
+/* find or insert the call site, the interrupt shall be disabled */
+static struct rt_heap_profile_site *_heap_profile_site_get(void *caller)
+{
+    rt_uint32_t index, probe;
+    struct rt_heap_profile_site *site;
+
+    index = _heap_profile_hash(caller);
+    for (probe = 0; probe < RT_HEAP_PROFILE_SITES; probe ++)
+    {
+        site = &_heap_profile_site[(index + probe) & (RT_HEAP_PROFILE_SITES - 1)];
+        if (site->caller == caller)
+            return site;
+
+        if (site->caller == RT_NULL)
+        {
+            site->caller = caller;
+            return site;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* find the sampled block, the interrupt shall be disabled */
+static struct heap_profile_block *_heap_profile_block_find(void *ptr)
+{
+    rt_uint32_t index, probe;
+    struct heap_profile_block *block;
+
+    index = _heap_profile_hash(ptr);
+    for (probe = 0; probe < RT_HEAP_PROFILE_BLOCKS; probe ++)
+    {
+        block = &_heap_profile_block[(index + probe) & (RT_HEAP_PROFILE_BLOCKS - 1)];
+        if (block->ptr == ptr)
+            return block;
+
+        if (block->ptr == RT_NULL)
+            break;
+    }
+
+    return RT_NULL;
+}
+
+/* remove the sampled block, the following blocks in the probe chain are moved back */
+static void _heap_profile_block_remove(struct heap_profile_block *block)
+{
+    rt_uint32_t hole, index, home;
+
+    /* the hole is emptied first, so the scan stops in a full table too */
+    hole = block - _heap_profile_block;
+    _heap_profile_block[hole].ptr = RT_NULL;
+    for (index = (hole + 1) & (RT_HEAP_PROFILE_BLOCKS - 1);
+         _heap_profile_block[index].ptr != RT_NULL;
+         index = (index + 1) & (RT_HEAP_PROFILE_BLOCKS - 1))
+    {
+        home = _heap_profile_hash(_heap_profile_block[index].ptr) & (RT_HEAP_PROFILE_BLOCKS - 1);
+        /* the block can be moved if the hole is between its home and it */
+        if (((index - home) & (RT_HEAP_PROFILE_BLOCKS - 1)) >=
+            ((index - hole) & (RT_HEAP_PROFILE_BLOCKS - 1)))
+        {
+            _heap_profile_block[hole] = _heap_profile_block[index];
+            _heap_profile_block[index].ptr = RT_NULL;
+            hole = index;
+        }
+    }
+}
+
+/**
+ * This function will start the heap profiler, or stop it with rate 0. The
+ * records are cleared when the profiler is started, and are kept for
+ * rt_heap_profile_dump when it is stopped.
+ *
+ * @param rate the average bytes allocated between two samples, 0 to stop
+ */
+void rt_heap_profile_set(rt_size_t rate)
+{
+    rt_base_t level;
+
+    if (rate != 0 && rt_heap_profile_rate == 0)
+        rt_heap_profile_reset();
+
+    level = rt_hw_interrupt_disable();
+    rt_heap_profile_rate = rate;
+    if (rate != 0)
+        _heap_profile_left = _heap_profile_interval();
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will clear the records of heap profiler.
+ */
+void rt_heap_profile_reset(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(_heap_profile_site, 0, sizeof(_heap_profile_site));
+    rt_memset(_heap_profile_block, 0, sizeof(_heap_profile_block));
+    _heap_profile_dropped = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will count an allocation, and sample it when the bytes
+ * until next sample are exhausted. It is invoked by RT_HEAP_PROFILE_ALLOC.
+ *
+ * @param ptr the allocated memory block
+ * @param size the requested size
+ * @param caller the return address of heap API
+ */
+void rt_heap_profile_alloc(void *ptr, rt_size_t size, void *caller)
+{
+    rt_base_t level;
+    rt_size_t weight;
+    rt_uint32_t index, probe;
+    struct rt_heap_profile_site *site;
+    struct heap_profile_block *block;
+
+    if (ptr == RT_NULL)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    if (rt_heap_profile_rate == 0)
+    {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    if (size >= rt_heap_profile_rate)
+    {
+        weight = size;
+    }
+    else
+    {
+        _heap_profile_left -= size;
+        if (_heap_profile_left > 0)
+        {
+            rt_hw_interrupt_enable(level);
+            return;
+        }
+
+        /* count the sample points crossed by this block */
+        for (weight = 0; _heap_profile_left <= 0; weight += rt_heap_profile_rate)
+            _heap_profile_left += _heap_profile_interval();
+    }
+
+    site = _heap_profile_site_get(caller);
+    if (site == RT_NULL)
+        goto __dropped;
+
+    index = _heap_profile_hash(ptr);
+    for (probe = 0; probe < RT_HEAP_PROFILE_BLOCKS; probe ++)
+    {
+        block = &_heap_profile_block[(index + probe) & (RT_HEAP_PROFILE_BLOCKS - 1)];
+        if (block->ptr == RT_NULL)
+            break;
+    }
+    if (probe == RT_HEAP_PROFILE_BLOCKS)
+        goto __dropped;
+
+    block->ptr    = ptr;
+    block->weight = weight;
+    block->site   = site - _heap_profile_site;
+
+    site->live  += block->weight;
+    site->total += block->weight;
+    site->count ++;
+    rt_hw_interrupt_enable(level);
+
+    return;
+
+__dropped:
+    _heap_profile_dropped ++;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will uncount a sampled memory block which is freed. It is
+ * invoked by RT_HEAP_PROFILE_FREE.
+ *
+ * @param ptr the memory block to be freed
+ */
+void rt_heap_profile_free(void *ptr)
+{
+    rt_base_t level;
+    struct rt_heap_profile_site *site;
+    struct heap_profile_block *block;
+
+    level = rt_hw_interrupt_disable();
+    block = _heap_profile_block_find(ptr);
+    if (block != RT_NULL)
+    {
+        site = &_heap_profile_site[block->site];
+        site->live -= block->weight;
+        site->count --;
+        _heap_profile_block_remove(block);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will move a memory block which is just sampled by an inner
+ * heap API to the call site of outer heap API, such as rt_calloc which
+ * allocates by rt_malloc. It is invoked by RT_HEAP_PROFILE_CALLER.
+ *
+ * @param ptr the allocated memory block
+ * @param caller the return address of outer heap API
+ */
+void rt_heap_profile_caller(void *ptr, void *caller)
+{
+    rt_base_t level;
+    struct rt_heap_profile_site *site;
+    struct heap_profile_block *block;
+
+    if (ptr == RT_NULL)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    block = _heap_profile_block_find(ptr);
+    if (block != RT_NULL && (site = _heap_profile_site_get(caller)) != RT_NULL)
+    {
+        _heap_profile_site[block->site].live  -= block->weight;
+        _heap_profile_site[block->site].total -= block->weight;
+        _heap_profile_site[block->site].count --;
+
+        block->site  = site - _heap_profile_site;
+        site->live  += block->weight;
+        site->total += block->weight;
+        site->count ++;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/* the site next to last in the descending order of (live, address) */
+static rt_bool_t _heap_profile_next(const struct rt_heap_profile_site *last,
+                                    struct rt_heap_profile_site *site)
+{
+    int index, top = -1;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    for (index = 0; index < RT_HEAP_PROFILE_SITES; index ++)
+    {
+        struct rt_heap_profile_site *s = &_heap_profile_site[index];
+
+        if (s->caller == RT_NULL || s->total == 0)
+            continue;
+        if (last != RT_NULL && (s->live > last->live ||
+            (s->live == last->live && s->caller >= last->caller)))
+            continue;
+        if (top < 0 || s->live > _heap_profile_site[top].live ||
+            (s->live == _heap_profile_site[top].live && s->caller > _heap_profile_site[top].caller))
+            top = index;
+    }
+    if (top >= 0)
+        *site = _heap_profile_site[top];
+    rt_hw_interrupt_enable(level);
+
+    return top >= 0;
+}
+
+/**
+ * This function will get the call sites with the most live bytes.
+ *
+ * @param sites the array of call sites, in the descending order of live bytes
+ * @param count the size of array
+ *
+ * @return the number of call sites got
+ */
+int rt_heap_profile_top(struct rt_heap_profile_site *sites, int count)
+{
+    int index;
+
+    RT_ASSERT(sites != RT_NULL);
+
+    for (index = 0; index < count; index ++)
+    {
+        if (!_heap_profile_next(index > 0 ? &sites[index - 1] : RT_NULL, &sites[index]))
+            break;
+    }
+
+    return index;
+}
+
+/**
+ * This function will get the number of samples dropped as a table is full.
+ *
+ * @return the number of dropped samples
+ */
+rt_uint32_t rt_heap_profile_dropped(void)
+{
+    return _heap_profile_dropped;
+}
+
+/**
+ * This function will show the call sites with the most live bytes. The
+ * address of call site can be resolved by addr2line.
+ *
+ * @param count the number of call sites to show
+ */
+void rt_heap_profile_dump(int count)
+{
+    struct rt_heap_profile_site site, *last = RT_NULL;
+
+    rt_kprintf("heap profile: rate %d, dropped %d\n", rt_heap_profile_rate, _heap_profile_dropped);
+    rt_kprintf("caller      live bytes blocks total bytes\n");
+    rt_kprintf("---------- ---------- ------ -----------\n");
+
+    for (; count > 0 && _heap_profile_next(last, &site); count --)
+    {
+        rt_kprintf("0x%p %-10d %-6d %-11d\n", site.caller, site.live, site.count, site.total);
+        last = &site;
+    }
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+/* the decimal number at the start of a string */
+static int _heap_profile_number(const char *s)
+{
+    int number = 0;
+
+    while (*s >= '0' && *s <= '9')
+        number = number * 10 + *s++ - '0';
+
+    return number;
+}
+
+static long heapprof(int argc, char **argv)
+{
+    if (argc == 1)
+    {
+        rt_heap_profile_dump(10);
+        return 0;
+    }
+
+    if (argc == 2 && rt_strcmp(argv[1], "reset") == 0)
+    {
+        rt_heap_profile_reset();
+        return 0;
+    }
+    else if (argc == 3 && rt_strcmp(argv[1], "rate") == 0)
+    {
+        rt_heap_profile_set(_heap_profile_number(argv[2]));
+        return 0;
+    }
+    else if (argc == 3 && rt_strcmp(argv[1], "top") == 0)
+    {
+        rt_heap_profile_dump(_heap_profile_number(argv[2]));
+        return 0;
+    }
+
+    rt_kprintf("Usage: heapprof [rate <bytes>|top <n>|reset]\n");
+    return -RT_EINVAL;
+}
+MSH_CMD_EXPORT(heapprof, sampled heap profiler: heapprof [rate <bytes>|top <n>|reset]);
+#endif
+
+/**@}*/
+
+#endif
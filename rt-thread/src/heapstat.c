@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The heap statistics: the free blocks of each heap allocator are counted
+ * in size classes as they are created and removed, the largest one is kept
+ * exact, and the heap bytes are charged to the owner threads.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined(RT_USING_HEAP) && defined(RT_USING_HEAP_INFO)
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/* get the size class of a free block, which is floor(log2(size)) - 4 */
+rt_inline int _heap_stat_bin(rt_size_t size)
+{
+    int bin;
+
+    for (bin = 0; bin < RT_HEAP_INFO_BINS - 1 && size >= (32UL << bin); bin ++);
+
+    return bin;
+}
+
+/**
+ * This function will count a free block which is created in heap. It shall
+ * be invoked with the heap locked.
+ *
+ * @param stat the statistics of heap
+ * @param size the size of free block
+ */
+void rt_heap_stat_add(struct rt_heap_stat *stat, rt_size_t size)
+{
+    int bin;
+
+    bin = _heap_stat_bin(size);
+    stat->count[bin] ++;
+    stat->size[bin] += size;
+
+    rt_heap_stat_largest_found(stat, size);
+}
+
+/**
+ * This function will uncount a free block which is removed from heap. It
+ * shall be invoked with the heap locked.
+ *
+ * @param stat the statistics of heap
+ * @param size the size of free block
+ */
+void rt_heap_stat_del(struct rt_heap_stat *stat, rt_size_t size)
+{
+    int bin;
+
+    bin = _heap_stat_bin(size);
+    RT_ASSERT(stat->count[bin] > 0);
+    stat->count[bin] --;
+    stat->size[bin] -= size;
+
+    /* the other free blocks are smaller than largest once it is lost */
+    if (size == stat->largest)
+    {
+        RT_ASSERT(stat->largest_count > 0);
+        stat->largest_count --;
+    }
+}
+
+/**
+ * This function will tell whether the largest free block is lost, which is
+ * after the last free block of the largest size is removed. Then all free
+ * blocks shall be reported by rt_heap_stat_largest_found to find it out. It
+ * shall be invoked with the heap locked.
+ *
+ * @param stat the statistics of heap
+ *
+ * @return RT_TRUE if the free blocks shall be walked, otherwise RT_FALSE
+ */
+rt_bool_t rt_heap_stat_largest_lost(struct rt_heap_stat *stat)
+{
+    int bin;
+
+    if (stat->largest_count != 0)
+        return RT_FALSE;
+
+    for (bin = RT_HEAP_INFO_BINS - 1; bin >= 0 && stat->count[bin] == 0; bin --);
+
+    stat->largest = 0;
+    if (bin < 0)
+        return RT_FALSE;
+
+    /* it is the only block of the top size class */
+    if (stat->count[bin] == 1)
+    {
+        stat->largest       = stat->size[bin];
+        stat->largest_count = 1;
+
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
+/**
+ * This function will report a free block to find out the largest one. It
+ * shall be invoked with the heap locked.
+ *
+ * @param stat the statistics of heap
+ * @param size the size of free block
+ */
+void rt_heap_stat_largest_found(struct rt_heap_stat *stat, rt_size_t size)
+{
+    if (size > stat->largest)
+    {
+        stat->largest       = size;
+        stat->largest_count = 1;
+    }
+    else if (size == stat->largest)
+    {
+        stat->largest_count ++;
+    }
+}
+
+/**
+ * This function will merge the statistics of a heap into the heap
+ * information. The largest free block shall not be lost, see
+ * rt_heap_stat_largest_lost.
+ *
+ * @param stat the statistics of heap
+ * @param info the heap information
+ */
+void rt_heap_stat_merge(const struct rt_heap_stat *stat, struct rt_heap_info *info)
+{
+    int bin;
+
+    for (bin = 0; bin < RT_HEAP_INFO_BINS; bin ++)
+    {
+        info->histogram[bin] += stat->count[bin];
+        info->free_count     += stat->count[bin];
+        info->free_size      += stat->size[bin];
+    }
+
+    if (stat->largest > info->largest_free)
+        info->largest_free = stat->largest;
+
+    if (info->free_size != 0)
+        info->fragmentation = 100 - (rt_uint8_t)((rt_uint64_t)info->largest_free * 100 / info->free_size);
+}
+
+/* whether a thread is still alive, the interrupt shall be disabled */
+static rt_bool_t _heap_stat_thread_alive(rt_thread_t thread)
+{
+    struct rt_list_node *node;
+    struct rt_object_information *information;
+
+    information = rt_object_get_information(RT_Object_Class_Thread);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        if (rt_list_entry(node, struct rt_object, list) == (struct rt_object *)thread)
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/**
+ * This function will charge the heap bytes of an allocated memory block to
+ * current thread, which is recorded in the block as its owner.
+ *
+ * @param owner the owner of memory block
+ * @param size the usable size of memory block
+ */
+void rt_heap_stat_charge(rt_thread_t *owner, rt_size_t size)
+{
+    rt_base_t level;
+    rt_thread_t thread;
+
+    thread = rt_thread_self();
+    *owner = thread;
+    if (thread == RT_NULL)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    thread->heap_used += size;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will uncharge the heap bytes of a memory block from its
+ * owner, which may be another thread than current thread. Nothing is
+ * uncharged if the owner has been deleted.
+ *
+ * @param owner the owner of memory block
+ * @param size the usable size of memory block
+ */
+void rt_heap_stat_uncharge(rt_thread_t owner, rt_size_t size)
+{
+    rt_base_t level;
+
+    if (owner == RT_NULL)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    if (owner == rt_thread_self() || _heap_stat_thread_alive(owner))
+        owner->heap_used -= size;
+    rt_hw_interrupt_enable(level);
+}
+
+/**@}*/
+
+#endif
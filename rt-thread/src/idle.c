@@ -35,6 +35,9 @@
 #endif
 
 extern rt_list_t rt_thread_defunct;
+#ifdef RT_USING_HEAP
+extern void rt_thread_release(rt_thread_t thread);
+#endif
 
 static struct rt_thread idle;
 ALIGN(RT_ALIGN_SIZE)
@@ -166,10 +169,8 @@ void rt_thread_idle_excute(void)
                 tlist);
         /* remove defunct thread */
         rt_list_remove(&(thread->tlist));
-        /* release thread's stack */
-        RT_KERNEL_FREE(thread->stack_addr);
-        /* delete thread object */
-        rt_object_delete((rt_object_t)thread);
+        /* release thread's stack and object */
+        rt_thread_release(thread);
         rt_hw_interrupt_enable(lock);
     }
 #endif
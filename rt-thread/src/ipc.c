@@ -43,9 +43,9 @@
 #include <rthw.h>
 
 #ifdef RT_USING_HOOK
-extern void (*rt_object_trytake_hook)(struct rt_object *object);
-extern void (*rt_object_take_hook)(struct rt_object *object);
-extern void (*rt_object_put_hook)(struct rt_object *object);
+extern RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_trytake_hook;
+extern RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_take_hook;
+extern RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_put_hook;
 #endif
 
 /**
@@ -386,10 +386,7 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
                                             thread->name));
 
                 /* reset the timeout of thread timer and start it */
-                rt_timer_control(&(thread->thread_timer),
-                                 RT_TIMER_CTRL_SET_TIME,
-                                 &time);
-                rt_timer_start(&(thread->thread_timer));
+                rt_thread_timeout_start(thread, time);
             }
 
             /* enable interrupt */
@@ -759,10 +756,7 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
                                   thread->name));
 
                     /* reset the timeout of thread timer and start it */
-                    rt_timer_control(&(thread->thread_timer),
-                                     RT_TIMER_CTRL_SET_TIME,
-                                     &time);
-                    rt_timer_start(&(thread->thread_timer));
+                    rt_thread_timeout_start(thread, time);
                 }
 
                 /* enable interrupt */
@@ -1242,10 +1236,7 @@ rt_err_t rt_event_recv(rt_event_t   event,
         if (timeout > 0)
         {
             /* reset the timeout of thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &timeout);
-            rt_timer_start(&(thread->thread_timer));
+            rt_thread_timeout_start(thread, timeout);
         }
 
         /* enable interrupt */
@@ -1534,10 +1525,7 @@ rt_err_t rt_mb_send_wait(rt_mailbox_t mb,
                                         thread->name));
 
             /* reset the timeout of thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &timeout);
-            rt_timer_start(&(thread->thread_timer));
+            rt_thread_timeout_start(thread, timeout);
         }
 
         /* enable interrupt */
@@ -1689,10 +1677,7 @@ rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout)
                                         thread->name));
 
             /* reset the timeout of thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &timeout);
-            rt_timer_start(&(thread->thread_timer));
+            rt_thread_timeout_start(thread, timeout);
         }
 
         /* enable interrupt */
@@ -2083,10 +2068,7 @@ rt_err_t rt_mq_send_wait(rt_mq_t     mq,
                                         thread->name));
 
             /* reset the timeout of thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &timeout);
-            rt_timer_start(&(thread->thread_timer));
+            rt_thread_timeout_start(thread, timeout);
         }
 
         /* enable interrupt */
@@ -2356,10 +2338,7 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
                                         thread->name));
 
             /* reset the timeout of thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &timeout);
-            rt_timer_start(&(thread->thread_timer));
+            rt_thread_timeout_start(thread, timeout);
         }
 
         /* enable interrupt */
@@ -16,28 +16,74 @@
 
 #ifdef RT_USING_HOOK
 
-static void (*rt_interrupt_enter_hook)(void);
-static void (*rt_interrupt_leave_hook)(void);
+static RT_OBJECT_HOOK_LIST(void) rt_interrupt_enter_hook;
+static RT_OBJECT_HOOK_LIST(void) rt_interrupt_leave_hook;
 
 /**
  * @ingroup Hook
  * This function set a hook function when the system enter a interrupt
  *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
+ *
  * @note the hook function must be simple and never be blocked or suspend.
  */
-void rt_interrupt_enter_sethook(void (*hook)(void))
+rt_err_t rt_interrupt_enter_sethook(void (*hook)(void))
 {
-    rt_interrupt_enter_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_interrupt_enter_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * @ingroup Hook
+ * This function will delete a hook function which was set by rt_interrupt_enter_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_interrupt_enter_delhook(void (*hook)(void))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_interrupt_enter_hook, hook, result);
+
+    return result;
 }
 /**
  * @ingroup Hook
  * This function set a hook function when the system exit a interrupt.
  *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
+ *
  * @note the hook function must be simple and never be blocked or suspend.
  */
-void rt_interrupt_leave_sethook(void (*hook)(void))
+rt_err_t rt_interrupt_leave_sethook(void (*hook)(void))
 {
-    rt_interrupt_leave_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_interrupt_leave_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * @ingroup Hook
+ * This function will delete a hook function which was set by rt_interrupt_leave_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_interrupt_leave_delhook(void (*hook)(void))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_interrupt_leave_hook, hook, result);
+
+    return result;
 }
 #endif
 
@@ -107,6 +107,11 @@ int *_rt_errno(void)
     return (int *)&__rt_errno;
 }
 
+/*
+ * The memory routines below are weak, an architecture can override them with
+ * optimized versions in libcpu, which are enabled by RT_USING_CPU_MEMFUNC.
+ */
+
 /**
  * This function will set the content of memory to specified value
  *
@@ -116,7 +121,7 @@ int *_rt_errno(void)
  *
  * @return the address of source memory
  */
-void *rt_memset(void *s, int c, rt_ubase_t count)
+RT_WEAK void *rt_memset(void *s, int c, rt_ubase_t count)
 {
 #ifdef RT_USING_TINY_SIZE
     char *xs = (char *)s;
@@ -137,10 +142,15 @@ void *rt_memset(void *s, int c, rt_ubase_t count)
     unsigned int d = c & 0xff;  /* To avoid sign extension, copy C to an
                                 unsigned variable.  */
 
-    if (!TOO_SMALL(count) && !UNALIGNED(s))
+    if (!TOO_SMALL(count))
     {
-        /* If we get this far, we know that n is large and m is word-aligned. */
-        aligned_addr = (unsigned long *)s;
+        /* set the unaligned head byte by byte, then m is word-aligned. */
+        while (UNALIGNED(m))
+        {
+            *m++ = (char)d;
+            count--;
+        }
+        aligned_addr = (unsigned long *)m;
 
         /* Store D into each char sized location in BUFFER so that
          * we can set large blocks quickly.
@@ -199,7 +209,7 @@ void *rt_memset(void *s, int c, rt_ubase_t count)
  *
  * @return the address of destination memory
  */
-void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+RT_WEAK void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
 {
 #ifdef RT_USING_TINY_SIZE
     char *tmp = (char *)dst, *s = (char *)src;
@@ -220,7 +230,7 @@ void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
 #else
 
 #define UNALIGNED(X, Y) \
-    (((long)X & (sizeof (long) - 1)) | ((long)Y & (sizeof (long) - 1)))
+    (((long)X ^ (long)Y) & (sizeof (long) - 1))
 #define BIGBLOCKSIZE    (sizeof (long) << 2)
 #define LITTLEBLOCKSIZE (sizeof (long))
 #define TOO_SMALL(LEN)  ((LEN) < BIGBLOCKSIZE)
@@ -231,10 +241,17 @@ void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
     long *aligned_src;
     int len = count;
 
-    /* If the size is small, or either SRC or DST is unaligned,
+    /* If the size is small, or SRC and DST can not be aligned together,
     then punt into the byte copy loop.  This should be rare. */
     if (!TOO_SMALL(len) && !UNALIGNED(src_ptr, dst_ptr))
     {
+        /* Copy the unaligned head, then both are word-aligned. */
+        while ((long)dst_ptr & (sizeof (long) - 1))
+        {
+            *dst_ptr++ = *src_ptr++;
+            len--;
+        }
+
         aligned_dst = (long *)dst_ptr;
         aligned_src = (long *)src_ptr;
 
@@ -281,8 +298,12 @@ void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
  *
  * @return the address of destination memory
  */
-void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
+RT_WEAK void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
 {
+#define LBLOCKSIZE      (sizeof(long))
+#define UNALIGNED(X, Y) (((long)X ^ (long)Y) & (LBLOCKSIZE - 1))
+#define TOO_SMALL(LEN)  ((LEN) < LBLOCKSIZE * 2)
+
     char *tmp = (char *)dest, *s = (char *)src;
 
     if (s < tmp && tmp < s + n)
@@ -290,16 +311,60 @@ void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
         tmp += n;
         s += n;
 
+#ifndef RT_USING_TINY_SIZE
+        /* copy backward one long word at a time, from the aligned end */
+        if (!TOO_SMALL(n) && !UNALIGNED(tmp, s))
+        {
+            while ((long)tmp & (LBLOCKSIZE - 1))
+            {
+                *(--tmp) = *(--s);
+                n--;
+            }
+
+            while (n >= LBLOCKSIZE)
+            {
+                tmp -= LBLOCKSIZE;
+                s -= LBLOCKSIZE;
+                *(long *)tmp = *(long *)s;
+                n -= LBLOCKSIZE;
+            }
+        }
+#endif
+
         while (n--)
             *(--tmp) = *(--s);
     }
     else
     {
+#ifndef RT_USING_TINY_SIZE
+        /* a forward copy word by word is safe when dest is below src */
+        if (!TOO_SMALL(n) && !UNALIGNED(tmp, s))
+        {
+            while ((long)tmp & (LBLOCKSIZE - 1))
+            {
+                *tmp++ = *s++;
+                n--;
+            }
+
+            while (n >= LBLOCKSIZE)
+            {
+                *(long *)tmp = *(long *)s;
+                tmp += LBLOCKSIZE;
+                s += LBLOCKSIZE;
+                n -= LBLOCKSIZE;
+            }
+        }
+#endif
+
         while (n--)
             *tmp++ = *s++;
     }
 
     return dest;
+
+#undef LBLOCKSIZE
+#undef UNALIGNED
+#undef TOO_SMALL
 }
 
 /**
@@ -311,12 +376,38 @@ void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
  *
  * @return the result
  */
-rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count)
+RT_WEAK rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count)
 {
     const unsigned char *su1, *su2;
     int res = 0;
 
-    for (su1 = (const unsigned char *)cs, su2 = (const unsigned char *)ct; 0 < count; ++su1, ++su2, count--)
+    su1 = (const unsigned char *)cs;
+    su2 = (const unsigned char *)ct;
+
+#ifndef RT_USING_TINY_SIZE
+    /* skip the equal long words, the different word is compared bytewise */
+    if (count >= sizeof(long) * 2 &&
+        (((long)su1 ^ (long)su2) & (sizeof(long) - 1)) == 0)
+    {
+        while ((long)su1 & (sizeof(long) - 1))
+        {
+            if ((res = *su1 - *su2) != 0)
+                return res;
+            su1++;
+            su2++;
+            count--;
+        }
+
+        while (count >= sizeof(long) && *(const long *)su1 == *(const long *)su2)
+        {
+            su1 += sizeof(long);
+            su2 += sizeof(long);
+            count -= sizeof(long);
+        }
+    }
+#endif
+
+    for (; 0 < count; ++su1, ++su2, count--)
         if ((res = *su1 - *su2) != 0)
             break;
 
@@ -407,6 +498,21 @@ char *rt_strncpy(char *dst, const char *src, rt_ubase_t n)
     return (dst);
 }
 
+#ifndef RT_USING_TINY_SIZE
+/*
+ * The string routines below skip a word at a time. A word is only read when
+ * it is aligned, so it never crosses a page or MPU region boundary even when
+ * it holds bytes beyond the terminating null byte.
+ */
+#define STR_WSIZE           (sizeof(rt_ubase_t))
+#define STR_UNALIGNED(X)    ((rt_ubase_t)(X) & (STR_WSIZE - 1))
+#define STR_LOW_ONES        ((rt_ubase_t)-1 / 0xff)
+#define STR_HIGH_ONES       (STR_LOW_ONES << 7)
+/* nonzero if the word X holds a null byte */
+#define STR_HAS_ZERO(X)     (((X) - STR_LOW_ONES) & ~(X) & STR_HIGH_ONES)
+#define STR_WORD(X)         (*(const rt_ubase_t *)(X))
+#endif
+
 /**
  * This function will compare two strings with specified maximum length
  *
@@ -420,6 +526,28 @@ rt_int32_t rt_strncmp(const char *cs, const char *ct, rt_ubase_t count)
 {
     register signed char __res = 0;
 
+#ifndef RT_USING_TINY_SIZE
+    if (!STR_UNALIGNED((rt_ubase_t)cs ^ (rt_ubase_t)ct))
+    {
+        /* compare the unaligned head byte by byte */
+        while (count && STR_UNALIGNED(cs))
+        {
+            if ((__res = *cs - *ct++) != 0 || !*cs++)
+                return __res;
+            count --;
+        }
+
+        /* then skip the equal words which hold no null byte */
+        while (count >= STR_WSIZE && STR_WORD(cs) == STR_WORD(ct) &&
+               !STR_HAS_ZERO(STR_WORD(cs)))
+        {
+            cs += STR_WSIZE;
+            ct += STR_WSIZE;
+            count -= STR_WSIZE;
+        }
+    }
+#endif
+
     while (count)
     {
         if ((__res = *cs - *ct++) != 0 || !*cs++)
@@ -440,6 +568,27 @@ rt_int32_t rt_strncmp(const char *cs, const char *ct, rt_ubase_t count)
  */
 rt_int32_t rt_strcmp(const char *cs, const char *ct)
 {
+#ifndef RT_USING_TINY_SIZE
+    if (!STR_UNALIGNED((rt_ubase_t)cs ^ (rt_ubase_t)ct))
+    {
+        /* compare the unaligned head byte by byte */
+        while (STR_UNALIGNED(cs))
+        {
+            if (!*cs || *cs != *ct)
+                return (*cs - *ct);
+            cs++;
+            ct++;
+        }
+
+        /* then skip the equal words which hold no null byte */
+        while (STR_WORD(cs) == STR_WORD(ct) && !STR_HAS_ZERO(STR_WORD(cs)))
+        {
+            cs += STR_WSIZE;
+            ct += STR_WSIZE;
+        }
+    }
+#endif
+
     while (*cs && *cs == *ct)
     {
         cs++;
@@ -464,7 +613,21 @@ rt_size_t rt_strnlen(const char *s, rt_ubase_t maxlen)
 {
     const char *sc;
 
-    for (sc = s; *sc != '\0' && (rt_ubase_t)(sc - s) < maxlen; ++sc) /* nothing */
+#ifndef RT_USING_TINY_SIZE
+    for (sc = s; STR_UNALIGNED(sc) && (rt_ubase_t)(sc - s) < maxlen; ++sc)
+    {
+        if (*sc == '\0')
+            return sc - s;
+    }
+
+    /* only the whole words below s + maxlen are read */
+    while (maxlen - (rt_ubase_t)(sc - s) >= STR_WSIZE && !STR_HAS_ZERO(STR_WORD(sc)))
+        sc += STR_WSIZE;
+#else
+    sc = s;
+#endif
+
+    for (; (rt_ubase_t)(sc - s) < maxlen && *sc != '\0'; ++sc) /* nothing */
         ;
 
     return sc - s;
@@ -482,12 +645,32 @@ rt_size_t rt_strlen(const char *s)
 {
     const char *sc;
 
-    for (sc = s; *sc != '\0'; ++sc) /* nothing */
+#ifndef RT_USING_TINY_SIZE
+    for (sc = s; STR_UNALIGNED(sc); ++sc)
+    {
+        if (*sc == '\0')
+            return sc - s;
+    }
+
+    while (!STR_HAS_ZERO(STR_WORD(sc)))
+        sc += STR_WSIZE;
+#else
+    sc = s;
+#endif
+
+    for (; *sc != '\0'; ++sc) /* nothing */
         ;
 
     return sc - s;
 }
 
+#undef STR_WSIZE
+#undef STR_UNALIGNED
+#undef STR_LOW_ONES
+#undef STR_HIGH_ONES
+#undef STR_HAS_ZERO
+#undef STR_WORD
+
 #ifdef RT_USING_HEAP
 /**
  * This function will duplicate a string.
@@ -529,41 +712,118 @@ void rt_show_version(void)
 /* private function */
 #define _ISDIGIT(c)  ((unsigned)((c) - '0') < 10)
 
+/*
+ * These get the quotient and the remainder of a division by 10. A core with
+ * a long multiply lets the compiler multiply by the reciprocal of 10, while
+ * Cortex-M0/M0+/M1 and RISC-V without the M extension, which would call a
+ * software division, multiply by the reciprocal with shifts and adds.
+ */
+rt_inline rt_uint32_t divu10(rt_uint32_t n, int *rem)
+{
+    rt_uint32_t q, r;
+
+#if defined(__ARM_ARCH_6M__) || (defined(__riscv) && !defined(__riscv_mul))
+    q = (n >> 1) + (n >> 2);
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    q >>= 3;
+    r = n - ((q << 3) + (q << 1));
+    if (r > 9)
+    {
+        q++;
+        r -= 10;
+    }
+#else
+    q = n / 10U;
+    r = n - q * 10U;
+#endif
+    *rem = (int)r;
+
+    return q;
+}
+
+rt_inline rt_uint32_t divu100(rt_uint32_t n, int *rem)
+{
+    rt_uint32_t q;
+
+#if defined(__ARM_ARCH_6M__) || (defined(__riscv) && !defined(__riscv_mul))
+    q = divu10(divu10(n, rem), rem);
+#else
+    q = n / 100U;
+#endif
+    *rem = (int)(n - q * 100U);
+
+    return q;
+}
+
+/* a 64 bits division is a library call on every 32 bits core */
+rt_inline unsigned long long divu10_ll(unsigned long long n, int *rem)
+{
+    unsigned long long q, r;
+
+    q = (n >> 1) + (n >> 2);
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    q += q >> 32;
+    q >>= 3;
+    r = n - ((q << 3) + (q << 1));
+    if (r > 9)
+    {
+        q++;
+        r -= 10;
+    }
+    *rem = (int)r;
+
+    return q;
+}
+
 #ifdef RT_PRINTF_LONGLONG
 rt_inline int divide(long long *n, int base)
 {
+    unsigned long long num = (unsigned long long)*n;
     int res;
 
     /* optimized for processor which does not support divide instructions. */
     if (base == 10)
     {
-        res = (int)(((unsigned long long)*n) % 10U);
-        *n = (long long)(((unsigned long long)*n) / 10U);
+        if (num >> 32)
+            num = divu10_ll(num, &res);
+        else
+            num = divu10((rt_uint32_t)num, &res);
     }
     else
     {
-        res = (int)(((unsigned long long)*n) % 16U);
-        *n = (long long)(((unsigned long long)*n) / 16U);
+        /* base 8 or 16 */
+        res = (int)(num & (base - 1));
+        num >>= (base == 16) ? 4 : 3;
     }
+    *n = (long long)num;
 
     return res;
 }
 #else
 rt_inline int divide(long *n, int base)
 {
+    unsigned long num = (unsigned long)*n;
     int res;
 
     /* optimized for processor which does not support divide instructions. */
     if (base == 10)
     {
-        res = (int)(((unsigned long)*n) % 10U);
-        *n = (long)(((unsigned long)*n) / 10U);
+        if (sizeof(long) > 4 && (num >> 16 >> 16))
+            num = (unsigned long)divu10_ll(num, &res);
+        else
+            num = divu10((rt_uint32_t)num, &res);
     }
     else
     {
-        res = (int)(((unsigned long)*n) % 16U);
-        *n = (long)(((unsigned long)*n) / 16U);
+        /* base 8 or 16 */
+        res = (int)(num & (base - 1));
+        num >>= (base == 16) ? 4 : 3;
     }
+    *n = (long)num;
 
     return res;
 }
@@ -758,6 +1018,61 @@ static char *print_number(char *buf,
     return buf;
 }
 
+/* print the number of a plain %d, %u or %x, which has no flag or width */
+static char *print_plain_number(char *buf, char *end, rt_uint32_t num, char type)
+{
+    static const char digit_pairs[] =
+        "00010203040506070809" "10111213141516171819"
+        "20212223242526272829" "30313233343536373839"
+        "40414243444546474849" "50515253545556575859"
+        "60616263646566676869" "70717273747576777879"
+        "80818283848586878889" "90919293949596979899";
+    char tmp[10];
+    int i = 0, rem;
+
+    if (type == 'd' && (rt_int32_t)num < 0)
+    {
+        if (buf < end)
+            *buf = '-';
+        ++ buf;
+        num = 0U - num;
+    }
+
+    if (type == 'x')
+    {
+        do
+        {
+            tmp[i++] = "0123456789abcdef"[num & 0x0f];
+            num >>= 4;
+        } while (num != 0);
+    }
+    else
+    {
+        /* two digits at a time from the table */
+        while (num >= 100)
+        {
+            num = divu100(num, &rem);
+            tmp[i++] = digit_pairs[rem * 2 + 1];
+            tmp[i++] = digit_pairs[rem * 2];
+        }
+
+        do
+        {
+            num = divu10(num, &rem);
+            tmp[i++] = (char)('0' + rem);
+        } while (num != 0);
+    }
+
+    while (i-- > 0)
+    {
+        if (buf < end)
+            *buf = tmp[i];
+        ++ buf;
+    }
+
+    return buf;
+}
+
 rt_int32_t rt_vsnprintf(char       *buf,
                         rt_size_t   size,
                         const char *fmt,
@@ -766,7 +1081,7 @@ rt_int32_t rt_vsnprintf(char       *buf,
 #ifdef RT_PRINTF_LONGLONG
     unsigned long long num;
 #else
-    rt_uint32_t num;
+    long num;
 #endif
     int i, len;
     char *str, *end, c;
@@ -801,6 +1116,33 @@ rt_int32_t rt_vsnprintf(char       *buf,
             continue;
         }
 
+        /* fast path of the plain %s, %d, %u and %x */
+        switch (fmt[1])
+        {
+        case 's':
+            ++ fmt;
+            s = va_arg(args, char *);
+            if (!s) s = "(NULL)";
+
+            while (*s)
+            {
+                if (str < end) *str = *s;
+                ++ str;
+                ++ s;
+            }
+            continue;
+
+        case 'd':
+        case 'u':
+        case 'x':
+            ++ fmt;
+            str = print_plain_number(str, end, va_arg(args, rt_uint32_t), *fmt);
+            continue;
+
+        default:
+            break;
+        }
+
         /* process flags */
         flags = 0;
 
@@ -1129,15 +1471,9 @@ RT_WEAK void rt_hw_console_output(const char *str)
     /* empty console output */
 }
 
-/**
- * This function will put string to the console.
- *
- * @param str the string output to the console.
- */
-void rt_kputs(const char *str)
+/* write a string of length bytes, which is terminated by '\0', to console */
+static void _console_write(const char *str, rt_size_t length)
 {
-    if (!str) return;
-
 #ifdef RT_USING_DEVICE
     if (_console_device == RT_NULL)
     {
@@ -1148,7 +1484,7 @@ void rt_kputs(const char *str)
         rt_uint16_t old_flag = _console_device->open_flag;
 
         _console_device->open_flag |= RT_DEVICE_FLAG_STREAM;
-        rt_device_write(_console_device, 0, str, rt_strlen(str));
+        rt_device_write(_console_device, 0, str, length);
         _console_device->open_flag = old_flag;
     }
 #else
@@ -1156,6 +1492,25 @@ void rt_kputs(const char *str)
 #endif
 }
 
+/**
+ * This function will put string to the console.
+ *
+ * @param str the string output to the console.
+ */
+void rt_kputs(const char *str)
+{
+    rt_size_t length;
+
+    if (!str) return;
+
+    length = rt_strlen(str);
+#ifdef RT_USING_CONSOLE_ASYNC
+    if (rt_console_async_puts(str, length))
+        return;
+#endif
+    _console_write(str, length);
+}
+
 /**
  * This function will print a formatted string on system console
  *
@@ -1168,6 +1523,13 @@ void rt_kprintf(const char *fmt, ...)
     static char rt_log_buf[RT_CONSOLEBUF_SIZE];
 
     va_start(args, fmt);
+#ifdef RT_USING_CONSOLE_ASYNC
+    if (rt_console_async_vprintf(fmt, args))
+    {
+        va_end(args);
+        return;
+    }
+#endif
     /* the return value of vsnprintf is the number of bytes that would be
      * written to buffer had if the size of the buffer been sufficiently
      * large excluding the terminating null byte. If the output string
@@ -1176,22 +1538,7 @@ void rt_kprintf(const char *fmt, ...)
     length = rt_vsnprintf(rt_log_buf, sizeof(rt_log_buf) - 1, fmt, args);
     if (length > RT_CONSOLEBUF_SIZE - 1)
         length = RT_CONSOLEBUF_SIZE - 1;
-#ifdef RT_USING_DEVICE
-    if (_console_device == RT_NULL)
-    {
-        rt_hw_console_output(rt_log_buf);
-    }
-    else
-    {
-        rt_uint16_t old_flag = _console_device->open_flag;
-
-        _console_device->open_flag |= RT_DEVICE_FLAG_STREAM;
-        rt_device_write(_console_device, 0, rt_log_buf, length);
-        _console_device->open_flag = old_flag;
-    }
-#else
-    rt_hw_console_output(rt_log_buf);
-#endif
+    _console_write(rt_log_buf, length);
     va_end(args);
 }
 #endif
@@ -1199,14 +1546,15 @@ void rt_kprintf(const char *fmt, ...)
 #ifdef RT_USING_HEAP
 /**
  * This function allocates a memory block, which address is aligned to the
- * specified alignment size.
+ * specified alignment size. It is the fallback of the heaps without native
+ * aligned allocation, the block shall be released by rt_free_align.
  *
  * @param size the allocated memory block size
  * @param align the alignment size
  *
  * @return the allocated memory block on successful, otherwise returns RT_NULL
  */
-void *rt_malloc_align(rt_size_t size, rt_size_t align)
+RT_WEAK void *rt_malloc_align(rt_size_t size, rt_size_t align)
 {
     void *ptr;
     void *align_ptr;
@@ -1226,6 +1574,8 @@ void *rt_malloc_align(rt_size_t size, rt_size_t align)
     ptr = rt_malloc(align_size);
     if (ptr != RT_NULL)
     {
+        RT_HEAP_PROFILE_CALLER(ptr);
+
         /* the allocated memory block is aligned */
         if (((rt_ubase_t)ptr & (align - 1)) == 0)
         {
@@ -1251,13 +1601,14 @@ void *rt_malloc_align(rt_size_t size, rt_size_t align)
  *
  * @param ptr the memory block pointer
  */
-void rt_free_align(void *ptr)
+RT_WEAK void rt_free_align(void *ptr)
 {
     void *real_ptr;
 
     real_ptr = (void *) * (rt_ubase_t *)((rt_ubase_t)ptr - sizeof(void *));
     rt_free(real_ptr);
 }
+
 #endif
 
 #ifndef RT_USING_CPU_FFS
@@ -1336,6 +1687,9 @@ void rt_assert_handler(const char *ex_string, const char *func, rt_size_t line)
 
     if (rt_assert_hook == RT_NULL)
     {
+#ifdef RT_USING_CONSOLE_ASYNC
+        rt_console_flush();
+#endif
         rt_kprintf("(%s) assertion failed at function:%s, line number:%d \n", ex_string, func, line);
         while (dummy == 0);
     }
@@ -57,8 +57,8 @@
 
 #if defined (RT_USING_HEAP) && defined (RT_USING_SMALL_MEM)
 #ifdef RT_USING_HOOK
-static void (*rt_malloc_hook)(void *ptr, rt_size_t size);
-static void (*rt_free_hook)(void *ptr);
+static RT_OBJECT_HOOK_LIST(void *ptr, rt_size_t size) rt_malloc_hook;
+static RT_OBJECT_HOOK_LIST(void *ptr) rt_free_hook;
 
 /**
  * @addtogroup Hook
@@ -71,10 +71,32 @@ static void (*rt_free_hook)(void *ptr);
  * block is allocated from heap memory.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
+rt_err_t rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
 {
-    rt_malloc_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_malloc_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_malloc_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_malloc_delhook(void (*hook)(void *ptr, rt_size_t size))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_malloc_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -82,10 +104,32 @@ void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
  * block is released to heap memory.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void rt_free_sethook(void (*hook)(void *ptr))
+rt_err_t rt_free_sethook(void (*hook)(void *ptr))
 {
-    rt_free_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_free_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_free_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_free_delhook(void (*hook)(void *ptr))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_free_hook, hook, result);
+
+    return result;
 }
 
 /**@}*/
@@ -93,6 +137,8 @@ void rt_free_sethook(void (*hook)(void *ptr))
 #endif
 
 #define HEAP_MAGIC 0x1ea0
+/* the used flag of a freed chunk cached in the heap magazines */
+#define HEAP_CACHED 2
 struct heap_mem
 {
     /* magic and used flag */
@@ -111,6 +157,9 @@ struct heap_mem
     rt_uint8_t thread[4];   /* thread name */
 #endif
 #endif
+#ifdef RT_USING_HEAP_INFO
+    rt_thread_t owner;      /* the thread charged for the block */
+#endif
 };
 
 /** pointer to the heap: for alignment, heap_ptr is now a pointer instead of an array */
@@ -127,12 +176,30 @@ static struct heap_mem *heap_end;
 
 #define MIN_SIZE_ALIGNED     RT_ALIGN(MIN_SIZE, RT_ALIGN_SIZE)
 #define SIZEOF_STRUCT_MEM    RT_ALIGN(sizeof(struct heap_mem), RT_ALIGN_SIZE)
+#define MEM_OF(rmem)         ((struct heap_mem *)((rt_uint8_t *)(rmem) - SIZEOF_STRUCT_MEM))
 
 static struct heap_mem *lfree;   /* pointer to the lowest free block */
 
 static struct rt_semaphore heap_sem;
 static rt_size_t mem_size_aligned;
 
+#ifdef RT_USING_HEAP_INFO
+static struct rt_heap_stat heap_stat;
+
+/* the usable size of a block */
+#define MEM_SIZE(mem)       ((mem)->next - ((rt_uint8_t *)(mem) - heap_ptr) - SIZEOF_STRUCT_MEM)
+#define MEM_FREE_ADD(mem)   rt_heap_stat_add(&heap_stat, MEM_SIZE(mem))
+#define MEM_FREE_DEL(mem)   rt_heap_stat_del(&heap_stat, MEM_SIZE(mem))
+/* charge an allocated block to current thread, or uncharge it from its owner */
+#define MEM_CHARGE(mem)     rt_heap_stat_charge(&(mem)->owner, MEM_SIZE(mem))
+#define MEM_UNCHARGE(mem)   rt_heap_stat_uncharge((mem)->owner, MEM_SIZE(mem))
+#else
+#define MEM_FREE_ADD(mem)
+#define MEM_FREE_DEL(mem)
+#define MEM_CHARGE(mem)     do {} while (0)
+#define MEM_UNCHARGE(mem)   do {} while (0)
+#endif
+
 #ifdef RT_MEM_STATS
 static rt_size_t used_mem, max_mem;
 #endif
@@ -153,6 +220,7 @@ rt_inline void rt_mem_setname(struct heap_mem *mem, const char *name)
 }
 #endif
 
+/* merge a new free block with its free neighbors and count the merged block */
 static void plug_holes(struct heap_mem *mem)
 {
     struct heap_mem *nmem;
@@ -171,6 +239,7 @@ static void plug_holes(struct heap_mem *mem)
         /* if mem->next is unused and not end of heap_ptr,
          * combine mem and mem->next
          */
+        MEM_FREE_DEL(nmem);
         if (lfree == nmem)
         {
             lfree = mem;
@@ -184,13 +253,17 @@ static void plug_holes(struct heap_mem *mem)
     if (pmem != mem && pmem->used == 0)
     {
         /* if mem->prev is unused, combine mem and mem->prev */
+        MEM_FREE_DEL(pmem);
         if (lfree == mem)
         {
             lfree = pmem;
         }
         pmem->next = mem->next;
         ((struct heap_mem *)&heap_ptr[mem->next])->prev = (rt_uint8_t *)pmem - heap_ptr;
+        mem = pmem;
     }
+
+    MEM_FREE_ADD(mem);
 }
 
 /**
@@ -239,6 +312,7 @@ void rt_system_heap_init(void *begin_addr, void *end_addr)
 #ifdef RT_USING_MEMTRACE
     rt_mem_setname(mem, "INIT");
 #endif
+    MEM_FREE_ADD(mem);
 
     /* initialize the end of the heap */
     heap_end        = (struct heap_mem *)&heap_ptr[mem->next];
@@ -262,6 +336,193 @@ void rt_system_heap_init(void *begin_addr, void *end_addr)
 
 /**@{*/
 
+/*
+ * take size bytes from the free memory block at ptr, the rest of block is
+ * split into a new free block if it is large enough.
+ */
+static void *_heap_mem_take(rt_size_t ptr, rt_size_t size)
+{
+    rt_size_t ptr2;
+    struct heap_mem *mem, *mem2;
+
+    mem = (struct heap_mem *)&heap_ptr[ptr];
+    RT_ASSERT(!mem->used);
+    RT_ASSERT(mem->next - (ptr + SIZEOF_STRUCT_MEM) >= size);
+    MEM_FREE_DEL(mem);
+
+    /* mem is not used and at least perfect fit is possible:
+     * mem->next - (ptr + SIZEOF_STRUCT_MEM) gives us the 'user data size' of mem */
+
+    if (mem->next - (ptr + SIZEOF_STRUCT_MEM) >=
+        (size + SIZEOF_STRUCT_MEM + MIN_SIZE_ALIGNED))
+    {
+        /* (in addition to the above, we test if another struct heap_mem (SIZEOF_STRUCT_MEM) containing
+         * at least MIN_SIZE_ALIGNED of data also fits in the 'user data space' of 'mem')
+         * -> split large block, create empty remainder,
+         * remainder must be large enough to contain MIN_SIZE_ALIGNED data: if
+         * mem->next - (ptr + (2*SIZEOF_STRUCT_MEM)) == size,
+         * struct heap_mem would fit in but no data between mem2 and mem2->next
+         * @todo we could leave out MIN_SIZE_ALIGNED. We would create an empty
+         *       region that couldn't hold data, but when mem->next gets freed,
+         *       the 2 regions would be combined, resulting in more free memory
+         */
+        ptr2 = ptr + SIZEOF_STRUCT_MEM + size;
+
+        /* create mem2 struct */
+        mem2       = (struct heap_mem *)&heap_ptr[ptr2];
+        mem2->magic = HEAP_MAGIC;
+        mem2->used = 0;
+        mem2->next = mem->next;
+        mem2->prev = ptr;
+#ifdef RT_USING_MEMTRACE
+        rt_mem_setname(mem2, "    ");
+#endif
+        MEM_FREE_ADD(mem2);
+
+        /* and insert it between mem and mem->next */
+        mem->next = ptr2;
+        mem->used = 1;
+
+        if (mem2->next != mem_size_aligned + SIZEOF_STRUCT_MEM)
+        {
+            ((struct heap_mem *)&heap_ptr[mem2->next])->prev = ptr2;
+        }
+#ifdef RT_MEM_STATS
+        used_mem += (size + SIZEOF_STRUCT_MEM);
+        if (max_mem < used_mem)
+            max_mem = used_mem;
+#endif
+    }
+    else
+    {
+        /* (a mem2 struct does no fit into the user data space of mem and mem->next will always
+         * be used at this point: if not we have 2 unused structs in a row, plug_holes should have
+         * take care of this).
+         * -> near fit or excact fit: do not split, no mem2 creation
+         * also can't move mem->next directly behind mem, since mem->next
+         * will always be used at this point!
+         */
+        mem->used = 1;
+#ifdef RT_MEM_STATS
+        used_mem += mem->next - ((rt_uint8_t *)mem - heap_ptr);
+        if (max_mem < used_mem)
+            max_mem = used_mem;
+#endif
+    }
+    /* set memory block magic */
+    mem->magic = HEAP_MAGIC;
+#ifdef RT_USING_MEMTRACE
+    if (rt_thread_self())
+        rt_mem_setname(mem, rt_thread_self()->name);
+    else
+        rt_mem_setname(mem, "NONE");
+#endif
+
+    if (mem == lfree)
+    {
+        /* Find next free block after mem and update lowest free pointer */
+        while (lfree->used && lfree != heap_end)
+            lfree = (struct heap_mem *)&heap_ptr[lfree->next];
+
+        RT_ASSERT(((lfree == heap_end) || (!lfree->used)));
+    }
+
+    RT_ASSERT((rt_ubase_t)mem + SIZEOF_STRUCT_MEM + size <= (rt_ubase_t)heap_end);
+    RT_ASSERT((rt_ubase_t)((rt_uint8_t *)mem + SIZEOF_STRUCT_MEM) % RT_ALIGN_SIZE == 0);
+    RT_ASSERT((((rt_ubase_t)mem) & (RT_ALIGN_SIZE - 1)) == 0);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM,
+                 ("allocate memory at 0x%x, size: %d\n",
+                  (rt_ubase_t)((rt_uint8_t *)mem + SIZEOF_STRUCT_MEM),
+                  (rt_ubase_t)(mem->next - ((rt_uint8_t *)mem - heap_ptr))));
+
+    /* return the memory data except mem struct */
+    return (rt_uint8_t *)mem + SIZEOF_STRUCT_MEM;
+}
+
+/* allocate a block of size bytes, the heap shall be locked */
+static void *_heap_mem_alloc(rt_size_t size)
+{
+    rt_size_t ptr;
+    struct heap_mem *mem;
+
+    for (ptr = (rt_uint8_t *)lfree - heap_ptr;
+         ptr < mem_size_aligned - size;
+         ptr = ((struct heap_mem *)&heap_ptr[ptr])->next)
+    {
+        mem = (struct heap_mem *)&heap_ptr[ptr];
+
+        if ((!mem->used) && (mem->next - (ptr + SIZEOF_STRUCT_MEM)) >= size)
+            return _heap_mem_take(ptr, size);
+    }
+
+    return RT_NULL;
+}
+
+/* check a block freed by rt_free, which has to be in a used state */
+static void _heap_mem_check(struct heap_mem *mem)
+{
+    if (mem->used != 1 || mem->magic != HEAP_MAGIC)
+    {
+        rt_kprintf("to free a bad data block:\n");
+        rt_kprintf("mem: 0x%08x, used flag: %d, magic code: 0x%04x\n", mem, mem->used, mem->magic);
+    }
+    RT_ASSERT(mem->used == 1);
+    RT_ASSERT(mem->magic == HEAP_MAGIC);
+}
+
+/* release a used or cached block, the heap shall be locked */
+static void _heap_mem_release(struct heap_mem *mem)
+{
+    RT_ASSERT(mem->used);
+    RT_ASSERT(mem->magic == HEAP_MAGIC);
+    /* ... and is now unused. */
+    mem->used  = 0;
+    mem->magic = HEAP_MAGIC;
+#ifdef RT_USING_MEMTRACE
+    rt_mem_setname(mem, "    ");
+#endif
+
+    if (mem < lfree)
+    {
+        /* the newly freed struct is now the lowest */
+        lfree = mem;
+    }
+
+#ifdef RT_MEM_STATS
+    used_mem -= (mem->next - ((rt_uint8_t *)mem - heap_ptr));
+#endif
+
+    /* finally, see if prev or next are free also */
+    plug_holes(mem);
+}
+
+#ifdef RT_USING_HEAP_MAGAZINE
+static void *_heap_mem_refill(void *heap, rt_size_t size)
+{
+    void *rmem;
+
+    rmem = _heap_mem_alloc(size);
+    if (rmem != RT_NULL)
+        MEM_OF(rmem)->used = HEAP_CACHED;
+
+    return rmem;
+}
+
+/* release the chunks taken out of magazines, the heap shall be locked */
+static void _heap_mem_release_list(void *list)
+{
+    struct heap_mem *mem;
+
+    while (list != RT_NULL)
+    {
+        mem  = (struct heap_mem *)((rt_uint8_t *)list - SIZEOF_STRUCT_MEM);
+        list = *(void **)list;
+        _heap_mem_release(mem);
+    }
+}
+#endif
+
 /**
  * Allocate a block of memory with a minimum of 'size' bytes.
  *
@@ -271,8 +532,12 @@ void rt_system_heap_init(void *begin_addr, void *end_addr)
  */
 void *rt_malloc(rt_size_t size)
 {
-    rt_size_t ptr, ptr2;
-    struct heap_mem *mem, *mem2;
+#ifdef RT_USING_HEAP_MAGAZINE
+    struct heap_mem *mem;
+    void *flush;
+#endif
+    rt_size_t chunk_size;
+    void *rmem;
 
     if (size == 0)
         return RT_NULL;
@@ -295,6 +560,100 @@ void *rt_malloc(rt_size_t size)
         return RT_NULL;
     }
 
+    /* every data block must be at least MIN_SIZE_ALIGNED long */
+    if (size < MIN_SIZE_ALIGNED)
+        size = MIN_SIZE_ALIGNED;
+
+    chunk_size = size;
+#ifdef RT_USING_HEAP_MAGAZINE
+    rmem = rt_heap_magazine_get(&chunk_size);
+    if (rmem != RT_NULL)
+    {
+        mem = MEM_OF(rmem);
+        RT_ASSERT(mem->used == HEAP_CACHED);
+        mem->used = 1;
+#ifdef RT_USING_MEMTRACE
+        rt_mem_setname(mem, rt_thread_self() ? rt_thread_self()->name : "NONE");
+#endif
+        MEM_CHARGE(MEM_OF(rmem));
+        RT_HEAP_PROFILE_ALLOC(rmem, size);
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, (rmem, size));
+
+        return rmem;
+    }
+#endif
+
+    /* take memory semaphore */
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+
+    rmem = _heap_mem_alloc(chunk_size);
+#ifdef RT_USING_HEAP_MAGAZINE
+    if (rmem == RT_NULL)
+    {
+        /* return the cached chunks to heap and try again */
+        flush = rt_heap_magazine_drain();
+        if (flush != RT_NULL)
+        {
+            _heap_mem_release_list(flush);
+            rmem = _heap_mem_alloc(chunk_size);
+        }
+    }
+    else if (chunk_size <= RT_HEAP_MAGAZINE_MAX)
+    {
+        rt_heap_magazine_fill(RT_NULL, chunk_size, _heap_mem_refill);
+    }
+#endif
+
+    rt_sem_release(&heap_sem);
+
+    if (rmem != RT_NULL)
+    {
+        MEM_CHARGE(MEM_OF(rmem));
+        RT_HEAP_PROFILE_ALLOC(rmem, size);
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, (rmem, size));
+    }
+
+    return rmem;
+}
+
+/**
+ * This function allocates a memory block, which address is aligned to the
+ * specified alignment size. The leading fragment before the aligned block
+ * is kept in heap as a free block, and the memory block can be released by
+ * rt_free or rt_free_align.
+ *
+ * @param size the allocated memory block size
+ * @param align the alignment size, shall be power of 2
+ *
+ * @return the allocated memory block on successful, otherwise returns RT_NULL
+ */
+void *rt_malloc_align(rt_size_t size, rt_size_t align)
+{
+    rt_size_t ptr, ptr2;
+    rt_ubase_t data, aligned;
+    struct heap_mem *mem, *mem2;
+    void *rmem;
+
+    RT_ASSERT((align & (align - 1)) == 0);
+
+    if (align <= RT_ALIGN_SIZE)
+    {
+        rmem = rt_malloc(size);
+        RT_HEAP_PROFILE_CALLER(rmem);
+
+        return rmem;
+    }
+
+    if (size == 0)
+        return RT_NULL;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* alignment size */
+    size = RT_ALIGN(size, RT_ALIGN_SIZE);
+    if (size > mem_size_aligned)
+        return RT_NULL;
+
     /* every data block must be at least MIN_SIZE_ALIGNED long */
     if (size < MIN_SIZE_ALIGNED)
         size = MIN_SIZE_ALIGNED;
@@ -307,101 +666,49 @@ void *rt_malloc(rt_size_t size)
          ptr = ((struct heap_mem *)&heap_ptr[ptr])->next)
     {
         mem = (struct heap_mem *)&heap_ptr[ptr];
+        if (mem->used)
+            continue;
 
-        if ((!mem->used) && (mem->next - (ptr + SIZEOF_STRUCT_MEM)) >= size)
-        {
-            /* mem is not used and at least perfect fit is possible:
-             * mem->next - (ptr + SIZEOF_STRUCT_MEM) gives us the 'user data size' of mem */
+        /* the leading fragment shall be able to be a free block */
+        data    = (rt_ubase_t)mem + SIZEOF_STRUCT_MEM;
+        aligned = RT_ALIGN(data, align);
+        while (aligned != data && aligned - data < SIZEOF_STRUCT_MEM + MIN_SIZE_ALIGNED)
+            aligned += align;
 
-            if (mem->next - (ptr + SIZEOF_STRUCT_MEM) >=
-                (size + SIZEOF_STRUCT_MEM + MIN_SIZE_ALIGNED))
-            {
-                /* (in addition to the above, we test if another struct heap_mem (SIZEOF_STRUCT_MEM) containing
-                 * at least MIN_SIZE_ALIGNED of data also fits in the 'user data space' of 'mem')
-                 * -> split large block, create empty remainder,
-                 * remainder must be large enough to contain MIN_SIZE_ALIGNED data: if
-                 * mem->next - (ptr + (2*SIZEOF_STRUCT_MEM)) == size,
-                 * struct heap_mem would fit in but no data between mem2 and mem2->next
-                 * @todo we could leave out MIN_SIZE_ALIGNED. We would create an empty
-                 *       region that couldn't hold data, but when mem->next gets freed,
-                 *       the 2 regions would be combined, resulting in more free memory
-                 */
-                ptr2 = ptr + SIZEOF_STRUCT_MEM + size;
-
-                /* create mem2 struct */
-                mem2       = (struct heap_mem *)&heap_ptr[ptr2];
-                mem2->magic = HEAP_MAGIC;
-                mem2->used = 0;
-                mem2->next = mem->next;
-                mem2->prev = ptr;
-#ifdef RT_USING_MEMTRACE
-                rt_mem_setname(mem2, "    ");
-#endif
-
-                /* and insert it between mem and mem->next */
-                mem->next = ptr2;
-                mem->used = 1;
+        if (aligned + size > (rt_ubase_t)&heap_ptr[mem->next])
+            continue;
 
-                if (mem2->next != mem_size_aligned + SIZEOF_STRUCT_MEM)
-                {
-                    ((struct heap_mem *)&heap_ptr[mem2->next])->prev = ptr2;
-                }
-#ifdef RT_MEM_STATS
-                used_mem += (size + SIZEOF_STRUCT_MEM);
-                if (max_mem < used_mem)
-                    max_mem = used_mem;
-#endif
-            }
-            else
-            {
-                /* (a mem2 struct does no fit into the user data space of mem and mem->next will always
-                 * be used at this point: if not we have 2 unused structs in a row, plug_holes should have
-                 * take care of this).
-                 * -> near fit or excact fit: do not split, no mem2 creation
-                 * also can't move mem->next directly behind mem, since mem->next
-                 * will always be used at this point!
-                 */
-                mem->used = 1;
-#ifdef RT_MEM_STATS
-                used_mem += mem->next - ((rt_uint8_t *)mem - heap_ptr);
-                if (max_mem < used_mem)
-                    max_mem = used_mem;
-#endif
-            }
-            /* set memory block magic */
-            mem->magic = HEAP_MAGIC;
+        if (aligned != data)
+        {
+            /* split the leading fragment, which is left in the free list */
+            MEM_FREE_DEL(mem);
+            ptr2 = (rt_uint8_t *)aligned - SIZEOF_STRUCT_MEM - heap_ptr;
+            mem2 = (struct heap_mem *)&heap_ptr[ptr2];
+            mem2->magic = HEAP_MAGIC;
+            mem2->used = 0;
+            mem2->next = mem->next;
+            mem2->prev = ptr;
 #ifdef RT_USING_MEMTRACE
-            if (rt_thread_self())
-                rt_mem_setname(mem, rt_thread_self()->name);
-            else
-                rt_mem_setname(mem, "NONE");
+            rt_mem_setname(mem2, "    ");
 #endif
-
-            if (mem == lfree)
+            mem->next = ptr2;
+            if (mem2->next != mem_size_aligned + SIZEOF_STRUCT_MEM)
             {
-                /* Find next free block after mem and update lowest free pointer */
-                while (lfree->used && lfree != heap_end)
-                    lfree = (struct heap_mem *)&heap_ptr[lfree->next];
-
-                RT_ASSERT(((lfree == heap_end) || (!lfree->used)));
+                ((struct heap_mem *)&heap_ptr[mem2->next])->prev = ptr2;
             }
+            MEM_FREE_ADD(mem);
+            MEM_FREE_ADD(mem2);
+            ptr = ptr2;
+        }
 
-            rt_sem_release(&heap_sem);
-            RT_ASSERT((rt_ubase_t)mem + SIZEOF_STRUCT_MEM + size <= (rt_ubase_t)heap_end);
-            RT_ASSERT((rt_ubase_t)((rt_uint8_t *)mem + SIZEOF_STRUCT_MEM) % RT_ALIGN_SIZE == 0);
-            RT_ASSERT((((rt_ubase_t)mem) & (RT_ALIGN_SIZE - 1)) == 0);
-
-            RT_DEBUG_LOG(RT_DEBUG_MEM,
-                         ("allocate memory at 0x%x, size: %d\n",
-                          (rt_ubase_t)((rt_uint8_t *)mem + SIZEOF_STRUCT_MEM),
-                          (rt_ubase_t)(mem->next - ((rt_uint8_t *)mem - heap_ptr))));
+        rmem = _heap_mem_take(ptr, size);
+        MEM_CHARGE(MEM_OF(rmem));
+        rt_sem_release(&heap_sem);
 
-            RT_OBJECT_HOOK_CALL(rt_malloc_hook,
-                                (((void *)((rt_uint8_t *)mem + SIZEOF_STRUCT_MEM)), size));
+        RT_HEAP_PROFILE_ALLOC(rmem, size);
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, (rmem, size));
 
-            /* return the memory data except mem struct */
-            return (rt_uint8_t *)mem + SIZEOF_STRUCT_MEM;
-        }
+        return rmem;
     }
 
     rt_sem_release(&heap_sem);
@@ -410,61 +717,86 @@ void *rt_malloc(rt_size_t size)
 }
 
 /**
- * This function will change the previously allocated memory block.
+ * This function release the memory block, which is allocated by
+ * rt_malloc_align function and address is aligned.
+ *
+ * @param ptr the memory block pointer
+ */
+void rt_free_align(void *ptr)
+{
+    rt_free(ptr);
+}
+
+/**
+ * This function will change the size of a previously allocated memory block
+ * without moving it. The block is shrunk in place, or grown by absorbing the
+ * free memory block next to it.
  *
  * @param rmem pointer to memory allocated by rt_malloc
  * @param newsize the required new size
  *
- * @return the changed memory block address
+ * @return rmem on successful, RT_NULL if the block can not be resized in
+ *         place, and the block is not changed.
  */
-void *rt_realloc(void *rmem, rt_size_t newsize)
+void *rt_realloc_inplace(void *rmem, rt_size_t newsize)
 {
     rt_size_t size;
     rt_size_t ptr, ptr2;
     struct heap_mem *mem, *mem2;
-    void *nmem;
 
     RT_DEBUG_NOT_IN_INTERRUPT;
 
+    RT_ASSERT(rmem != RT_NULL);
+    RT_ASSERT((rt_uint8_t *)rmem >= (rt_uint8_t *)heap_ptr &&
+              (rt_uint8_t *)rmem < (rt_uint8_t *)heap_end);
+
     /* alignment size */
     newsize = RT_ALIGN(newsize, RT_ALIGN_SIZE);
     if (newsize > mem_size_aligned)
-    {
-        RT_DEBUG_LOG(RT_DEBUG_MEM, ("realloc: out of memory\n"));
-
         return RT_NULL;
-    }
-    else if (newsize == 0)
-    {
-        rt_free(rmem);
-        return RT_NULL;
-    }
-
-    /* allocate a new memory block */
-    if (rmem == RT_NULL)
-        return rt_malloc(newsize);
+    if (newsize < MIN_SIZE_ALIGNED)
+        newsize = MIN_SIZE_ALIGNED;
 
     rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
 
-    if ((rt_uint8_t *)rmem < (rt_uint8_t *)heap_ptr ||
-        (rt_uint8_t *)rmem >= (rt_uint8_t *)heap_end)
-    {
-        /* illegal memory */
-        rt_sem_release(&heap_sem);
-
-        return rmem;
-    }
-
     mem = (struct heap_mem *)((rt_uint8_t *)rmem - SIZEOF_STRUCT_MEM);
+    RT_ASSERT(mem->used == 1);
+    RT_ASSERT(mem->magic == HEAP_MAGIC);
 
     ptr = (rt_uint8_t *)mem - heap_ptr;
     size = mem->next - ptr - SIZEOF_STRUCT_MEM;
-    if (size == newsize)
+
+    /* the free block next to mem shall have enough room */
+    mem2 = (struct heap_mem *)&heap_ptr[mem->next];
+    if (newsize > size && (mem2 == heap_end || mem2->used ||
+                           mem2->next - ptr - SIZEOF_STRUCT_MEM < newsize))
     {
-        /* the size is the same as */
         rt_sem_release(&heap_sem);
 
-        return rmem;
+        return RT_NULL;
+    }
+    MEM_UNCHARGE(mem);
+
+    if (newsize > size)
+    {
+        /* absorb the next block */
+        MEM_FREE_DEL(mem2);
+#ifdef RT_MEM_STATS
+        used_mem += mem2->next - mem->next;
+        if (max_mem < used_mem)
+            max_mem = used_mem;
+#endif
+        mem->next = mem2->next;
+        ((struct heap_mem *)&heap_ptr[mem->next])->prev = ptr;
+        size = mem->next - ptr - SIZEOF_STRUCT_MEM;
+
+        if (mem2 == lfree)
+        {
+            /* find next free block after mem, the split block below shall be it */
+            lfree = (struct heap_mem *)&heap_ptr[mem->next];
+            while (lfree->used && lfree != heap_end)
+                lfree = (struct heap_mem *)&heap_ptr[lfree->next];
+        }
     }
 
     if (newsize + SIZEOF_STRUCT_MEM + MIN_SIZE < size)
@@ -496,17 +828,73 @@ void *rt_realloc(void *rmem, rt_size_t newsize)
         }
 
         plug_holes(mem2);
+    }
+    MEM_CHARGE(mem);
 
-        rt_sem_release(&heap_sem);
+    rt_sem_release(&heap_sem);
+
+    return rmem;
+}
+
+/**
+ * This function will change the previously allocated memory block.
+ *
+ * @param rmem pointer to memory allocated by rt_malloc
+ * @param newsize the required new size
+ *
+ * @return the changed memory block address
+ */
+void *rt_realloc(void *rmem, rt_size_t newsize)
+{
+    rt_size_t size;
+    struct heap_mem *mem;
+    void *nmem;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* alignment size */
+    newsize = RT_ALIGN(newsize, RT_ALIGN_SIZE);
+    if (newsize > mem_size_aligned)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("realloc: out of memory\n"));
 
+        return RT_NULL;
+    }
+    else if (newsize == 0)
+    {
+        rt_free(rmem);
+        return RT_NULL;
+    }
+
+    /* allocate a new memory block */
+    if (rmem == RT_NULL)
+    {
+        nmem = rt_malloc(newsize);
+        RT_HEAP_PROFILE_CALLER(nmem);
+
+        return nmem;
+    }
+
+    if ((rt_uint8_t *)rmem < (rt_uint8_t *)heap_ptr ||
+        (rt_uint8_t *)rmem >= (rt_uint8_t *)heap_end)
+    {
+        /* illegal memory */
         return rmem;
     }
-    rt_sem_release(&heap_sem);
+
+    /* shrink or expand memory in place */
+    if (rt_realloc_inplace(rmem, newsize) != RT_NULL)
+        return rmem;
+
+    /* the size of block is not changed by the failed resizing */
+    mem = (struct heap_mem *)((rt_uint8_t *)rmem - SIZEOF_STRUCT_MEM);
+    size = mem->next - ((rt_uint8_t *)mem - heap_ptr) - SIZEOF_STRUCT_MEM;
 
     /* expand memory */
     nmem = rt_malloc(newsize);
     if (nmem != RT_NULL) /* check memory */
     {
+        RT_HEAP_PROFILE_CALLER(nmem);
         rt_memcpy(nmem, rmem, size < newsize ? size : newsize);
         rt_free(rmem);
     }
@@ -532,6 +920,7 @@ void *rt_calloc(rt_size_t count, rt_size_t size)
 
     /* allocate 'count' objects of size 'size' */
     p = rt_malloc(count * size);
+    RT_HEAP_PROFILE_CALLER(p);
 
     /* zero the memory */
     if (p)
@@ -549,6 +938,9 @@ void *rt_calloc(rt_size_t count, rt_size_t size)
 void rt_free(void *rmem)
 {
     struct heap_mem *mem;
+#ifdef RT_USING_HEAP_MAGAZINE
+    void *flush;
+#endif
 
     if (rmem == RT_NULL)
         return;
@@ -560,6 +952,7 @@ void rt_free(void *rmem)
               (rt_uint8_t *)rmem < (rt_uint8_t *)heap_end);
 
     RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
+    RT_HEAP_PROFILE_FREE(rmem);
 
     if ((rt_uint8_t *)rmem < (rt_uint8_t *)heap_ptr ||
         (rt_uint8_t *)rmem >= (rt_uint8_t *)heap_end)
@@ -571,6 +964,8 @@ void rt_free(void *rmem)
 
     /* Get the corresponding struct heap_mem ... */
     mem = (struct heap_mem *)((rt_uint8_t *)rmem - SIZEOF_STRUCT_MEM);
+    _heap_mem_check(mem);
+    MEM_UNCHARGE(mem);
 
     RT_DEBUG_LOG(RT_DEBUG_MEM,
                  ("release memory 0x%x, size: %d\n",
@@ -578,38 +973,61 @@ void rt_free(void *rmem)
                   (rt_ubase_t)(mem->next - ((rt_uint8_t *)mem - heap_ptr))));
 
 
-    /* protect the heap from concurrent access */
-    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
-
-    /* ... which has to be in a used state ... */
-    if (!mem->used || mem->magic != HEAP_MAGIC)
+#ifdef RT_USING_HEAP_MAGAZINE
+    /* a cached chunk freed again is caught by the check above */
+    mem->used = HEAP_CACHED;
+    if (rt_heap_magazine_put(rmem, mem->next - ((rt_uint8_t *)rmem - heap_ptr), &flush) == RT_EOK)
     {
-        rt_kprintf("to free a bad data block:\n");
-        rt_kprintf("mem: 0x%08x, used flag: %d, magic code: 0x%04x\n", mem, mem->used, mem->magic);
+        if (flush == RT_NULL)
+            return;
+
+        /* release the chunks drained from magazine */
+        rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+        _heap_mem_release_list(flush);
+        rt_sem_release(&heap_sem);
+
+        return;
     }
-    RT_ASSERT(mem->used);
-    RT_ASSERT(mem->magic == HEAP_MAGIC);
-    /* ... and is now unused. */
-    mem->used  = 0;
-    mem->magic = HEAP_MAGIC;
-#ifdef RT_USING_MEMTRACE
-    rt_mem_setname(mem, "    ");
 #endif
 
-    if (mem < lfree)
+    /* protect the heap from concurrent access */
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+    _heap_mem_release(mem);
+    rt_sem_release(&heap_sem);
+}
+
+#ifdef RT_USING_HEAP_INFO
+/**
+ * This function will get the introspection information of system heap.
+ *
+ * @param info the heap information
+ */
+void rt_heap_info_get(struct rt_heap_info *info)
+{
+    struct heap_mem *mem;
+
+    RT_ASSERT(info != RT_NULL);
+
+    rt_memset(info, 0, sizeof(struct rt_heap_info));
+
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+    if (rt_heap_stat_largest_lost(&heap_stat))
     {
-        /* the newly freed struct is now the lowest */
-        lfree = mem;
+        for (mem = lfree; mem != heap_end; mem = (struct heap_mem *)&heap_ptr[mem->next])
+        {
+            if (!mem->used)
+                rt_heap_stat_largest_found(&heap_stat, MEM_SIZE(mem));
+        }
     }
-
+    info->total = mem_size_aligned;
 #ifdef RT_MEM_STATS
-    used_mem -= (mem->next - ((rt_uint8_t *)mem - heap_ptr));
+    info->used     = used_mem;
+    info->max_used = max_mem;
 #endif
-
-    /* finally, see if prev or next are free also */
-    plug_holes(mem);
+    rt_heap_stat_merge(&heap_stat, info);
     rt_sem_release(&heap_sem);
 }
+#endif
 
 #ifdef RT_MEM_STATS
 void rt_memory_info(rt_uint32_t *total,
@@ -632,6 +1050,12 @@ void list_mem(void)
     rt_kprintf("total memory: %d\n", mem_size_aligned);
     rt_kprintf("used memory : %d\n", used_mem);
     rt_kprintf("maximum allocated memory: %d\n", max_mem);
+#if defined(RT_USING_KMEM_CACHE) && defined(RT_USING_MEMPOOL)
+    rt_object_cache_dump();
+#endif
+#ifdef RT_USING_HEAP_MAGAZINE
+    rt_heap_magazine_dump();
+#endif
 }
 FINSH_FUNCTION_EXPORT(list_mem, list memory usage information)
 
@@ -648,7 +1072,7 @@ int memcheck(void)
         if (position < 0) goto __exit;
         if (position > (int)mem_size_aligned) goto __exit;
         if (mem->magic != HEAP_MAGIC) goto __exit;
-        if (mem->used != 0 && mem->used != 1) goto __exit;
+        if (mem->used != 0 && mem->used != 1 && mem->used != HEAP_CACHED) goto __exit;
     }
     rt_hw_interrupt_enable(level);
 
@@ -26,9 +26,10 @@
 
 /* dynamic pool magic and mask */
 #define RT_MEMHEAP_MAGIC        0x1ea01ea0
-#define RT_MEMHEAP_MASK         0xfffffffe
+#define RT_MEMHEAP_MASK         0xfffffffc
 #define RT_MEMHEAP_USED         0x01
 #define RT_MEMHEAP_FREED        0x00
+#define RT_MEMHEAP_CACHED       0x02    /* a freed block cached in the heap magazines */
 
 #define RT_MEMHEAP_IS_USED(i)   ((i)->magic & RT_MEMHEAP_USED)
 #define RT_MEMHEAP_MINIALLOC    12
@@ -36,6 +37,177 @@
 #define RT_MEMHEAP_SIZE         RT_ALIGN(sizeof(struct rt_memheap_item), RT_ALIGN_SIZE)
 #define MEMITEM_SIZE(item)      ((rt_ubase_t)item->next - (rt_ubase_t)item - RT_MEMHEAP_SIZE)
 
+#ifdef RT_USING_MEMHEAP_BINS
+/* get the free list of a block size, the list of 2^n to 2^(n+1) - 1 bytes */
+rt_inline int _memheap_bin(rt_uint32_t size)
+{
+    int bin;
+
+    for (bin = 0; size > 1; bin ++)
+        size >>= 1;
+
+    return bin;
+}
+#endif
+
+/* insert a free memory block into free list */
+static void _memheap_free_insert(struct rt_memheap *heap, struct rt_memheap_item *item)
+{
+#ifdef RT_USING_MEMHEAP_BINS
+    int bin;
+
+    bin = _memheap_bin(MEMITEM_SIZE(item));
+    item->prev_free = RT_NULL;
+    item->next_free = heap->bin[bin];
+    if (item->next_free != RT_NULL)
+        item->next_free->prev_free = item;
+    heap->bin[bin] = item;
+    heap->bin_bitmap |= 1UL << bin;
+#else
+    item->next_free = heap->free_list->next_free;
+    item->prev_free = heap->free_list;
+    heap->free_list->next_free->prev_free = item;
+    heap->free_list->next_free            = item;
+#endif
+#ifdef RT_USING_HEAP_INFO
+    rt_heap_stat_add(&heap->stat, MEMITEM_SIZE(item));
+#endif
+}
+
+/* remove a free memory block from free list, before the block size is changed */
+static void _memheap_free_remove(struct rt_memheap *heap, struct rt_memheap_item *item)
+{
+#ifdef RT_USING_MEMHEAP_BINS
+    int bin;
+
+    bin = _memheap_bin(MEMITEM_SIZE(item));
+    if (item->prev_free != RT_NULL)
+        item->prev_free->next_free = item->next_free;
+    else
+        heap->bin[bin] = item->next_free;
+    if (item->next_free != RT_NULL)
+        item->next_free->prev_free = item->prev_free;
+    if (heap->bin[bin] == RT_NULL)
+        heap->bin_bitmap &= ~(1UL << bin);
+#else
+    item->next_free->prev_free = item->prev_free;
+    item->prev_free->next_free = item->next_free;
+#endif
+#ifdef RT_USING_HEAP_INFO
+    rt_heap_stat_del(&heap->stat, MEMITEM_SIZE(item));
+#endif
+    item->next_free = RT_NULL;
+    item->prev_free = RT_NULL;
+}
+
+#ifdef RT_USING_MEMHEAP_BINS
+/* get the smallest free memory block of a free list which is not less than size */
+static struct rt_memheap_item *_memheap_bin_best(struct rt_memheap *heap, int bin, rt_uint32_t size)
+{
+    rt_uint32_t free_size, best_size = 0;
+    struct rt_memheap_item *item, *best = RT_NULL;
+
+    for (item = heap->bin[bin]; item != RT_NULL; item = item->next_free)
+    {
+        free_size = MEMITEM_SIZE(item);
+        if (free_size >= size && (best == RT_NULL || free_size < best_size))
+        {
+            best      = item;
+            best_size = free_size;
+            if (free_size == size)
+                break;
+        }
+    }
+
+    return best;
+}
+#endif
+
+/* find a free memory block which is not less than size, RT_NULL if not found */
+static struct rt_memheap_item *_memheap_free_find(struct rt_memheap *heap, rt_uint32_t size)
+{
+#ifdef RT_USING_MEMHEAP_BINS
+    int bin;
+    rt_uint32_t bitmap;
+    struct rt_memheap_item *item;
+
+    /* the free list of size may have smaller blocks */
+    bin  = _memheap_bin(size);
+    item = _memheap_bin_best(heap, bin, size);
+    if (item != RT_NULL)
+        return item;
+
+    /* all blocks of the next non-empty free list are large enough */
+    if (bin + 1 >= RT_MEMHEAP_BINS)
+        return RT_NULL;
+    bitmap = heap->bin_bitmap & ~((1UL << (bin + 1)) - 1);
+    if (bitmap == 0)
+        return RT_NULL;
+
+    return _memheap_bin_best(heap, __rt_ffs(bitmap) - 1, size);
+#else
+    struct rt_memheap_item *item;
+
+    /* first fit */
+    for (item = heap->free_list->next_free; item != heap->free_list; item = item->next_free)
+    {
+        if (MEMITEM_SIZE(item) >= size)
+            return item;
+    }
+
+    return RT_NULL;
+#endif
+}
+
+/* get the aligned address in a free memory block, 0 if the block is too small */
+static rt_ubase_t _memheap_align_fit(struct rt_memheap_item *item, rt_uint32_t size, rt_size_t align)
+{
+    rt_ubase_t data, aligned;
+
+    /* the leading fragment shall be able to be a free block */
+    data    = (rt_ubase_t)item + RT_MEMHEAP_SIZE;
+    aligned = RT_ALIGN(data, align);
+    while (aligned != data && aligned - data < RT_MEMHEAP_SIZE + RT_MEMHEAP_MINIALLOC)
+        aligned += align;
+
+    if (aligned + size > (rt_ubase_t)item->next)
+        return 0;
+
+    return aligned;
+}
+
+/* find a free memory block which has size bytes at an aligned address */
+static struct rt_memheap_item *_memheap_free_find_align(struct rt_memheap *heap, rt_uint32_t size,
+                                                        rt_size_t align, rt_ubase_t *aligned)
+{
+    struct rt_memheap_item *item;
+#ifdef RT_USING_MEMHEAP_BINS
+    int bin;
+
+    for (bin = _memheap_bin(size); bin < RT_MEMHEAP_BINS; bin ++)
+    {
+        if (!(heap->bin_bitmap & (1UL << bin)))
+            continue;
+
+        for (item = heap->bin[bin]; item != RT_NULL; item = item->next_free)
+        {
+            *aligned = _memheap_align_fit(item, size, align);
+            if (*aligned != 0)
+                return item;
+        }
+    }
+#else
+    for (item = heap->free_list->next_free; item != heap->free_list; item = item->next_free)
+    {
+        *aligned = _memheap_align_fit(item, size, align);
+        if (*aligned != 0)
+            return item;
+    }
+#endif
+
+    return RT_NULL;
+}
+
 /*
  * The initialized memory pool will be:
  * +-----------------------------------+--------------------------+
@@ -76,6 +248,14 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
     /* set the free list to free list header */
     memheap->free_list = item;
 
+#ifdef RT_USING_MEMHEAP_BINS
+    rt_memset(memheap->bin, 0, sizeof(memheap->bin));
+    memheap->bin_bitmap = 0;
+#endif
+#ifdef RT_USING_HEAP_INFO
+    rt_memset(&memheap->stat, 0, sizeof(memheap->stat));
+#endif
+
     /* initialize the first big memory block */
     item            = (struct rt_memheap_item *)start_addr;
     item->magic     = RT_MEMHEAP_MAGIC;
@@ -93,10 +273,7 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
     memheap->block_list = item;
 
     /* place the big memory block to free list */
-    item->next_free = memheap->free_list->next_free;
-    item->prev_free = memheap->free_list;
-    memheap->free_list->next_free->prev_free = item;
-    memheap->free_list->next_free            = item;
+    _memheap_free_insert(memheap, item);
 
     /* move to the end of memory pool to build a small tailer block,
      * which prevents block merging
@@ -113,6 +290,12 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
     /* initialize semaphore lock */
     rt_sem_init(&(memheap->lock), name, 1, RT_IPC_FLAG_FIFO);
 
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+    memheap->region_flags   = 0;
+    memheap->alloc_count    = 0;
+    memheap->fallback_count = 0;
+#endif
+
     RT_DEBUG_LOG(RT_DEBUG_MEMHEAP,
                  ("memory heap: start addr 0x%08x, size %d, free list header 0x%08x\n",
                   start_addr, size, &(memheap->free_header)));
@@ -120,12 +303,21 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
     return RT_EOK;
 }
 
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+static void _heap_region_remove(struct rt_memheap *heap);
+#endif
+
 rt_err_t rt_memheap_detach(struct rt_memheap *heap)
 {
     RT_ASSERT(heap);
     RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
     RT_ASSERT(rt_object_is_systemobject(&heap->parent));
 
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+    if (heap->region_flags & RT_MEM_REGION)
+        _heap_region_remove(heap);
+#endif
+
     rt_sem_detach(&heap->lock);
     rt_object_detach(&(heap->parent));
 
@@ -133,6 +325,85 @@ rt_err_t rt_memheap_detach(struct rt_memheap *heap)
     return RT_EOK;
 }
 
+/*
+ * take size bytes from a free memory block in free list, the rest of block is
+ * split into a new free block if it is large enough.
+ */
+static void _memheap_take(struct rt_memheap *heap, struct rt_memheap_item *header_ptr, rt_uint32_t size)
+{
+    rt_uint32_t free_size;
+
+    free_size = MEMITEM_SIZE(header_ptr);
+    RT_ASSERT(free_size >= size);
+
+    /* determine if the block needs to be split. */
+    if (free_size >= (size + RT_MEMHEAP_SIZE + RT_MEMHEAP_MINIALLOC))
+    {
+        struct rt_memheap_item *new_ptr;
+
+        /* remove header ptr from free list */
+        _memheap_free_remove(heap, header_ptr);
+
+        /* split the block. */
+        new_ptr = (struct rt_memheap_item *)
+                  (((rt_uint8_t *)header_ptr) + size + RT_MEMHEAP_SIZE);
+
+        RT_DEBUG_LOG(RT_DEBUG_MEMHEAP,
+                     ("split: block[0x%08x] nextm[0x%08x] prevm[0x%08x] to new[0x%08x]\n",
+                      header_ptr,
+                      header_ptr->next,
+                      header_ptr->prev,
+                      new_ptr));
+
+        /* mark the new block as a memory block and freed. */
+        new_ptr->magic = RT_MEMHEAP_MAGIC;
+
+        /* put the pool pointer into the new block. */
+        new_ptr->pool_ptr = heap;
+
+        /* break down the block list */
+        new_ptr->prev          = header_ptr;
+        new_ptr->next          = header_ptr->next;
+        header_ptr->next->prev = new_ptr;
+        header_ptr->next       = new_ptr;
+
+        /* insert new_ptr to free list */
+        _memheap_free_insert(heap, new_ptr);
+        RT_DEBUG_LOG(RT_DEBUG_MEMHEAP, ("new ptr: next_free 0x%08x, prev_free 0x%08x\n",
+                                        new_ptr->next_free,
+                                        new_ptr->prev_free));
+
+        /* decrement the available byte count.  */
+        heap->available_size = heap->available_size -
+                               size -
+                               RT_MEMHEAP_SIZE;
+        if (heap->pool_size - heap->available_size > heap->max_used_size)
+            heap->max_used_size = heap->pool_size - heap->available_size;
+    }
+    else
+    {
+        /* decrement the entire free size from the available bytes count. */
+        heap->available_size = heap->available_size - free_size;
+        if (heap->pool_size - heap->available_size > heap->max_used_size)
+            heap->max_used_size = heap->pool_size - heap->available_size;
+
+        /* remove header_ptr from free list */
+        RT_DEBUG_LOG(RT_DEBUG_MEMHEAP,
+                     ("one block: block[0x%08x], next_free 0x%08x, prev_free 0x%08x\n",
+                      header_ptr,
+                      header_ptr->next_free,
+                      header_ptr->prev_free));
+
+        _memheap_free_remove(heap, header_ptr);
+    }
+
+    /* Mark the allocated block as not available. */
+    header_ptr->magic |= RT_MEMHEAP_USED;
+#ifdef RT_USING_HEAP_INFO
+    header_ptr->owner = RT_NULL;
+#endif
+}
+
 void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
 {
     rt_err_t result;
@@ -164,96 +435,15 @@ void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
             return RT_NULL;
         }
 
-        /* get the first free memory block */
-        header_ptr = heap->free_list->next_free;
-        while (header_ptr != heap->free_list && free_size < size)
-        {
-            /* get current freed memory block size */
+        header_ptr = _memheap_free_find(heap, size);
+        if (header_ptr != RT_NULL)
             free_size = MEMITEM_SIZE(header_ptr);
-            if (free_size < size)
-            {
-                /* move to next free memory block */
-                header_ptr = header_ptr->next_free;
-            }
-        }
 
         /* determine if the memory is available. */
         if (free_size >= size)
         {
             /* a block that satisfies the request has been found. */
-
-            /* determine if the block needs to be split. */
-            if (free_size >= (size + RT_MEMHEAP_SIZE + RT_MEMHEAP_MINIALLOC))
-            {
-                struct rt_memheap_item *new_ptr;
-
-                /* split the block. */
-                new_ptr = (struct rt_memheap_item *)
-                          (((rt_uint8_t *)header_ptr) + size + RT_MEMHEAP_SIZE);
-
-                RT_DEBUG_LOG(RT_DEBUG_MEMHEAP,
-                             ("split: block[0x%08x] nextm[0x%08x] prevm[0x%08x] to new[0x%08x]\n",
-                              header_ptr,
-                              header_ptr->next,
-                              header_ptr->prev,
-                              new_ptr));
-
-                /* mark the new block as a memory block and freed. */
-                new_ptr->magic = RT_MEMHEAP_MAGIC;
-
-                /* put the pool pointer into the new block. */
-                new_ptr->pool_ptr = heap;
-
-                /* break down the block list */
-                new_ptr->prev          = header_ptr;
-                new_ptr->next          = header_ptr->next;
-                header_ptr->next->prev = new_ptr;
-                header_ptr->next       = new_ptr;
-
-                /* remove header ptr from free list */
-                header_ptr->next_free->prev_free = header_ptr->prev_free;
-                header_ptr->prev_free->next_free = header_ptr->next_free;
-                header_ptr->next_free = RT_NULL;
-                header_ptr->prev_free = RT_NULL;
-
-                /* insert new_ptr to free list */
-                new_ptr->next_free = heap->free_list->next_free;
-                new_ptr->prev_free = heap->free_list;
-                heap->free_list->next_free->prev_free = new_ptr;
-                heap->free_list->next_free            = new_ptr;
-                RT_DEBUG_LOG(RT_DEBUG_MEMHEAP, ("new ptr: next_free 0x%08x, prev_free 0x%08x\n",
-                                                new_ptr->next_free,
-                                                new_ptr->prev_free));
-
-                /* decrement the available byte count.  */
-                heap->available_size = heap->available_size -
-                                       size -
-                                       RT_MEMHEAP_SIZE;
-                if (heap->pool_size - heap->available_size > heap->max_used_size)
-                    heap->max_used_size = heap->pool_size - heap->available_size;
-            }
-            else
-            {
-                /* decrement the entire free size from the available bytes count. */
-                heap->available_size = heap->available_size - free_size;
-                if (heap->pool_size - heap->available_size > heap->max_used_size)
-                    heap->max_used_size = heap->pool_size - heap->available_size;
-
-                /* remove header_ptr from free list */
-                RT_DEBUG_LOG(RT_DEBUG_MEMHEAP,
-                             ("one block: block[0x%08x], next_free 0x%08x, prev_free 0x%08x\n",
-                              header_ptr,
-                              header_ptr->next_free,
-                              header_ptr->prev_free));
-
-                header_ptr->next_free->prev_free = header_ptr->prev_free;
-                header_ptr->prev_free->next_free = header_ptr->next_free;
-                header_ptr->next_free = RT_NULL;
-                header_ptr->prev_free = RT_NULL;
-            }
-
-            /* Mark the allocated block as not available. */
-            header_ptr->magic |= RT_MEMHEAP_USED;
+            _memheap_take(heap, header_ptr, size);
 
             /* release lock */
             rt_sem_release(&(heap->lock));
@@ -278,32 +468,116 @@ void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
     return RT_NULL;
 }
 
-void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
+/**
+ * This function will allocate a memory block at an aligned address from a
+ * memory heap. The leading fragment before the aligned block is kept in
+ * heap as a free block, and the memory block can be released by
+ * rt_memheap_free.
+ *
+ * @param heap the memory heap
+ * @param size the size of memory block
+ * @param align the alignment size, shall be power of 2
+ *
+ * @return the allocated memory block on successful, otherwise RT_NULL
+ */
+void *rt_memheap_alloc_align(struct rt_memheap *heap, rt_size_t size, rt_size_t align)
 {
     rt_err_t result;
-    rt_size_t oldsize;
-    struct rt_memheap_item *header_ptr;
-    struct rt_memheap_item *new_ptr;
+    rt_ubase_t aligned;
+    struct rt_memheap_item *header_ptr, *new_ptr;
 
-    RT_ASSERT(heap);
+    RT_ASSERT(heap != RT_NULL);
     RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
+    RT_ASSERT((align & (align - 1)) == 0);
 
-    if (newsize == 0)
+    if (align <= RT_ALIGN_SIZE)
+        return rt_memheap_alloc(heap, size);
+
+    /* align allocated size */
+    size = RT_ALIGN(size, RT_ALIGN_SIZE);
+    if (size < RT_MEMHEAP_MINIALLOC)
+        size = RT_MEMHEAP_MINIALLOC;
+
+    if (size >= heap->available_size)
+        return RT_NULL;
+
+    /* lock memheap */
+    result = rt_sem_take(&(heap->lock), RT_WAITING_FOREVER);
+    if (result != RT_EOK)
     {
-        rt_memheap_free(ptr);
+        rt_set_errno(result);
 
         return RT_NULL;
     }
+
+    header_ptr = _memheap_free_find_align(heap, size, align, &aligned);
+    if (header_ptr == RT_NULL)
+    {
+        /* release lock */
+        rt_sem_release(&(heap->lock));
+
+        return RT_NULL;
+    }
+
+    if (aligned != (rt_ubase_t)header_ptr + RT_MEMHEAP_SIZE)
+    {
+        /* split the leading fragment, which is left in the free list */
+        _memheap_free_remove(heap, header_ptr);
+
+        new_ptr = (struct rt_memheap_item *)(aligned - RT_MEMHEAP_SIZE);
+        new_ptr->magic    = RT_MEMHEAP_MAGIC;
+        new_ptr->pool_ptr = heap;
+
+        new_ptr->prev          = header_ptr;
+        new_ptr->next          = header_ptr->next;
+        header_ptr->next->prev = new_ptr;
+        header_ptr->next       = new_ptr;
+
+        _memheap_free_insert(heap, header_ptr);
+        _memheap_free_insert(heap, new_ptr);
+
+        /* the header of new block is taken from the available bytes */
+        heap->available_size = heap->available_size - RT_MEMHEAP_SIZE;
+
+        header_ptr = new_ptr;
+    }
+
+    _memheap_take(heap, header_ptr, size);
+
+    /* release lock */
+    rt_sem_release(&(heap->lock));
+
+    return (void *)aligned;
+}
+
+/**
+ * This function will change the size of a memory block without moving it.
+ * The block is shrunk in place, or grown by absorbing the free memory block
+ * next to it.
+ *
+ * @param heap the memory heap which the block belongs to
+ * @param ptr the memory block allocated from heap
+ * @param newsize the required new size
+ *
+ * @return ptr on successful, RT_NULL if the block can not be resized in
+ *         place, and the block is not changed.
+ */
+void *rt_memheap_realloc_inplace(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
+{
+    rt_err_t result;
+    rt_size_t oldsize;
+    struct rt_memheap_item *header_ptr;
+    struct rt_memheap_item *new_ptr;
+
+    RT_ASSERT(heap);
+    RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
+    RT_ASSERT(ptr != RT_NULL);
+
     /* align allocated size */
     newsize = RT_ALIGN(newsize, RT_ALIGN_SIZE);
     if (newsize < RT_MEMHEAP_MINIALLOC)
         newsize = RT_MEMHEAP_MINIALLOC;
 
-    if (ptr == RT_NULL)
-    {
-        return rt_memheap_alloc(heap, newsize);
-    }
-
     /* get memory block header and get the size of memory block */
     header_ptr = (struct rt_memheap_item *)
                  ((rt_uint8_t *)ptr - RT_MEMHEAP_SIZE);
@@ -311,7 +585,6 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
     /* re-allocate memory */
     if (newsize > oldsize)
     {
-        void *new_ptr;
         struct rt_memheap_item *next_ptr;
 
         /* lock memheap */
@@ -358,8 +631,7 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
                               next_ptr->next_free,
                               next_ptr->prev_free));
 
-                next_ptr->next_free->prev_free = next_ptr->prev_free;
-                next_ptr->prev_free->next_free = next_ptr->next_free;
+                _memheap_free_remove(heap, next_ptr);
                 next_ptr->next->prev = next_ptr->prev;
                 next_ptr->prev->next = next_ptr->next;
 
@@ -384,10 +656,7 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
                 header_ptr->next       = next_ptr;
 
                 /* insert next_ptr to free list */
-                next_ptr->next_free = heap->free_list->next_free;
-                next_ptr->prev_free = heap->free_list;
-                heap->free_list->next_free->prev_free = next_ptr;
-                heap->free_list->next_free            = next_ptr;
+                _memheap_free_insert(heap, next_ptr);
                 RT_DEBUG_LOG(RT_DEBUG_MEMHEAP, ("new ptr: next_free 0x%08x, prev_free 0x%08x",
                                                 next_ptr->next_free,
                                                 next_ptr->prev_free));
@@ -395,6 +664,22 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
                 /* release lock */
                 rt_sem_release(&(heap->lock));
 
+                return ptr;
+            }
+            else if (nextsize + oldsize + RT_MEMHEAP_SIZE >= newsize)
+            {
+                /* the rest of next node is too small to split, take it all */
+                heap->available_size = heap->available_size - nextsize;
+                if (heap->pool_size - heap->available_size > heap->max_used_size)
+                    heap->max_used_size = heap->pool_size - heap->available_size;
+
+                _memheap_free_remove(heap, next_ptr);
+                next_ptr->next->prev = header_ptr;
+                header_ptr->next     = next_ptr->next;
+
+                /* release lock */
+                rt_sem_release(&(heap->lock));
+
                 return ptr;
             }
         }
@@ -402,15 +687,7 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
         /* release lock */
         rt_sem_release(&(heap->lock));
 
-        /* re-allocate a memory block */
-        new_ptr = (void *)rt_memheap_alloc(heap, newsize);
-        if (new_ptr != RT_NULL)
-        {
-            rt_memcpy(new_ptr, ptr, oldsize < newsize ? oldsize : newsize);
-            rt_memheap_free(ptr);
-        }
-
-        return new_ptr;
+        return RT_NULL;
     }
 
     /* don't split when there is less than one node space left */
@@ -461,19 +738,15 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
                      ("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
                       header_ptr, header_ptr->next_free, header_ptr->prev_free));
 
+        /* remove free ptr from free list */
+        _memheap_free_remove(heap, free_ptr);
+
         free_ptr->next->prev = new_ptr;
         new_ptr->next   = free_ptr->next;
-
-        /* remove free ptr from free list */
-        free_ptr->next_free->prev_free = free_ptr->prev_free;
-        free_ptr->prev_free->next_free = free_ptr->next_free;
     }
 
     /* insert the split block to free list */
-    new_ptr->next_free = heap->free_list->next_free;
-    new_ptr->prev_free = heap->free_list;
-    heap->free_list->next_free->prev_free = new_ptr;
-    heap->free_list->next_free            = new_ptr;
+    _memheap_free_insert(heap, new_ptr);
     RT_DEBUG_LOG(RT_DEBUG_MEMHEAP, ("new free ptr: next_free 0x%08x, prev_free 0x%08x\n",
                                     new_ptr->next_free,
                                     new_ptr->prev_free));
@@ -488,6 +761,42 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
     return ptr;
 }
 
+void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
+{
+    void *new_ptr;
+    rt_size_t oldsize;
+
+    RT_ASSERT(heap);
+    RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
+
+    if (newsize == 0)
+    {
+        rt_memheap_free(ptr);
+
+        return RT_NULL;
+    }
+
+    if (ptr == RT_NULL)
+    {
+        return rt_memheap_alloc(heap, newsize);
+    }
+
+    /* shrink or expand memory in place */
+    if (rt_memheap_realloc_inplace(heap, ptr, newsize) != RT_NULL)
+        return ptr;
+
+    /* re-allocate a memory block */
+    oldsize = MEMITEM_SIZE(((struct rt_memheap_item *)((rt_uint8_t *)ptr - RT_MEMHEAP_SIZE)));
+    new_ptr = (void *)rt_memheap_alloc(heap, newsize);
+    if (new_ptr != RT_NULL)
+    {
+        rt_memcpy(new_ptr, ptr, oldsize < newsize ? oldsize : newsize);
+        rt_memheap_free(ptr);
+    }
+
+    return new_ptr;
+}
+
 void rt_memheap_free(void *ptr)
 {
     rt_err_t result;
@@ -529,7 +838,7 @@ void rt_memheap_free(void *ptr)
     }
 
     /* Mark the memory as available. */
-    header_ptr->magic &= ~RT_MEMHEAP_USED;
+    header_ptr->magic &= ~(RT_MEMHEAP_USED | RT_MEMHEAP_CACHED);
     /* Adjust the available number of bytes. */
     heap->available_size = heap->available_size + MEMITEM_SIZE(header_ptr);
 
@@ -542,14 +851,24 @@ void rt_memheap_free(void *ptr)
         /* adjust the available number of bytes. */
         heap->available_size = heap->available_size + RT_MEMHEAP_SIZE;
 
+#ifdef RT_USING_MEMHEAP_BINS
+        /* the merged block may belong to another free list */
+        _memheap_free_remove(heap, header_ptr->prev);
+#elif defined(RT_USING_HEAP_INFO)
+        /* the merged block is left in free list, and counted again later */
+        rt_heap_stat_del(&heap->stat, MEMITEM_SIZE(header_ptr->prev));
+#endif
+
         /* yes, merge block with previous neighbor. */
         (header_ptr->prev)->next = header_ptr->next;
         (header_ptr->next)->prev = header_ptr->prev;
 
         /* move header pointer to previous. */
         header_ptr = header_ptr->prev;
+#ifndef RT_USING_MEMHEAP_BINS
         /* don't insert header to free list */
         insert_header = 0;
+#endif
     }
 
     /* determine if the block can be merged with the next neighbor. */
@@ -565,50 +884,341 @@ void rt_memheap_free(void *ptr)
                      ("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
                       new_ptr, new_ptr->next_free, new_ptr->prev_free));
 
+        /* remove new ptr from free list */
+        _memheap_free_remove(heap, new_ptr);
+
         new_ptr->next->prev = header_ptr;
         header_ptr->next    = new_ptr->next;
-
-        /* remove new ptr from free list */
-        new_ptr->next_free->prev_free = new_ptr->prev_free;
-        new_ptr->prev_free->next_free = new_ptr->next_free;
     }
 
     if (insert_header)
     {
         /* no left merge, insert to free list */
-        header_ptr->next_free = heap->free_list->next_free;
-        header_ptr->prev_free = heap->free_list;
-        heap->free_list->next_free->prev_free = header_ptr;
-        heap->free_list->next_free            = header_ptr;
+        _memheap_free_insert(heap, header_ptr);
 
         RT_DEBUG_LOG(RT_DEBUG_MEMHEAP,
                      ("insert to free list: next_free 0x%08x, prev_free 0x%08x\n",
                       header_ptr->next_free, header_ptr->prev_free));
     }
+#ifdef RT_USING_HEAP_INFO
+    else
+    {
+        rt_heap_stat_add(&heap->stat, MEMITEM_SIZE(header_ptr));
+    }
+#endif
 
     /* release lock */
     rt_sem_release(&(heap->lock));
 }
 
 #ifdef RT_USING_MEMHEAP_AS_HEAP
+#ifndef RT_MEMHEAP_REGION_MAX
+#define RT_MEMHEAP_REGION_MAX       4               /* the maximal number of regions in system heap */
+#endif
+#ifndef RT_MEMHEAP_SYSTEM_FLAGS
+#define RT_MEMHEAP_SYSTEM_FLAGS     RT_MEM_DMA      /* attributes of the heap in rt_system_heap_init */
+#endif
+#define RT_MEM_ATTR_MASK            (RT_MEM_FAST | RT_MEM_DMA | RT_MEM_BULK)
+
 static struct rt_memheap _heap;
 
+/*
+ * The system heap set. The regions are tried in the order they are added,
+ * and also kept sorted by address to find the region of a memory block.
+ */
+static struct rt_memheap *_heap_region[RT_MEMHEAP_REGION_MAX];
+static struct rt_memheap *_heap_region_sorted[RT_MEMHEAP_REGION_MAX];
+static rt_uint8_t _heap_region_count;
+
+#ifdef RT_USING_HEAP_INFO
+/* charge an allocated memory block to current thread */
+rt_inline void _heap_charge(void *rmem)
+{
+    struct rt_memheap_item *item;
+
+    item = (struct rt_memheap_item *)((rt_uint8_t *)rmem - RT_MEMHEAP_SIZE);
+    rt_heap_stat_charge(&item->owner, MEMITEM_SIZE(item));
+}
+
+/* uncharge an allocated memory block from its owner */
+rt_inline void _heap_uncharge(void *rmem)
+{
+    struct rt_memheap_item *item;
+
+    item = (struct rt_memheap_item *)((rt_uint8_t *)rmem - RT_MEMHEAP_SIZE);
+    rt_heap_stat_uncharge(item->owner, MEMITEM_SIZE(item));
+}
+#define HEAP_CHARGE(rmem)       _heap_charge(rmem)
+#define HEAP_UNCHARGE(rmem)     _heap_uncharge(rmem)
+#else
+#define HEAP_CHARGE(rmem)       do {} while (0)
+#define HEAP_UNCHARGE(rmem)     do {} while (0)
+#endif
+
+static void _heap_region_remove(struct rt_memheap *heap)
+{
+    int index, position;
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    for (index = 0, position = 0; index < _heap_region_count; index ++)
+    {
+        if (_heap_region[index] != heap)
+            _heap_region[position ++] = _heap_region[index];
+    }
+    for (index = 0, position = 0; index < _heap_region_count; index ++)
+    {
+        if (_heap_region_sorted[index] != heap)
+            _heap_region_sorted[position ++] = _heap_region_sorted[index];
+    }
+    _heap_region_count = position;
+    heap->region_flags = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+/* get the region which a memory block belongs to, RT_NULL if not in heap set */
+static struct rt_memheap *_heap_region_of(void *ptr)
+{
+    int low, high, middle;
+    struct rt_memheap *heap;
+
+    /* binary search the last region starts before ptr */
+    low  = 0;
+    high = _heap_region_count - 1;
+    heap = RT_NULL;
+    while (low <= high)
+    {
+        middle = (low + high) / 2;
+        if ((rt_uint8_t *)_heap_region_sorted[middle]->start_addr <= (rt_uint8_t *)ptr)
+        {
+            heap = _heap_region_sorted[middle];
+            low  = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    if (heap != RT_NULL &&
+        (rt_uint8_t *)ptr >= (rt_uint8_t *)heap->start_addr + heap->pool_size)
+        heap = RT_NULL;
+
+    return heap;
+}
+
+/**
+ * This function will add a memory heap to system heap set, then the memory
+ * of heap can be allocated by rt_malloc and rt_malloc_region. The regions
+ * are tried by rt_malloc in the order they are added.
+ *
+ * @param heap the initialized memory heap
+ * @param flags the attributes of memory, RT_MEM_FAST, RT_MEM_DMA or RT_MEM_BULK
+ *
+ * @return RT_EOK on successful, -RT_EFULL if there are too many regions.
+ */
+rt_err_t rt_memheap_region_add(struct rt_memheap *heap, rt_uint32_t flags)
+{
+    int index;
+    register rt_base_t level;
+
+    RT_ASSERT(heap != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
+    RT_ASSERT(!(heap->region_flags & RT_MEM_REGION));
+
+    level = rt_hw_interrupt_disable();
+    if (_heap_region_count >= RT_MEMHEAP_REGION_MAX)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_EFULL;
+    }
+
+    heap->region_flags = (flags & RT_MEM_ATTR_MASK) | RT_MEM_REGION;
+    _heap_region[_heap_region_count] = heap;
+
+    /* insertion sort by start address */
+    for (index = _heap_region_count; index > 0; index --)
+    {
+        if ((rt_uint8_t *)_heap_region_sorted[index - 1]->start_addr < (rt_uint8_t *)heap->start_addr)
+            break;
+        _heap_region_sorted[index] = _heap_region_sorted[index - 1];
+    }
+    _heap_region_sorted[index] = heap;
+    _heap_region_count ++;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
 void rt_system_heap_init(void *begin_addr, void *end_addr)
 {
     /* initialize a default heap in the system */
     rt_memheap_init(&_heap,
                     "heap",
                     begin_addr,
-                    (rt_uint32_t)end_addr - (rt_uint32_t)begin_addr);
+                    (rt_ubase_t)end_addr - (rt_ubase_t)begin_addr);
+    rt_memheap_region_add(&_heap, RT_MEMHEAP_SYSTEM_FLAGS);
+}
+
+/* allocate from the regions of system heap set, the preferred ones first */
+static void *_heap_region_alloc(rt_size_t size, rt_uint32_t flags)
+{
+    int index;
+    void *ptr;
+    struct rt_memheap *heap;
+
+    flags &= RT_MEM_ATTR_MASK;
+
+    for (index = 0; index < _heap_region_count; index ++)
+    {
+        heap = _heap_region[index];
+        if ((heap->region_flags & flags) != flags)
+            continue;
+
+        ptr = rt_memheap_alloc(heap, size);
+        if (ptr != RT_NULL)
+        {
+            heap->alloc_count ++;
+
+            return ptr;
+        }
+    }
+
+    /* fall back to the regions without the preferred attributes */
+    for (index = 0; index < _heap_region_count; index ++)
+    {
+        heap = _heap_region[index];
+        if ((heap->region_flags & flags) == flags ||
+            (heap->region_flags & flags & RT_MEM_DMA) != (flags & RT_MEM_DMA))
+            continue;
+
+        ptr = rt_memheap_alloc(heap, size);
+        if (ptr != RT_NULL)
+        {
+            heap->alloc_count ++;
+            heap->fallback_count ++;
+
+            return ptr;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * This function will allocate a block of memory from the regions of system
+ * heap set with the requested attributes.
+ *
+ * The regions with all requested attributes are tried first, in the order
+ * they are added. Then the other regions are tried, except RT_MEM_DMA is
+ * requested and the region is not accessible by DMA.
+ *
+ * @param size the size of memory to be allocated
+ * @param flags the requested attributes, RT_MEM_FAST, RT_MEM_DMA or RT_MEM_BULK
+ *
+ * @return the allocated memory block on successful, otherwise return RT_NULL
+ */
+void *rt_malloc_region(rt_size_t size, rt_uint32_t flags)
+{
+    void *ptr;
+
+    ptr = _heap_region_alloc(size, flags);
+    if (ptr != RT_NULL)
+    {
+        HEAP_CHARGE(ptr);
+        RT_HEAP_PROFILE_ALLOC(ptr, size);
+    }
+
+    return ptr;
+}
+
+#ifdef RT_USING_HEAP_MAGAZINE
+/* allocate a chunk for magazine, the heap shall be locked */
+static void *_memheap_refill(void *heap, rt_size_t size)
+{
+    struct rt_memheap_item *header_ptr;
+
+    header_ptr = _memheap_free_find((struct rt_memheap *)heap, size);
+    if (header_ptr == RT_NULL || MEMITEM_SIZE(header_ptr) < size)
+        return RT_NULL;
+
+    _memheap_take((struct rt_memheap *)heap, header_ptr, size);
+    header_ptr->magic |= RT_MEMHEAP_CACHED;
+
+    return (void *)((rt_uint8_t *)header_ptr + RT_MEMHEAP_SIZE);
+}
+
+/* release the chunks taken out of magazines */
+static void _memheap_release_list(void *list)
+{
+    void *rmem;
+
+    while (list != RT_NULL)
+    {
+        rmem = list;
+        list = *(void **)list;
+        rt_memheap_free(rmem);
+    }
 }
+#endif
 
 void *rt_malloc(rt_size_t size)
 {
     void *ptr;
+    rt_size_t chunk_size;
+#ifdef RT_USING_HEAP_MAGAZINE
+    void *flush;
+    struct rt_memheap_item *header_ptr;
+#endif
 
-    /* try to allocate in system heap */
-    ptr = rt_memheap_alloc(&_heap, size);
+    chunk_size = size;
+#ifdef RT_USING_HEAP_MAGAZINE
+    ptr = rt_heap_magazine_get(&chunk_size);
+    if (ptr != RT_NULL)
+    {
+        header_ptr = (struct rt_memheap_item *)((rt_uint8_t *)ptr - RT_MEMHEAP_SIZE);
+        RT_ASSERT(header_ptr->magic == (RT_MEMHEAP_MAGIC | RT_MEMHEAP_USED | RT_MEMHEAP_CACHED));
+        header_ptr->magic &= ~RT_MEMHEAP_CACHED;
+        HEAP_CHARGE(ptr);
+        RT_HEAP_PROFILE_ALLOC(ptr, size);
+
+        return ptr;
+    }
+#endif
+
+    /* try to allocate in system heap set */
+    ptr = _heap_region_alloc(chunk_size, 0);
+#ifdef RT_USING_HEAP_MAGAZINE
     if (ptr == RT_NULL)
+    {
+        /* return the cached chunks to heap and try again */
+        flush = rt_heap_magazine_drain();
+        if (flush != RT_NULL)
+        {
+            _memheap_release_list(flush);
+            ptr = _heap_region_alloc(chunk_size, 0);
+        }
+    }
+    else if (chunk_size <= RT_HEAP_MAGAZINE_MAX)
+    {
+        struct rt_memheap *heap;
+
+        /* fill the magazine from the same region */
+        heap = ((struct rt_memheap_item *)((rt_uint8_t *)ptr - RT_MEMHEAP_SIZE))->pool_ptr;
+        if (rt_sem_take(&(heap->lock), RT_WAITING_FOREVER) == RT_EOK)
+        {
+            rt_heap_magazine_fill(heap, chunk_size, _memheap_refill);
+            rt_sem_release(&(heap->lock));
+        }
+    }
+#endif
+    if (ptr != RT_NULL)
+    {
+        HEAP_CHARGE(ptr);
+        RT_HEAP_PROFILE_ALLOC(ptr, size);
+    }
+    else
     {
         struct rt_object *object;
         struct rt_list_node *node;
@@ -628,21 +1238,113 @@ void *rt_malloc(rt_size_t size)
             RT_ASSERT(heap);
             RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
 
-            /* not allocate in the default system heap */
-            if (heap == &_heap)
+            /* the regions of system heap set have been tried */
+            if (heap->region_flags & RT_MEM_REGION)
                 continue;
 
             ptr = rt_memheap_alloc(heap, size);
             if (ptr != RT_NULL)
+            {
+                HEAP_CHARGE(ptr);
+                RT_HEAP_PROFILE_ALLOC(ptr, size);
                 break;
+            }
+        }
+    }
+
+    return ptr;
+}
+
+void *rt_malloc_align(rt_size_t size, rt_size_t align)
+{
+    int index;
+    void *ptr = RT_NULL;
+    struct rt_memheap *heap;
+    struct rt_object *object;
+    struct rt_list_node *node;
+    struct rt_object_information *information;
+
+    /* try to allocate in system heap set */
+    for (index = 0; index < _heap_region_count; index ++)
+    {
+        heap = _heap_region[index];
+        ptr = rt_memheap_alloc_align(heap, size, align);
+        if (ptr != RT_NULL)
+        {
+            heap->alloc_count ++;
+            HEAP_CHARGE(ptr);
+            RT_HEAP_PROFILE_ALLOC(ptr, size);
+
+            return ptr;
+        }
+    }
+
+    /* try to allocate on other memory heap */
+    information = rt_object_get_information(RT_Object_Class_MemHeap);
+    RT_ASSERT(information != RT_NULL);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        heap   = (struct rt_memheap *)object;
+
+        if (heap->region_flags & RT_MEM_REGION)
+            continue;
+
+        ptr = rt_memheap_alloc_align(heap, size, align);
+        if (ptr != RT_NULL)
+        {
+            HEAP_CHARGE(ptr);
+            RT_HEAP_PROFILE_ALLOC(ptr, size);
+            break;
         }
     }
 
     return ptr;
 }
 
+void rt_free_align(void *ptr)
+{
+    rt_free(ptr);
+}
+
 void rt_free(void *rmem)
 {
+    struct rt_memheap *heap;
+#ifdef RT_USING_HEAP_MAGAZINE
+    void *flush;
+    struct rt_memheap_item *header_ptr;
+#endif
+
+    if (rmem == RT_NULL) return;
+
+    HEAP_UNCHARGE(rmem);
+    RT_HEAP_PROFILE_FREE(rmem);
+
+    /* the block in a region shall be allocated from that region */
+    heap = _heap_region_of(rmem);
+    RT_ASSERT(heap == RT_NULL ||
+              ((struct rt_memheap_item *)((rt_uint8_t *)rmem - RT_MEMHEAP_SIZE))->pool_ptr == heap);
+
+#ifdef RT_USING_HEAP_MAGAZINE
+    /* only the chunks of system heap set are cached for rt_malloc */
+    if (heap != RT_NULL)
+    {
+        header_ptr = (struct rt_memheap_item *)((rt_uint8_t *)rmem - RT_MEMHEAP_SIZE);
+        /* a cached block freed again is not in a used state */
+        RT_ASSERT(header_ptr->magic == (RT_MEMHEAP_MAGIC | RT_MEMHEAP_USED));
+        header_ptr->magic |= RT_MEMHEAP_CACHED;
+        if (rt_heap_magazine_put(rmem, MEMITEM_SIZE(header_ptr), &flush) == RT_EOK)
+        {
+            /* release the chunks drained from magazine */
+            _memheap_release_list(flush);
+
+            return;
+        }
+    }
+#endif
+
     rt_memheap_free(rmem);
 }
 
@@ -650,9 +1352,18 @@ void *rt_realloc(void *rmem, rt_size_t newsize)
 {
     void *new_ptr;
     struct rt_memheap_item *header_ptr;
+#ifdef RT_USING_HEAP_INFO
+    rt_thread_t owner;
+    rt_size_t usable;
+#endif
 
     if (rmem == RT_NULL)
-        return rt_malloc(newsize);
+    {
+        new_ptr = rt_malloc(newsize);
+        RT_HEAP_PROFILE_CALLER(new_ptr);
+
+        return new_ptr;
+    }
 
     if (newsize == 0)
     {
@@ -664,15 +1375,38 @@ void *rt_realloc(void *rmem, rt_size_t newsize)
     header_ptr = (struct rt_memheap_item *)
                  ((rt_uint8_t *)rmem - RT_MEMHEAP_SIZE);
 
+#ifdef RT_USING_HEAP_INFO
+    /* the old block is released if it is moved */
+    owner  = header_ptr->owner;
+    usable = MEMITEM_SIZE(header_ptr);
+#endif
     new_ptr = rt_memheap_realloc(header_ptr->pool_ptr, rmem, newsize);
+    if (new_ptr != RT_NULL)
+    {
+#ifdef RT_USING_HEAP_INFO
+        rt_heap_stat_uncharge(owner, usable);
+#endif
+        HEAP_CHARGE(new_ptr);
+    }
+    if (new_ptr != RT_NULL && new_ptr != rmem)
+    {
+        /* the block is moved inside its memheap */
+        RT_HEAP_PROFILE_FREE(rmem);
+        RT_HEAP_PROFILE_ALLOC(new_ptr, newsize);
+    }
     if (new_ptr == RT_NULL && newsize != 0)
     {
-        /* allocate memory block from other memheap */
-        new_ptr = rt_malloc(newsize);
+        /* allocate memory block from other memheap with the same attributes */
+        if (header_ptr->pool_ptr->region_flags & RT_MEM_REGION)
+            new_ptr = rt_malloc_region(newsize, header_ptr->pool_ptr->region_flags);
+        else
+            new_ptr = rt_malloc(newsize);
         if (new_ptr != RT_NULL && rmem != RT_NULL)
         {
             rt_size_t oldsize;
 
+            RT_HEAP_PROFILE_CALLER(new_ptr);
+
             /* get the size of old memory block */
             oldsize = MEMITEM_SIZE(header_ptr);
             if (newsize > oldsize)
@@ -687,6 +1421,31 @@ void *rt_realloc(void *rmem, rt_size_t newsize)
     return new_ptr;
 }
 
+void *rt_realloc_inplace(void *rmem, rt_size_t newsize)
+{
+    struct rt_memheap_item *header_ptr;
+#ifdef RT_USING_HEAP_INFO
+    rt_size_t usable;
+#endif
+
+    RT_ASSERT(rmem != RT_NULL);
+
+    header_ptr = (struct rt_memheap_item *)
+                 ((rt_uint8_t *)rmem - RT_MEMHEAP_SIZE);
+
+#ifdef RT_USING_HEAP_INFO
+    usable = MEMITEM_SIZE(header_ptr);
+#endif
+    if (rt_memheap_realloc_inplace(header_ptr->pool_ptr, rmem, newsize) == RT_NULL)
+        return RT_NULL;
+#ifdef RT_USING_HEAP_INFO
+    rt_heap_stat_uncharge(header_ptr->owner, usable);
+#endif
+    HEAP_CHARGE(rmem);
+
+    return rmem;
+}
+
 void *rt_calloc(rt_size_t count, rt_size_t size)
 {
     void *ptr;
@@ -694,6 +1453,7 @@ void *rt_calloc(rt_size_t count, rt_size_t size)
 
     total_size = count * size;
     ptr = rt_malloc(total_size);
+    RT_HEAP_PROFILE_CALLER(ptr);
     if (ptr != RT_NULL)
     {
         /* clean memory */
@@ -707,16 +1467,71 @@ void rt_memory_info(rt_uint32_t *total,
                     rt_uint32_t *used,
                     rt_uint32_t *max_used)
 {
+    int index;
+    rt_uint32_t total_size = 0, used_size = 0, max_used_size = 0;
+
+    /* the sum of all regions in system heap set */
+    for (index = 0; index < _heap_region_count; index ++)
+    {
+        total_size    += _heap_region[index]->pool_size;
+        used_size     += _heap_region[index]->pool_size - _heap_region[index]->available_size;
+        max_used_size += _heap_region[index]->max_used_size;
+    }
+
     if (total != RT_NULL)
-        *total = _heap.pool_size;
+        *total = total_size;
 
     if (used  != RT_NULL)
-        *used = _heap.pool_size - _heap.available_size;
+        *used = used_size;
 
     if (max_used != RT_NULL)
-        *max_used = _heap.max_used_size;
+        *max_used = max_used_size;
 }
 
+#ifdef RT_USING_HEAP_INFO
+/**
+ * This function will get the introspection information of system heap, which
+ * is the sum of all regions in system heap set.
+ *
+ * @param info the heap information
+ */
+void rt_heap_info_get(struct rt_heap_info *info)
+{
+    int index;
+    struct rt_memheap *heap;
+    struct rt_memheap_item *item;
+
+    RT_ASSERT(info != RT_NULL);
+
+    rt_memset(info, 0, sizeof(struct rt_heap_info));
+
+    for (index = 0; index < _heap_region_count; index ++)
+    {
+        heap = _heap_region[index];
+        if (rt_sem_take(&(heap->lock), RT_WAITING_FOREVER) != RT_EOK)
+            continue;
+
+        if (rt_heap_stat_largest_lost(&heap->stat))
+        {
+            item = heap->block_list;
+            do
+            {
+                if (!RT_MEMHEAP_IS_USED(item))
+                    rt_heap_stat_largest_found(&heap->stat, MEMITEM_SIZE(item));
+                item = item->next;
+            }
+            while (item != heap->block_list);
+        }
+
+        info->total    += heap->pool_size;
+        info->used     += heap->pool_size - heap->available_size;
+        info->max_used += heap->max_used_size;
+        rt_heap_stat_merge(&heap->stat, info);
+        rt_sem_release(&(heap->lock));
+    }
+}
+#endif
+
 #endif
 
 #endif
@@ -22,8 +22,8 @@
 #ifdef RT_USING_MEMPOOL
 
 #ifdef RT_USING_HOOK
-static void (*rt_mp_alloc_hook)(struct rt_mempool *mp, void *block);
-static void (*rt_mp_free_hook)(struct rt_mempool *mp, void *block);
+static RT_OBJECT_HOOK_LIST(struct rt_mempool *mp, void *block) rt_mp_alloc_hook;
+static RT_OBJECT_HOOK_LIST(struct rt_mempool *mp, void *block) rt_mp_free_hook;
 
 /**
  * @addtogroup Hook
@@ -36,10 +36,32 @@ static void (*rt_mp_free_hook)(struct rt_mempool *mp, void *block);
  * block is allocated from memory pool.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void rt_mp_alloc_sethook(void (*hook)(struct rt_mempool *mp, void *block))
+rt_err_t rt_mp_alloc_sethook(void (*hook)(struct rt_mempool *mp, void *block))
 {
-    rt_mp_alloc_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_mp_alloc_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_mp_alloc_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_mp_alloc_delhook(void (*hook)(struct rt_mempool *mp, void *block))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_mp_alloc_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -47,10 +69,32 @@ void rt_mp_alloc_sethook(void (*hook)(struct rt_mempool *mp, void *block))
  * block is released to memory pool.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
+ */
+rt_err_t rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_mp_free_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_mp_free_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
  */
-void rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block))
+rt_err_t rt_mp_free_delhook(void (*hook)(struct rt_mempool *mp, void *block))
 {
-    rt_mp_free_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_mp_free_hook, hook, result);
+
+    return result;
 }
 
 /**@}*/
@@ -62,36 +106,15 @@ void rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block))
 
 /**@{*/
 
-/**
- * This function will initialize a memory pool object, normally which is used
- * for static object.
- *
- * @param mp the memory pool object
- * @param name the name of memory pool
- * @param start the star address of memory pool
- * @param size the total size of memory pool
- * @param block_size the size for each block
- *
- * @return RT_EOK
- */
-rt_err_t rt_mp_init(struct rt_mempool *mp,
-                    const char        *name,
-                    void              *start,
-                    rt_size_t          size,
-                    rt_size_t          block_size)
+/* initialize the blocks of memory pool, the object is not touched */
+static void _mp_block_init(struct rt_mempool *mp,
+                           void              *start,
+                           rt_size_t          size,
+                           rt_size_t          block_size)
 {
     rt_uint8_t *block_ptr;
     register rt_size_t offset;
 
-    /* parameter check */
-    RT_ASSERT(mp != RT_NULL);
-    RT_ASSERT(name != RT_NULL);
-    RT_ASSERT(start != RT_NULL);
-    RT_ASSERT(size > 0 && block_size > 0);
-
-    /* initialize object */
-    rt_object_init(&(mp->parent), RT_Object_Class_MemPool, name);
-
     /* initialize memory pool */
     mp->start_address = start;
     mp->size = RT_ALIGN_DOWN(size, RT_ALIGN_SIZE);
@@ -103,6 +126,7 @@ rt_err_t rt_mp_init(struct rt_mempool *mp,
     /* align to align size byte */
     mp->block_total_count = mp->size / (mp->block_size + sizeof(rt_uint8_t *));
     mp->block_free_count  = mp->block_total_count;
+    mp->block_used_max    = 0;
 
     /* initialize suspended thread list */
     rt_list_init(&(mp->suspend_thread));
@@ -119,6 +143,36 @@ rt_err_t rt_mp_init(struct rt_mempool *mp,
         RT_NULL;
 
     mp->block_list = block_ptr;
+}
+
+/**
+ * This function will initialize a memory pool object, normally which is used
+ * for static object.
+ *
+ * @param mp the memory pool object
+ * @param name the name of memory pool
+ * @param start the star address of memory pool
+ * @param size the total size of memory pool
+ * @param block_size the size for each block
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_mp_init(struct rt_mempool *mp,
+                    const char        *name,
+                    void              *start,
+                    rt_size_t          size,
+                    rt_size_t          block_size)
+{
+    /* parameter check */
+    RT_ASSERT(mp != RT_NULL);
+    RT_ASSERT(name != RT_NULL);
+    RT_ASSERT(start != RT_NULL);
+    RT_ASSERT(size > 0 && block_size > 0);
+
+    /* initialize object */
+    rt_object_init(&(mp->parent), RT_Object_Class_MemPool, name);
+
+    _mp_block_init(mp, start, size, block_size);
 
     return RT_EOK;
 }
@@ -217,6 +271,7 @@ rt_mp_t rt_mp_create(const char *name,
 
     mp->block_total_count = block_count;
     mp->block_free_count  = mp->block_total_count;
+    mp->block_used_max    = 0;
 
     /* initialize suspended thread list */
     rt_list_init(&(mp->suspend_thread));
@@ -339,10 +394,7 @@ void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time)
             before_sleep = rt_tick_get();
 
             /* init thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &time);
-            rt_timer_start(&(thread->thread_timer));
+            rt_thread_timeout_start(thread, time);
         }
 
         /* enable interrupt */
@@ -366,6 +418,8 @@ void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time)
 
     /* memory block is available. decrease the free block counter */
     mp->block_free_count--;
+    if (mp->block_total_count - mp->block_free_count > mp->block_used_max)
+        mp->block_used_max = mp->block_total_count - mp->block_free_count;
 
     /* get block from block list */
     block_ptr = mp->block_list;
@@ -443,6 +497,370 @@ void rt_mp_free(void *block)
     rt_hw_interrupt_enable(level);
 }
 
+#ifdef RT_USING_MPSET
+/**
+ * This function will initialize an empty memory pool set.
+ *
+ * @param set the memory pool set
+ */
+void rt_mpset_init(rt_mpset_t set)
+{
+    RT_ASSERT(set != RT_NULL);
+
+    rt_memset(set, 0, sizeof(struct rt_mpset));
+}
+
+/**
+ * This function will add a memory pool to a memory pool set, as the size
+ * class of its block size. The block size shall be a power of two and
+ * different from the other memory pools of the set.
+ *
+ * @param set the memory pool set
+ * @param mp the memory pool
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the set is full, -RT_EINVAL if
+ *         the block size is not a power of two or is already in the set
+ */
+rt_err_t rt_mpset_add(rt_mpset_t set, rt_mp_t mp)
+{
+    register rt_base_t level;
+    int index, pos;
+
+    RT_ASSERT(set != RT_NULL);
+    RT_ASSERT(mp != RT_NULL);
+
+    if ((mp->block_size & (mp->block_size - 1)) != 0)
+        return -RT_EINVAL;
+
+    level = rt_hw_interrupt_disable();
+
+    if (set->count >= RT_MPSET_CLASSES)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_EFULL;
+    }
+
+    /* keep the memory pools sorted by block size */
+    for (pos = 0; pos < set->count && set->mp[pos]->block_size < mp->block_size; pos ++);
+    if (pos < set->count && set->mp[pos]->block_size == mp->block_size)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_EINVAL;
+    }
+
+    for (index = set->count; index > pos; index --)
+        set->mp[index] = set->mp[index - 1];
+    set->mp[pos] = mp;
+    set->count ++;
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will allocate a block from the smallest size class of a
+ * memory pool set which fits the size. When the class is exhausted, the
+ * block is taken from a larger class, and the thread waits on the class
+ * only when all larger classes are exhausted too.
+ *
+ * @param set the memory pool set
+ * @param size the size of memory block
+ * @param time the waiting time
+ *
+ * @return the allocated memory block or RT_NULL on allocated failed
+ */
+void *rt_mpset_alloc(rt_mpset_t set, rt_size_t size, rt_int32_t time)
+{
+    void *block;
+    int index, fit;
+
+    RT_ASSERT(set != RT_NULL);
+
+    for (fit = 0; fit < set->count && set->mp[fit]->block_size < size; fit ++);
+    if (fit == set->count)
+    {
+        rt_set_errno(-RT_ENOMEM);
+
+        return RT_NULL;
+    }
+
+    for (index = fit; index < set->count; index ++)
+    {
+        if (set->mp[index]->block_free_count == 0)
+            continue;
+
+        block = rt_mp_alloc(set->mp[index], RT_WAITING_NO);
+        if (block != RT_NULL)
+            return block;
+    }
+
+    return rt_mp_alloc(set->mp[fit], time);
+}
+
+/**
+ * This function will release a memory block to the memory pool of a memory
+ * pool set which it is allocated from. It can be called in interrupt.
+ *
+ * @param block the address of memory block to be released
+ */
+void rt_mpset_free(void *block)
+{
+    rt_mp_free(block);
+}
+#endif
+
+#if defined(RT_USING_KMEM_CACHE) && defined(RT_USING_HEAP)
+/*
+ * The slab of object cache, a memory pool and its blocks in one memory
+ * block allocated from system heap.
+ */
+struct rt_kmem_slab
+{
+    rt_list_t         list;                             /**< node in slab list of cache */
+    struct rt_mempool mp;                               /**< memory pool of the objects */
+};
+
+#define KMEM_SLAB_HEADER_SIZE   RT_ALIGN(sizeof(struct rt_kmem_slab), RT_ALIGN_SIZE)
+
+/* get the slab which the object belongs to */
+rt_inline struct rt_kmem_slab *_kmem_slab_of(void *object)
+{
+    struct rt_mempool *mp;
+
+    mp = (struct rt_mempool *)*(rt_uint8_t **)((rt_uint8_t *)object - sizeof(rt_uint8_t *));
+
+    return rt_container_of(mp, struct rt_kmem_slab, mp);
+}
+
+/* get the size of memory pool in one slab */
+rt_inline rt_size_t _kmem_slab_pool_size(rt_kmem_cache_t cache)
+{
+    rt_size_t block_size;
+
+    block_size = RT_ALIGN(cache->object_size, RT_ALIGN_SIZE) + sizeof(rt_uint8_t *);
+
+    /* _mp_block_init aligns down the pool size */
+    return RT_ALIGN(block_size * cache->slab_objects, RT_ALIGN_SIZE);
+}
+
+/* allocate a new slab from system heap */
+static struct rt_kmem_slab *_kmem_slab_create(rt_kmem_cache_t cache)
+{
+    struct rt_kmem_slab *slab;
+
+    slab = (struct rt_kmem_slab *)RT_KERNEL_MALLOC(KMEM_SLAB_HEADER_SIZE +
+                                                   _kmem_slab_pool_size(cache));
+    if (slab == RT_NULL)
+        return RT_NULL;
+
+    /*
+     * the pool of slab is not an object in the object container, its header
+     * is initialized as rt_object_allocate does for the memory pool hooks.
+     */
+    rt_memset(&(slab->mp.parent), 0x0, sizeof(slab->mp.parent));
+    slab->mp.parent.type = RT_Object_Class_MemPool;
+#ifdef RT_USING_OBJECT_NAME_REF
+    slab->mp.parent.name = cache->name;
+#else
+    rt_strncpy(slab->mp.parent.name, cache->name, RT_NAME_MAX);
+#endif
+    rt_list_init(&(slab->mp.parent.list));
+
+    _mp_block_init(&(slab->mp), (rt_uint8_t *)slab + KMEM_SLAB_HEADER_SIZE,
+                   _kmem_slab_pool_size(cache), cache->object_size);
+
+    return slab;
+}
+
+static void _kmem_slab_delete(struct rt_kmem_slab *slab)
+{
+    /* no thread waits on the pool of slab, it is allocated without waiting */
+    RT_KERNEL_FREE(slab);
+}
+
+/**
+ * This function will initialize an object cache. The objects are allocated
+ * from slabs, each slab is a memory pool of slab_objects objects allocated
+ * from system heap when all slabs are full.
+ *
+ * @param cache the object cache
+ * @param name the name of object cache
+ * @param object_size the size of each object
+ * @param slab_objects the numbers of objects in one slab
+ */
+void rt_kmem_cache_init(rt_kmem_cache_t cache,
+                        const char     *name,
+                        rt_size_t       object_size,
+                        rt_size_t       slab_objects)
+{
+    /* parameter check */
+    RT_ASSERT(cache != RT_NULL);
+    RT_ASSERT(name != RT_NULL);
+    RT_ASSERT(object_size > 0 && slab_objects > 0);
+
+    cache->name         = name;
+    cache->object_size  = object_size;
+    cache->slab_objects = slab_objects;
+
+    rt_list_init(&(cache->slab_list));
+    cache->slab_count = 0;
+
+    cache->used_count = 0;
+    cache->hit_count  = 0;
+    cache->miss_count = 0;
+}
+
+/**
+ * This function will release all slabs of an object cache, all objects shall
+ * be freed to the cache before.
+ *
+ * @param cache the object cache
+ */
+void rt_kmem_cache_detach(rt_kmem_cache_t cache)
+{
+    struct rt_kmem_slab *slab;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* parameter check */
+    RT_ASSERT(cache != RT_NULL);
+    RT_ASSERT(cache->used_count == 0);
+
+    while (!rt_list_isempty(&(cache->slab_list)))
+    {
+        slab = rt_list_entry(cache->slab_list.next, struct rt_kmem_slab, list);
+        rt_list_remove(&(slab->list));
+        cache->slab_count --;
+
+        _kmem_slab_delete(slab);
+    }
+}
+
+/**
+ * This function will allocate an object from object cache, a new slab is
+ * allocated from system heap if all slabs are full.
+ *
+ * @param cache the object cache
+ *
+ * @return the allocated object or RT_NULL on allocated failed
+ */
+void *rt_kmem_cache_alloc(rt_kmem_cache_t cache)
+{
+    void *object;
+    register rt_base_t level;
+    struct rt_list_node *node;
+    struct rt_kmem_slab *slab;
+
+    /* parameter check */
+    RT_ASSERT(cache != RT_NULL);
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (node = cache->slab_list.next; node != &(cache->slab_list); node = node->next)
+    {
+        slab = rt_list_entry(node, struct rt_kmem_slab, list);
+        if (slab->mp.block_free_count > 0)
+        {
+            object = rt_mp_alloc(&(slab->mp), RT_WAITING_NO);
+
+            cache->used_count ++;
+            cache->hit_count ++;
+
+            /* enable interrupt */
+            rt_hw_interrupt_enable(level);
+
+            return object;
+        }
+    }
+
+    cache->miss_count ++;
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    slab = _kmem_slab_create(cache);
+    if (slab == RT_NULL)
+        return RT_NULL;
+
+    object = rt_mp_alloc(&(slab->mp), RT_WAITING_NO);
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    /* the latest slab is searched first */
+    rt_list_insert_after(&(cache->slab_list), &(slab->list));
+    cache->slab_count ++;
+    cache->used_count ++;
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return object;
+}
+
+/**
+ * This function will free an object to object cache. The slab is released
+ * to system heap when all of its objects are freed and it is not the only
+ * slab of cache.
+ *
+ * @param cache the object cache
+ * @param object the object allocated by rt_kmem_cache_alloc
+ */
+void rt_kmem_cache_free(rt_kmem_cache_t cache, void *object)
+{
+    register rt_base_t level;
+    struct rt_kmem_slab *slab;
+
+    /* parameter check */
+    RT_ASSERT(cache != RT_NULL);
+    if (object == RT_NULL) return;
+
+    slab = _kmem_slab_of(object);
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    rt_mp_free(object);
+    cache->used_count --;
+
+    if (slab->mp.block_free_count == slab->mp.block_total_count && cache->slab_count > 1)
+    {
+        rt_list_remove(&(slab->list));
+        cache->slab_count --;
+    }
+    else
+    {
+        slab = RT_NULL;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    if (slab != RT_NULL)
+        _kmem_slab_delete(slab);
+}
+
+/**
+ * This function will get the heap memory taken by an object cache.
+ *
+ * @param cache the object cache
+ *
+ * @return the total size of slabs
+ */
+rt_size_t rt_kmem_cache_footprint(rt_kmem_cache_t cache)
+{
+    RT_ASSERT(cache != RT_NULL);
+
+    return cache->slab_count * (KMEM_SLAB_HEADER_SIZE + _kmem_slab_pool_size(cache));
+}
+#endif
+
 /**@}*/
 
 #endif
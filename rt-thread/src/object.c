@@ -94,12 +94,93 @@ static struct rt_object_information rt_object_container[RT_Object_Info_Unknown]
     {RT_Object_Class_Timer, _OBJ_CONTAINER_LIST_INIT(RT_Object_Info_Timer), sizeof(struct rt_timer)},
 };
 
+#if defined(RT_USING_KMEM_CACHE) && defined(RT_USING_MEMPOOL) && defined(RT_USING_HEAP)
+#define _OBJECT_CACHE_ENABLE
+#ifndef RT_OBJECT_CACHE_SLAB_SIZE
+#define RT_OBJECT_CACHE_SLAB_SIZE   512             /* the size of objects in one slab */
+#endif
+
+/* the caches of dynamic objects, one cache for each object class */
+static struct rt_kmem_cache _object_cache[RT_Object_Info_Unknown];
+
+static const char *_object_class_name(enum rt_object_class_type type)
+{
+    switch (type)
+    {
+    case RT_Object_Class_Thread:       return "thread";
+    case RT_Object_Class_Semaphore:    return "sem";
+    case RT_Object_Class_Mutex:        return "mutex";
+    case RT_Object_Class_Event:        return "event";
+    case RT_Object_Class_MailBox:      return "mailbox";
+    case RT_Object_Class_MessageQueue: return "msgqueue";
+    case RT_Object_Class_MemHeap:      return "memheap";
+    case RT_Object_Class_MemPool:      return "mempool";
+    case RT_Object_Class_Device:       return "device";
+    case RT_Object_Class_Timer:        return "timer";
+    default:                           return "object";
+    }
+}
+
+/* get the object cache of a class, the cache is initialized at first use */
+static rt_kmem_cache_t _object_cache_get(struct rt_object_information *information)
+{
+    rt_size_t slab_objects;
+    register rt_base_t level;
+    rt_kmem_cache_t cache;
+
+    cache = &_object_cache[information - rt_object_container];
+    if (cache->object_size == 0)
+    {
+        slab_objects = RT_OBJECT_CACHE_SLAB_SIZE /
+                       (RT_ALIGN(information->object_size, RT_ALIGN_SIZE) + sizeof(rt_uint8_t *));
+        if (slab_objects == 0)
+            slab_objects = 1;
+
+        level = rt_hw_interrupt_disable();
+        if (cache->object_size == 0)
+        {
+            rt_kmem_cache_init(cache, _object_class_name(information->type),
+                               information->object_size, slab_objects);
+        }
+        rt_hw_interrupt_enable(level);
+    }
+
+    return cache;
+}
+
+/**
+ * This function will show the statistics of kernel object caches.
+ */
+void rt_object_cache_dump(void)
+{
+    int index;
+    rt_kmem_cache_t cache;
+    rt_uint32_t total;
+
+    rt_kprintf("object   size slab used total hit   footprint\n");
+    rt_kprintf("-------- ---- ---- ---- ----- ----  ---------\n");
+    for (index = 0; index < RT_Object_Info_Unknown; index ++)
+    {
+        cache = &_object_cache[index];
+        if (cache->object_size == 0)
+            continue;
+
+        total = cache->hit_count + cache->miss_count;
+        rt_kprintf("%-8.8s %4d %4d %4d %5d %3d%%  %9d\n", cache->name,
+                   cache->object_size, cache->slab_count, cache->used_count,
+                   cache->slab_count * cache->slab_objects,
+                   total ? (int)((rt_uint64_t)cache->hit_count * 100 / total) : 0,
+                   rt_kmem_cache_footprint(cache));
+    }
+}
+#endif
+
 #ifdef RT_USING_HOOK
-static void (*rt_object_attach_hook)(struct rt_object *object);
-static void (*rt_object_detach_hook)(struct rt_object *object);
-void (*rt_object_trytake_hook)(struct rt_object *object);
-void (*rt_object_take_hook)(struct rt_object *object);
-void (*rt_object_put_hook)(struct rt_object *object);
+static RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_attach_hook;
+static RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_detach_hook;
+RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_trytake_hook;
+RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_take_hook;
+RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_put_hook;
 
 /**
  * @addtogroup Hook
@@ -112,10 +193,32 @@ void (*rt_object_put_hook)(struct rt_object *object);
  * attaches to kernel object system.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void rt_object_attach_sethook(void (*hook)(struct rt_object *object))
+rt_err_t rt_object_attach_sethook(void (*hook)(struct rt_object *object))
 {
-    rt_object_attach_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_object_attach_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_object_attach_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_object_attach_delhook(void (*hook)(struct rt_object *object))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_object_attach_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -123,10 +226,32 @@ void rt_object_attach_sethook(void (*hook)(struct rt_object *object))
  * detaches from kernel object system.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
+ */
+rt_err_t rt_object_detach_sethook(void (*hook)(struct rt_object *object))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_object_detach_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_object_detach_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
  */
-void rt_object_detach_sethook(void (*hook)(struct rt_object *object))
+rt_err_t rt_object_detach_delhook(void (*hook)(struct rt_object *object))
 {
-    rt_object_detach_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_object_detach_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -141,10 +266,32 @@ void rt_object_detach_sethook(void (*hook)(struct rt_object *object))
  * message queue - message is received by thread
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
+ */
+rt_err_t rt_object_trytake_sethook(void (*hook)(struct rt_object *object))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_object_trytake_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_object_trytake_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
  */
-void rt_object_trytake_sethook(void (*hook)(struct rt_object *object))
+rt_err_t rt_object_trytake_delhook(void (*hook)(struct rt_object *object))
 {
-    rt_object_trytake_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_object_trytake_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -160,10 +307,32 @@ void rt_object_trytake_sethook(void (*hook)(struct rt_object *object))
  * timer - timer is started
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void rt_object_take_sethook(void (*hook)(struct rt_object *object))
+rt_err_t rt_object_take_sethook(void (*hook)(struct rt_object *object))
 {
-    rt_object_take_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_object_take_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_object_take_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_object_take_delhook(void (*hook)(struct rt_object *object))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_object_take_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -171,10 +340,32 @@ void rt_object_take_sethook(void (*hook)(struct rt_object *object))
  * is put to kernel object system.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void rt_object_put_sethook(void (*hook)(struct rt_object *object))
+rt_err_t rt_object_put_sethook(void (*hook)(struct rt_object *object))
 {
-    rt_object_put_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_object_put_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_object_put_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_object_put_delhook(void (*hook)(struct rt_object *object))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_object_put_hook, hook, result);
+
+    return result;
 }
 
 /**@}*/
@@ -286,6 +477,19 @@ int rt_object_get_pointers(enum rt_object_class_type type, rt_object_t *pointers
     return index;
 }
 
+/* set the name of object, the anonymous object has an empty name */
+rt_inline void _object_set_name(struct rt_object *object, const char *name)
+{
+#ifdef RT_USING_OBJECT_NAME_REF
+    object->name = (name != RT_NULL) ? name : "";
+#else
+    if (name != RT_NULL)
+        rt_strncpy(object->name, name, RT_NAME_MAX);
+    else
+        object->name[0] = '\0';
+#endif
+}
+
 /**
  * This function will initialize an object and add it to object system
  * management.
@@ -293,6 +497,10 @@ int rt_object_get_pointers(enum rt_object_class_type type, rt_object_t *pointers
  * @param object the specified object to be initialized.
  * @param type the object type.
  * @param name the object name. In system, the object's name must be unique.
+ *             RT_NULL for an anonymous object.
+ *
+ * @note the name is referred but not copied with RT_USING_OBJECT_NAME_REF,
+ *       it shall be valid until the object is detached.
  */
 void rt_object_init(struct rt_object         *object,
                     enum rt_object_class_type type,
@@ -329,8 +537,8 @@ void rt_object_init(struct rt_object         *object,
     /* initialize object's parameters */
     /* set object type to static */
     object->type = type | RT_Object_Class_Static;
-    /* copy name */
-    rt_strncpy(object->name, name, RT_NAME_MAX);
+    /* set name */
+    _object_set_name(object, name);
 
     RT_OBJECT_HOOK_CALL(rt_object_attach_hook, (object));
 
@@ -378,6 +586,10 @@ void rt_object_detach(rt_object_t object)
  *
  * @param type the type of object
  * @param name the object name. In system, the object's name must be unique.
+ *             RT_NULL for an anonymous object.
+ *
+ * @note the name is referred but not copied with RT_USING_OBJECT_NAME_REF,
+ *       it shall be valid until the object is deleted.
  *
  * @return object
  */
@@ -393,7 +605,11 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     information = rt_object_get_information(type);
     RT_ASSERT(information != RT_NULL);
 
+#ifdef _OBJECT_CACHE_ENABLE
+    object = (struct rt_object *)rt_kmem_cache_alloc(_object_cache_get(information));
+#else
     object = (struct rt_object *)RT_KERNEL_MALLOC(information->object_size);
+#endif
     if (object == RT_NULL)
     {
         /* no memory can be allocated */
@@ -411,8 +627,8 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     /* set object flag */
     object->flag = 0;
 
-    /* copy name */
-    rt_strncpy(object->name, name, RT_NAME_MAX);
+    /* set name */
+    _object_set_name(object, name);
 
     RT_OBJECT_HOOK_CALL(rt_object_attach_hook, (object));
 
@@ -437,6 +653,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
 void rt_object_delete(rt_object_t object)
 {
     register rt_base_t temp;
+#ifdef _OBJECT_CACHE_ENABLE
+    struct rt_object_information *information;
+#endif
 
     /* object check */
     RT_ASSERT(object != RT_NULL);
@@ -444,6 +663,11 @@ void rt_object_delete(rt_object_t object)
 
     RT_OBJECT_HOOK_CALL(rt_object_detach_hook, (object));
 
+#ifdef _OBJECT_CACHE_ENABLE
+    information = rt_object_get_information((enum rt_object_class_type)object->type);
+    RT_ASSERT(information != RT_NULL);
+#endif
+
     /* reset object type */
     object->type = RT_Object_Class_Null;
 
@@ -457,7 +681,34 @@ void rt_object_delete(rt_object_t object)
     rt_hw_interrupt_enable(temp);
 
     /* free the memory of object */
+#ifdef _OBJECT_CACHE_ENABLE
+    rt_kmem_cache_free(_object_cache_get(information), object);
+#else
+    RT_KERNEL_FREE(object);
+#endif
+}
+
+/*
+ * This function will release the memory of an object allocated by
+ * rt_object_allocate, which has been detached from object system.
+ *
+ * @param type the type of object when it was allocated
+ * @param object the object to be released
+ *
+ * @note Please do not invoke this function in user application.
+ */
+void rt_object_release(enum rt_object_class_type type, rt_object_t object)
+{
+#ifdef _OBJECT_CACHE_ENABLE
+    struct rt_object_information *information;
+
+    information = rt_object_get_information(type);
+    RT_ASSERT(information != RT_NULL);
+
+    rt_kmem_cache_free(_object_cache_get(information), object);
+#else
     RT_KERNEL_FREE(object);
+#endif
 }
 #endif
 
@@ -530,7 +781,12 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     rt_list_for_each(node, &(information->object_list))
     {
         object = rt_list_entry(node, struct rt_object, list);
+#ifdef RT_USING_OBJECT_NAME_REF
+        /* the same string literal is usually merged by linker */
+        if (object->name == name || rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+#else
         if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+#endif
         {
             /* leave critical */
             rt_exit_critical();
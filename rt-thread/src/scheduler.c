@@ -51,7 +51,7 @@ rt_uint8_t rt_current_priority;
 rt_list_t rt_thread_defunct;
 
 #ifdef RT_USING_HOOK
-static void (*rt_scheduler_hook)(struct rt_thread *from, struct rt_thread *to);
+static RT_OBJECT_HOOK_LIST(struct rt_thread *from, struct rt_thread *to) rt_scheduler_hook;
 
 /**
  * @addtogroup Hook
@@ -64,16 +64,190 @@ static void (*rt_scheduler_hook)(struct rt_thread *from, struct rt_thread *to);
  * switch happens.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void
-rt_scheduler_sethook(void (*hook)(struct rt_thread *from, struct rt_thread *to))
+rt_err_t rt_scheduler_sethook(void (*hook)(struct rt_thread *from, struct rt_thread *to))
 {
-    rt_scheduler_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_scheduler_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_scheduler_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_scheduler_delhook(void (*hook)(struct rt_thread *from, struct rt_thread *to))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_scheduler_hook, hook, result);
+
+    return result;
 }
 
 /**@}*/
 #endif
 
+#ifdef RT_USING_SCHED_LATENCY
+/*
+ * wakeup-to-run latency statistics, indexed by priority. There is only one
+ * CPU in this kernel and the table is only updated with interrupt disabled,
+ * so no other lock is needed.
+ */
+static struct rt_sched_latency rt_sched_latency_table[RT_THREAD_PRIORITY_MAX];
+
+/* get the log2 bucket of a latency, i.e. the number of its significant bits */
+static rt_uint32_t _rt_sched_latency_bucket(rt_uint32_t value)
+{
+    rt_uint32_t bucket = 0;
+
+    if (value & 0xffff0000) { bucket += 16; value >>= 16; }
+    if (value & 0xff00)     { bucket += 8;  value >>= 8;  }
+    if (value & 0xf0)       { bucket += 4;  value >>= 4;  }
+    if (value & 0x0c)       { bucket += 2;  value >>= 2;  }
+    if (value & 0x02)       { bucket += 1;  value >>= 1;  }
+    bucket += value;
+
+    if (bucket >= RT_SCHED_LATENCY_BUCKETS)
+        bucket = RT_SCHED_LATENCY_BUCKETS - 1;
+
+    return bucket;
+}
+
+/* account the latency of a thread which was made ready and is switched in now */
+static void _rt_sched_latency_record(struct rt_thread *thread, rt_uint8_t priority)
+{
+    rt_uint32_t latency;
+    struct rt_sched_latency *stat;
+
+    thread->ready_pending = 0;
+    latency = rt_hw_timestamp_get() - thread->ready_stamp;
+
+    stat = &rt_sched_latency_table[priority];
+    if (stat->count == 0 || latency < stat->min)
+        stat->min = latency;
+    if (latency > stat->max)
+        stat->max = latency;
+    stat->count ++;
+    stat->sum += latency;
+    stat->histogram[_rt_sched_latency_bucket(latency)] ++;
+}
+
+/**
+ * This function will get the wakeup-to-run latency statistics of a priority.
+ *
+ * @param priority the priority level
+ * @param latency the buffer to save the statistics
+ *
+ * @return RT_EOK on successful, -RT_EINVAL on a bad priority level
+ */
+rt_err_t rt_sched_latency_get(rt_uint8_t priority, struct rt_sched_latency *latency)
+{
+    rt_base_t level;
+
+    RT_ASSERT(latency != RT_NULL);
+
+    if (priority >= RT_THREAD_PRIORITY_MAX)
+        return -RT_EINVAL;
+
+    level = rt_hw_interrupt_disable();
+    rt_memcpy(latency, &rt_sched_latency_table[priority], sizeof(struct rt_sched_latency));
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will get the 99th percentile of wakeup-to-run latency, the
+ * upper bound of the histogram bucket which covers 99% of the samples.
+ *
+ * @param latency the statistics got by rt_sched_latency_get
+ *
+ * @return the 99th percentile, not more than the maximal latency
+ */
+rt_uint32_t rt_sched_latency_p99(const struct rt_sched_latency *latency)
+{
+    rt_uint32_t index, target, sum, p99;
+
+    RT_ASSERT(latency != RT_NULL);
+
+    target = latency->count - latency->count / 100;
+    sum = 0;
+    for (index = 0; index < RT_SCHED_LATENCY_BUCKETS; index ++)
+    {
+        sum += latency->histogram[index];
+        if (sum >= target)
+            break;
+    }
+    /* the last bucket also takes the larger latencies, it has no bound */
+    if (index >= RT_SCHED_LATENCY_BUCKETS - 1)
+        p99 = latency->max;
+    else
+        p99 = index == 0 ? 0 : (rt_uint32_t)((1UL << index) - 1);
+    if (p99 > latency->max)
+        p99 = latency->max;
+
+    return p99;
+}
+
+/**
+ * This function will clear the wakeup-to-run latency statistics.
+ */
+void rt_sched_latency_reset(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(rt_sched_latency_table, 0, sizeof(rt_sched_latency_table));
+    rt_hw_interrupt_enable(level);
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static long sched_latency(int argc, char **argv)
+{
+    rt_uint8_t priority;
+    struct rt_sched_latency latency;
+
+    if (argc > 1)
+    {
+        if (rt_strcmp(argv[1], "reset") == 0)
+        {
+            rt_sched_latency_reset();
+            return 0;
+        }
+
+        rt_kprintf("Usage: sched_latency [reset]\n");
+        return -RT_EINVAL;
+    }
+
+    rt_kprintf("prio   count      min        avg        max        p99\n");
+    rt_kprintf("---- ---------- ---------- ---------- ---------- ----------\n");
+    for (priority = 0; priority < RT_THREAD_PRIORITY_MAX; priority ++)
+    {
+        rt_sched_latency_get(priority, &latency);
+        if (latency.count == 0)
+            continue;
+
+        rt_kprintf("%4d %10u %10u %10u %10u %10u\n", priority, latency.count,
+                   latency.min, (rt_uint32_t)(latency.sum / latency.count),
+                   latency.max, rt_sched_latency_p99(&latency));
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(sched_latency, dump or reset wakeup-to-run latency: sched_latency [reset]);
+#endif
+#endif
+
 #ifdef RT_USING_OVERFLOW_CHECK
 static void _rt_scheduler_stack_check(struct rt_thread *thread)
 {
@@ -175,8 +349,13 @@ void rt_system_scheduler_start(void)
 
     rt_current_thread = to_thread;
 
+#ifdef RT_USING_SCHED_LATENCY
+    /* the first thread is not woken up by anyone, don't account it */
+    to_thread->ready_pending = 0;
+#endif
+
     /* switch to new thread */
-    rt_hw_context_switch_to((rt_uint32_t)&to_thread->sp);
+    rt_hw_context_switch_to((rt_ubase_t)&to_thread->sp);
 
     /* never come back */
 }
@@ -228,6 +407,11 @@ void rt_schedule(void)
 
             RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (from_thread, to_thread));
 
+#ifdef RT_USING_SCHED_LATENCY
+            if (to_thread->ready_pending)
+                _rt_sched_latency_record(to_thread, rt_current_priority);
+#endif
+
             /* switch to new thread */
             RT_DEBUG_LOG(RT_DEBUG_SCHEDULER,
                          ("[%d]switch to priority#%d "
@@ -259,6 +443,16 @@ void rt_schedule(void)
                                                (rt_ubase_t)&to_thread->sp);
             }
         }
+#ifdef RT_USING_SCHED_LATENCY
+        else
+        {
+            /*
+             * the current thread keeps the CPU, drop the stamp of its re-insert
+             * or the next switch to it would account a stale latency.
+             */
+            to_thread->ready_pending = 0;
+        }
+#endif
     }
 
     /* enable interrupt */
@@ -281,6 +475,18 @@ void rt_schedule_insert_thread(struct rt_thread *thread)
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_SCHED_LATENCY
+    /*
+     * the latency is measured from here to the switch in rt_schedule, a ready
+     * thread re-inserted for a priority change keeps its original timestamp.
+     */
+    if ((thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_READY)
+    {
+        thread->ready_stamp   = rt_hw_timestamp_get();
+        thread->ready_pending = 1;
+    }
+#endif
+
     /* change stat */
     thread->stat = RT_THREAD_READY | (thread->stat & ~RT_THREAD_STAT_MASK);
 
@@ -64,8 +64,8 @@ static rt_size_t used_mem, max_mem;
 #endif
 
 #ifdef RT_USING_HOOK
-static void (*rt_malloc_hook)(void *ptr, rt_size_t size);
-static void (*rt_free_hook)(void *ptr);
+static RT_OBJECT_HOOK_LIST(void *ptr, rt_size_t size) rt_malloc_hook;
+static RT_OBJECT_HOOK_LIST(void *ptr) rt_free_hook;
 
 /**
  * @addtogroup Hook
@@ -78,10 +78,32 @@ static void (*rt_free_hook)(void *ptr);
  * block is allocated from heap memory.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
+rt_err_t rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
 {
-    rt_malloc_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_malloc_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_malloc_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_malloc_delhook(void (*hook)(void *ptr, rt_size_t size))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_malloc_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -89,10 +111,32 @@ void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
  * block is released to heap memory.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void rt_free_sethook(void (*hook)(void *ptr))
+rt_err_t rt_free_sethook(void (*hook)(void *ptr))
 {
-    rt_free_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_free_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_free_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_free_delhook(void (*hook)(void *ptr))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_free_hook, hook, result);
+
+    return result;
 }
 
 /**@}*/
@@ -178,6 +222,9 @@ typedef struct slab_zone
 
     rt_int32_t  z_zoneindex;    /* zone index */
     slab_chunk  *z_freechunk;   /* free chunk list */
+#ifdef RT_USING_HEAP_INFO
+    rt_thread_t *z_owner;       /* the threads charged for chunks */
+#endif
 } slab_zone;
 
 #define ZALLOC_SLAB_MAGIC       0x51ab51ab
@@ -231,6 +278,25 @@ struct rt_page_head
 static struct rt_page_head *rt_page_list;
 static struct rt_semaphore heap_sem;
 
+#ifdef RT_USING_HEAP_INFO
+/* the free blocks of slab heap are the free page runs in page allocator */
+static struct rt_heap_stat heap_stat;
+
+/* the threads charged for large allocations, by page */
+static rt_thread_t *page_owner;
+
+#define PAGE_FREE_ADD(npages)   rt_heap_stat_add(&heap_stat, (npages) << RT_MM_PAGE_BITS)
+#define PAGE_FREE_DEL(npages)   rt_heap_stat_del(&heap_stat, (npages) << RT_MM_PAGE_BITS)
+/* charge an allocated memory block to current thread, or uncharge it from its owner */
+#define SLAB_CHARGE(ptr)        rt_heap_stat_charge(_slab_owner(ptr), _slab_usable(ptr))
+#define SLAB_UNCHARGE(ptr)      rt_heap_stat_uncharge(*_slab_owner(ptr), _slab_usable(ptr))
+#else
+#define PAGE_FREE_ADD(npages)
+#define PAGE_FREE_DEL(npages)
+#define SLAB_CHARGE(ptr)        do {} while (0)
+#define SLAB_UNCHARGE(ptr)      do {} while (0)
+#endif
+
 void *rt_page_alloc(rt_size_t npages)
 {
     struct rt_page_head *b, *n;
@@ -246,16 +312,19 @@ void *rt_page_alloc(rt_size_t npages)
         if (b->page > npages)
         {
             /* splite pages */
+            PAGE_FREE_DEL(b->page);
             n       = b + npages;
             n->next = b->next;
             n->page = b->page - npages;
             *prev   = n;
+            PAGE_FREE_ADD(n->page);
             break;
         }
 
         if (b->page == npages)
         {
             /* this node fit, remove this node */
+            PAGE_FREE_DEL(b->page);
             *prev = b->next;
             break;
         }
@@ -288,20 +357,25 @@ void rt_page_free(void *addr, rt_size_t npages)
 
         if (b + b->page == n)
         {
+            PAGE_FREE_DEL(b->page);
             if (b + (b->page += npages) == b->next)
             {
+                PAGE_FREE_DEL(b->next->page);
                 b->page += b->next->page;
                 b->next  = b->next->next;
             }
+            PAGE_FREE_ADD(b->page);
 
             goto _return;
         }
 
         if (b == n + npages)
         {
+            PAGE_FREE_DEL(b->page);
             n->page = b->page + npages;
             n->next = b->next;
             *prev   = n;
+            PAGE_FREE_ADD(n->page);
 
             goto _return;
         }
@@ -313,6 +387,7 @@ void rt_page_free(void *addr, rt_size_t npages)
     n->page = npages;
     n->next = b;
     *prev   = n;
+    PAGE_FREE_ADD(npages);
 
 _return:
     /* unlock heap */
@@ -390,6 +465,13 @@ void rt_system_heap_init(void *begin_addr, void *end_addr)
 
     RT_DEBUG_LOG(RT_DEBUG_SLAB, ("memusage 0x%x, size 0x%x\n",
                                  (rt_ubase_t)memusage, limsize));
+
+#ifdef RT_USING_HEAP_INFO
+    /* allocate the owner array of large allocations */
+    limsize    = npages * sizeof(rt_thread_t);
+    limsize    = RT_ALIGN(limsize, RT_MM_PAGE_SIZE);
+    page_owner = rt_page_alloc(limsize / RT_MM_PAGE_SIZE);
+#endif
 }
 
 /*
@@ -462,27 +544,209 @@ rt_inline int zoneindex(rt_size_t *bytes)
 
 /**@{*/
 
-/**
- * This function will allocate a block from system heap memory.
- * - If the nbytes is less than zero,
- * or
- * - If there is no nbytes sized memory valid in system,
- * the RT_NULL is returned.
- *
- * @param size the size of memory to be allocated
- *
- * @return the allocated memory
+/* take a chunk from the existing zones of index zi, the heap shall be locked */
+static slab_chunk *_slab_zone_take(rt_int32_t zi)
+{
+    slab_zone *z;
+    slab_chunk *chunk;
+
+    if ((z = zone_array[zi]) == RT_NULL)
+        return RT_NULL;
+
+    RT_ASSERT(z->z_nfree > 0);
+
+    /* Remove us from the zone_array[] when we become empty */
+    if (--z->z_nfree == 0)
+    {
+        zone_array[zi] = z->z_next;
+        z->z_next = RT_NULL;
+    }
+
+    /*
+     * No chunks are available but nfree said we had some memory, so
+     * it must be available in the never-before-used-memory area
+     * governed by uindex.  The consequences are very serious if our zone
+     * got corrupted so we use an explicit rt_kprintf rather then a KASSERT.
+     */
+    if (z->z_uindex + 1 != z->z_nmax)
+    {
+        z->z_uindex = z->z_uindex + 1;
+        chunk = (slab_chunk *)(z->z_baseptr + z->z_uindex * z->z_chunksize);
+    }
+    else
+    {
+        /* find on free chunk list */
+        chunk = z->z_freechunk;
+
+        /* remove this chunk from list */
+        z->z_freechunk = z->z_freechunk->c_next;
+    }
+
+#ifdef RT_MEM_STATS
+    used_mem += z->z_chunksize;
+    if (used_mem > max_mem)
+        max_mem = used_mem;
+#endif
+
+    return chunk;
+}
+
+/*
+ * release a chunk to its zone, the heap shall be locked. It returns the
+ * zone which shall be released to page allocator after the heap is unlocked.
  */
-void *rt_malloc(rt_size_t size)
+static slab_zone *_slab_zone_release(void *ptr, struct memusage *kup)
 {
     slab_zone *z;
-    rt_int32_t zi;
     slab_chunk *chunk;
+
+    /* zone case. get out zone. */
+    z = (slab_zone *)(((rt_ubase_t)ptr & ~RT_MM_PAGE_MASK) -
+                      kup->size * RT_MM_PAGE_SIZE);
+    RT_ASSERT(z->z_magic == ZALLOC_SLAB_MAGIC);
+
+    chunk          = (slab_chunk *)ptr;
+    chunk->c_next  = z->z_freechunk;
+    z->z_freechunk = chunk;
+
+#ifdef RT_MEM_STATS
+    used_mem -= z->z_chunksize;
+#endif
+
+    /*
+     * Bump the number of free chunks.  If it becomes non-zero the zone
+     * must be added back onto the appropriate list.
+     */
+    if (z->z_nfree++ == 0)
+    {
+        z->z_next = zone_array[z->z_zoneindex];
+        zone_array[z->z_zoneindex] = z;
+    }
+
+    /*
+     * If the zone becomes totally free, and there are other zones we
+     * can allocate from, move this zone to the FreeZones list.  Since
+     * this code can be called from an IPI callback, do *NOT* try to mess
+     * with kernel_map here.  Hysteresis will be performed at malloc() time.
+     */
+    if (z->z_nfree == z->z_nmax &&
+        (z->z_next || zone_array[z->z_zoneindex] != z))
+    {
+        slab_zone **pz;
+
+        RT_DEBUG_LOG(RT_DEBUG_SLAB, ("free zone 0x%x\n",
+                                     (rt_ubase_t)z, z->z_zoneindex));
+
+        /* remove zone from zone array list */
+        for (pz = &zone_array[z->z_zoneindex]; z != *pz; pz = &(*pz)->z_next)
+            ;
+        *pz = z->z_next;
+
+        /* reset zone */
+        z->z_magic = -1;
+
+        /* insert to free zone list */
+        z->z_next = zone_free;
+        zone_free = z;
+
+        ++ zone_free_cnt;
+
+        /* release zone to page allocator */
+        if (zone_free_cnt > ZONE_RELEASE_THRESH)
+        {
+            register rt_base_t i;
+
+            z         = zone_free;
+            zone_free = z->z_next;
+            -- zone_free_cnt;
+
+            /* set message usage */
+            for (i = 0, kup = btokup(z); i < zone_page_cnt; i ++)
+            {
+                kup->type = PAGE_TYPE_FREE;
+                kup->size = 0;
+                kup ++;
+            }
+
+            return z;
+        }
+    }
+
+    return RT_NULL;
+}
+
+#ifdef RT_USING_HEAP_MAGAZINE
+static void *_slab_refill(void *heap, rt_size_t size)
+{
+    return _slab_zone_take(zoneindex(&size));
+}
+
+/* release the chunks taken out of magazines */
+static void _slab_release_list(void *list)
+{
+    void *ptr;
+    slab_zone *z;
+
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+    while (list != RT_NULL)
+    {
+        ptr  = list;
+        list = *(void **)list;
+
+        z = _slab_zone_release(ptr, btokup((rt_ubase_t)ptr & ~RT_MM_PAGE_MASK));
+        if (z != RT_NULL)
+        {
+            /* unlock heap, since page allocator will think about lock */
+            rt_sem_release(&heap_sem);
+            rt_page_free(z, zone_size / RT_MM_PAGE_SIZE);
+            rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+        }
+    }
+    rt_sem_release(&heap_sem);
+}
+#endif
+
+#ifdef RT_USING_HEAP_INFO
+/* get the usable size of an allocated memory block */
+static rt_size_t _slab_usable(void *ptr)
+{
+    slab_zone *z;
     struct memusage *kup;
 
-    /* zero size, return RT_NULL */
-    if (size == 0)
-        return RT_NULL;
+    kup = btokup((rt_ubase_t)ptr & ~RT_MM_PAGE_MASK);
+    if (kup->type == PAGE_TYPE_LARGE)
+        return kup->size << RT_MM_PAGE_BITS;
+
+    z = (slab_zone *)(((rt_ubase_t)ptr & ~RT_MM_PAGE_MASK) -
+                      kup->size * RT_MM_PAGE_SIZE);
+
+    return z->z_chunksize;
+}
+
+/* get the owner of an allocated memory block */
+static rt_thread_t *_slab_owner(void *ptr)
+{
+    slab_zone *z;
+    struct memusage *kup;
+
+    kup = btokup((rt_ubase_t)ptr & ~RT_MM_PAGE_MASK);
+    if (kup->type == PAGE_TYPE_LARGE)
+        return &page_owner[((rt_ubase_t)ptr - heap_start) >> RT_MM_PAGE_BITS];
+
+    z = (slab_zone *)(((rt_ubase_t)ptr & ~RT_MM_PAGE_MASK) -
+                      kup->size * RT_MM_PAGE_SIZE);
+
+    return &z->z_owner[((rt_uint8_t *)ptr - z->z_baseptr) / z->z_chunksize];
+}
+#endif
+
+/* allocate a chunk from zones or pages, the size is not zero */
+static slab_chunk *_slab_alloc(rt_size_t size)
+{
+    slab_zone *z;
+    rt_int32_t zi;
+    slab_chunk *chunk;
+    struct memusage *kup;
 
     /*
      * Handle large allocations directly.  There should not be very many of
@@ -534,45 +798,9 @@ void *rt_malloc(rt_size_t size)
 
     RT_DEBUG_LOG(RT_DEBUG_SLAB, ("try to malloc 0x%x on zone: %d\n", size, zi));
 
-    if ((z = zone_array[zi]) != RT_NULL)
-    {
-        RT_ASSERT(z->z_nfree > 0);
-
-        /* Remove us from the zone_array[] when we become empty */
-        if (--z->z_nfree == 0)
-        {
-            zone_array[zi] = z->z_next;
-            z->z_next = RT_NULL;
-        }
-
-        /*
-         * No chunks are available but nfree said we had some memory, so
-         * it must be available in the never-before-used-memory area
-         * governed by uindex.  The consequences are very serious if our zone
-         * got corrupted so we use an explicit rt_kprintf rather then a KASSERT.
-         */
-        if (z->z_uindex + 1 != z->z_nmax)
-        {
-            z->z_uindex = z->z_uindex + 1;
-            chunk = (slab_chunk *)(z->z_baseptr + z->z_uindex * size);
-        }
-        else
-        {
-            /* find on free chunk list */
-            chunk = z->z_freechunk;
-
-            /* remove this chunk from list */
-            z->z_freechunk = z->z_freechunk->c_next;
-        }
-
-#ifdef RT_MEM_STATS
-        used_mem += z->z_chunksize;
-        if (used_mem > max_mem)
-            max_mem = used_mem;
-#endif
-
+    chunk = _slab_zone_take(zi);
+    if (chunk != RT_NULL)
         goto done;
-    }
 
     /*
      * If all zones are exhausted we need to allocate a new zone for this
@@ -584,6 +812,9 @@ void *rt_malloc(rt_size_t size)
      */
     {
         rt_int32_t off;
+#ifdef RT_USING_HEAP_INFO
+        rt_int32_t owners;
+#endif
 
         if ((z = zone_free) != RT_NULL)
         {
@@ -625,6 +856,12 @@ void *rt_malloc(rt_size_t size)
 
         /* offset of slab zone struct in zone */
         off = sizeof(slab_zone);
+#ifdef RT_USING_HEAP_INFO
+        /* the owners of chunks follow the zone struct */
+        z->z_owner = (rt_thread_t *)((rt_uint8_t *)z + off);
+        owners     = (zone_size - off) / (size + sizeof(rt_thread_t));
+        off       += owners * sizeof(rt_thread_t);
+#endif
 
         /*
          * Guarentee power-of-2 alignment for power-of-2-sized chunks.
@@ -638,6 +875,10 @@ void *rt_malloc(rt_size_t size)
         z->z_magic     = ZALLOC_SLAB_MAGIC;
         z->z_zoneindex = zi;
         z->z_nmax      = (zone_size - off) / size;
+#ifdef RT_USING_HEAP_INFO
+        if (z->z_nmax > owners)
+            z->z_nmax = owners;
+#endif
         z->z_nfree     = z->z_nmax - 1;
         z->z_baseptr   = (rt_uint8_t *)z + off;
         z->z_uindex    = 0;
@@ -657,13 +898,207 @@ void *rt_malloc(rt_size_t size)
     }
 
 done:
+#ifdef RT_USING_HEAP_MAGAZINE
+    if (size <= RT_HEAP_MAGAZINE_MAX)
+        rt_heap_magazine_fill(RT_NULL, size, _slab_refill);
+#endif
     rt_sem_release(&heap_sem);
-    RT_OBJECT_HOOK_CALL(rt_malloc_hook, ((char *)chunk, size));
 
 __exit:
     return chunk;
 }
 
+/**
+ * This function will allocate a block from system heap memory.
+ * - If the nbytes is less than zero,
+ * or
+ * - If there is no nbytes sized memory valid in system,
+ * the RT_NULL is returned.
+ *
+ * @param size the size of memory to be allocated
+ *
+ * @return the allocated memory
+ */
+void *rt_malloc(rt_size_t size)
+{
+    slab_chunk *chunk;
+    rt_size_t chunk_size;
+#ifdef RT_USING_HEAP_MAGAZINE
+    void *flush;
+#endif
+
+    /* zero size, return RT_NULL */
+    if (size == 0)
+        return RT_NULL;
+
+    chunk_size = size;
+#ifdef RT_USING_HEAP_MAGAZINE
+    chunk = rt_heap_magazine_get(&chunk_size);
+    if (chunk != RT_NULL)
+    {
+        SLAB_CHARGE(chunk);
+        RT_HEAP_PROFILE_ALLOC(chunk, size);
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, ((char *)chunk, size));
+
+        return chunk;
+    }
+#endif
+
+    chunk = _slab_alloc(chunk_size);
+#ifdef RT_USING_HEAP_MAGAZINE
+    if (chunk == RT_NULL)
+    {
+        /* return the cached chunks to heap and try again */
+        flush = rt_heap_magazine_drain();
+        if (flush != RT_NULL)
+        {
+            _slab_release_list(flush);
+            chunk = _slab_alloc(chunk_size);
+        }
+    }
+#endif
+
+    if (chunk != RT_NULL)
+    {
+        SLAB_CHARGE(chunk);
+        RT_HEAP_PROFILE_ALLOC(chunk, size);
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, ((char *)chunk, size));
+    }
+
+    return chunk;
+}
+
+/**
+ * This function allocates a memory block, which address is aligned to the
+ * specified alignment size. The chunks of power of 2 size are naturally
+ * aligned in zone and the large allocations are aligned to page, so the
+ * memory block can be released by rt_free or rt_free_align.
+ *
+ * @param size the allocated memory block size
+ * @param align the alignment size, shall be power of 2
+ *
+ * @return the allocated memory block on successful, otherwise returns RT_NULL
+ */
+void *rt_malloc_align(rt_size_t size, rt_size_t align)
+{
+    void *chunk;
+    rt_size_t chunk_size;
+    rt_size_t npages, extra, lead;
+    rt_ubase_t aligned;
+    struct memusage *kup;
+
+    RT_ASSERT((align & (align - 1)) == 0);
+
+    if (size == 0)
+        return RT_NULL;
+
+    /* the chunks are aligned to the minimal chunk size at least */
+    if (align <= MIN_CHUNK_SIZE)
+    {
+        chunk = rt_malloc(size);
+        RT_HEAP_PROFILE_CALLER(chunk);
+
+        return chunk;
+    }
+
+    /* use the zone chunk of power of 2 size not less than the alignment */
+    for (chunk_size = align; chunk_size < size; chunk_size <<= 1);
+    if (chunk_size < zone_limit && chunk_size <= RT_MM_PAGE_SIZE)
+    {
+        chunk = rt_malloc(chunk_size);
+        RT_HEAP_PROFILE_CALLER(chunk);
+
+        return chunk;
+    }
+
+    /* allocate pages, the pages more than the alignment of page are trimmed */
+    npages = RT_ALIGN(size, RT_MM_PAGE_SIZE) >> RT_MM_PAGE_BITS;
+    extra  = align > RT_MM_PAGE_SIZE ? (align >> RT_MM_PAGE_BITS) - 1 : 0;
+
+    chunk = rt_page_alloc(npages + extra);
+    if (chunk == RT_NULL)
+        return RT_NULL;
+
+    if (extra)
+    {
+        aligned = RT_ALIGN((rt_ubase_t)chunk, align);
+        lead = (aligned - (rt_ubase_t)chunk) >> RT_MM_PAGE_BITS;
+        if (lead)
+            rt_page_free(chunk, lead);
+        if (extra - lead)
+            rt_page_free((void *)(aligned + (npages << RT_MM_PAGE_BITS)), extra - lead);
+
+        chunk = (void *)aligned;
+    }
+
+    /* set kup */
+    kup = btokup(chunk);
+    kup->type = PAGE_TYPE_LARGE;
+    kup->size = npages;
+
+    /* lock heap */
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+#ifdef RT_MEM_STATS
+    used_mem += npages << RT_MM_PAGE_BITS;
+    if (used_mem > max_mem)
+        max_mem = used_mem;
+#endif
+    rt_sem_release(&heap_sem);
+    SLAB_CHARGE(chunk);
+
+    RT_HEAP_PROFILE_ALLOC(chunk, size);
+    RT_OBJECT_HOOK_CALL(rt_malloc_hook, (chunk, size));
+
+    return chunk;
+}
+
+/**
+ * This function release the memory block, which is allocated by
+ * rt_malloc_align function and address is aligned.
+ *
+ * @param ptr the memory block pointer
+ */
+void rt_free_align(void *ptr)
+{
+    rt_free(ptr);
+}
+
+/**
+ * This function will change the size of a previously allocated memory block
+ * without moving it. It succeeds if the new size still fits in the zone
+ * chunk or the pages of the block.
+ *
+ * @param ptr the previously allocated memory block
+ * @param size the required new size
+ *
+ * @return ptr on successful, RT_NULL if the block can not be resized in place.
+ */
+void *rt_realloc_inplace(void *ptr, rt_size_t size)
+{
+    slab_zone *z;
+    struct memusage *kup;
+
+    RT_ASSERT(ptr != RT_NULL);
+
+    kup = btokup((rt_ubase_t)ptr & ~RT_MM_PAGE_MASK);
+    if (kup->type == PAGE_TYPE_LARGE)
+    {
+        if (size <= (kup->size << RT_MM_PAGE_BITS))
+            return ptr;
+    }
+    else if (kup->type == PAGE_TYPE_SMALL)
+    {
+        z = (slab_zone *)(((rt_ubase_t)ptr & ~RT_MM_PAGE_MASK) -
+                          kup->size * RT_MM_PAGE_SIZE);
+        RT_ASSERT(z->z_magic == ZALLOC_SLAB_MAGIC);
+
+        if (size <= z->z_chunksize)
+            return ptr;
+    }
+
+    return RT_NULL;
+}
+
 /**
  * This function will change the size of previously allocated memory block.
  *
@@ -679,7 +1114,12 @@ void *rt_realloc(void *ptr, rt_size_t size)
     struct memusage *kup;
 
     if (ptr == RT_NULL)
-        return rt_malloc(size);
+    {
+        nptr = rt_malloc(size);
+        RT_HEAP_PROFILE_CALLER(nptr);
+
+        return nptr;
+    }
     if (size == 0)
     {
         rt_free(ptr);
@@ -699,6 +1139,7 @@ void *rt_realloc(void *ptr, rt_size_t size)
         osize = kup->size << RT_MM_PAGE_BITS;
         if ((nptr = rt_malloc(size)) == RT_NULL)
             return RT_NULL;
+        RT_HEAP_PROFILE_CALLER(nptr);
         rt_memcpy(nptr, ptr, size > osize ? osize : size);
         rt_free(ptr);
 
@@ -721,6 +1162,7 @@ void *rt_realloc(void *ptr, rt_size_t size)
          */
         if ((nptr = rt_malloc(size)) == RT_NULL)
             return RT_NULL;
+        RT_HEAP_PROFILE_CALLER(nptr);
 
         rt_memcpy(nptr, ptr, size > z->z_chunksize ? z->z_chunksize : size);
         rt_free(ptr);
@@ -749,6 +1191,7 @@ void *rt_calloc(rt_size_t count, rt_size_t size)
 
     /* allocate 'count' objects of size 'size' */
     p = rt_malloc(count * size);
+    RT_HEAP_PROFILE_CALLER(p);
 
     /* zero the memory */
     if (p)
@@ -766,14 +1209,18 @@ void *rt_calloc(rt_size_t count, rt_size_t size)
 void rt_free(void *ptr)
 {
     slab_zone *z;
-    slab_chunk *chunk;
     struct memusage *kup;
+#ifdef RT_USING_HEAP_MAGAZINE
+    void *flush;
+#endif
 
     /* free a RT_NULL pointer */
     if (ptr == RT_NULL)
         return ;
 
     RT_OBJECT_HOOK_CALL(rt_free_hook, (ptr));
+    RT_HEAP_PROFILE_FREE(ptr);
+    SLAB_UNCHARGE(ptr);
 
     /* get memory usage */
 #if RT_DEBUG_SLAB
@@ -814,89 +1261,63 @@ void rt_free(void *ptr)
         return;
     }
 
-    /* lock heap */
-    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
-
-    /* zone case. get out zone. */
+#ifdef RT_USING_HEAP_MAGAZINE
     z = (slab_zone *)(((rt_ubase_t)ptr & ~RT_MM_PAGE_MASK) -
                       kup->size * RT_MM_PAGE_SIZE);
-    RT_ASSERT(z->z_magic == ZALLOC_SLAB_MAGIC);
-
-    chunk          = (slab_chunk *)ptr;
-    chunk->c_next  = z->z_freechunk;
-    z->z_freechunk = chunk;
-
-#ifdef RT_MEM_STATS
-    used_mem -= z->z_chunksize;
-#endif
-
-    /*
-     * Bump the number of free chunks.  If it becomes non-zero the zone
-     * must be added back onto the appropriate list.
-     */
-    if (z->z_nfree++ == 0)
-    {
-        z->z_next = zone_array[z->z_zoneindex];
-        zone_array[z->z_zoneindex] = z;
-    }
-
-    /*
-     * If the zone becomes totally free, and there are other zones we
-     * can allocate from, move this zone to the FreeZones list.  Since
-     * this code can be called from an IPI callback, do *NOT* try to mess
-     * with kernel_map here.  Hysteresis will be performed at malloc() time.
-     */
-    if (z->z_nfree == z->z_nmax &&
-        (z->z_next || zone_array[z->z_zoneindex] != z))
+    if (rt_heap_magazine_put(ptr, z->z_chunksize, &flush) == RT_EOK)
     {
-        slab_zone **pz;
-
-        RT_DEBUG_LOG(RT_DEBUG_SLAB, ("free zone 0x%x\n",
-                                     (rt_ubase_t)z, z->z_zoneindex));
-
-        /* remove zone from zone array list */
-        for (pz = &zone_array[z->z_zoneindex]; z != *pz; pz = &(*pz)->z_next)
-            ;
-        *pz = z->z_next;
-
-        /* reset zone */
-        z->z_magic = -1;
+        if (flush == RT_NULL)
+            return;
 
-        /* insert to free zone list */
-        z->z_next = zone_free;
-        zone_free = z;
+        /* release the chunks drained from magazine */
+        _slab_release_list(flush);
 
-        ++ zone_free_cnt;
+        return;
+    }
+#endif
 
-        /* release zone to page allocator */
-        if (zone_free_cnt > ZONE_RELEASE_THRESH)
-        {
-            register rt_base_t i;
+    /* lock heap */
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+    z = _slab_zone_release(ptr, kup);
+    /* unlock heap */
+    rt_sem_release(&heap_sem);
 
-            z         = zone_free;
-            zone_free = z->z_next;
-            -- zone_free_cnt;
+    /* release pages */
+    if (z != RT_NULL)
+        rt_page_free(z, zone_size / RT_MM_PAGE_SIZE);
+}
 
-            /* set message usage */
-            for (i = 0, kup = btokup(z); i < zone_page_cnt; i ++)
-            {
-                kup->type = PAGE_TYPE_FREE;
-                kup->size = 0;
-                kup ++;
-            }
+#ifdef RT_USING_HEAP_INFO
+/**
+ * This function will get the introspection information of system heap. The
+ * free blocks are the free page runs, the free chunks in zones are not
+ * counted.
+ *
+ * @param info the heap information
+ */
+void rt_heap_info_get(struct rt_heap_info *info)
+{
+    struct rt_page_head *b;
 
-            /* unlock heap */
-            rt_sem_release(&heap_sem);
+    RT_ASSERT(info != RT_NULL);
 
-            /* release pages */
-            rt_page_free(z, zone_size / RT_MM_PAGE_SIZE);
+    rt_memset(info, 0, sizeof(struct rt_heap_info));
 
-            return;
-        }
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+    if (rt_heap_stat_largest_lost(&heap_stat))
+    {
+        for (b = rt_page_list; b != RT_NULL; b = b->next)
+            rt_heap_stat_largest_found(&heap_stat, b->page << RT_MM_PAGE_BITS);
     }
-    /* unlock heap */
+    info->total = heap_end - heap_start;
+#ifdef RT_MEM_STATS
+    info->used     = used_mem;
+    info->max_used = max_mem;
+#endif
+    rt_heap_stat_merge(&heap_stat, info);
     rt_sem_release(&heap_sem);
 }
+#endif
 
 #ifdef RT_MEM_STATS
 void rt_memory_info(rt_uint32_t *total,
@@ -921,6 +1342,12 @@ void list_mem(void)
     rt_kprintf("total memory: %d\n", heap_end - heap_start);
     rt_kprintf("used memory : %d\n", used_mem);
     rt_kprintf("maximum allocated memory: %d\n", max_mem);
+#if defined(RT_USING_KMEM_CACHE) && defined(RT_USING_MEMPOOL)
+    rt_object_cache_dump();
+#endif
+#ifdef RT_USING_HEAP_MAGAZINE
+    rt_heap_magazine_dump();
+#endif
 }
 FINSH_FUNCTION_EXPORT(list_mem, list memory usage information)
 #endif
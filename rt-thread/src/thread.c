@@ -34,12 +34,16 @@
 extern rt_list_t rt_thread_priority_table[RT_THREAD_PRIORITY_MAX];
 extern struct rt_thread *rt_current_thread;
 extern rt_list_t rt_thread_defunct;
+#ifdef RT_USING_HEAP
+extern void rt_object_release(enum rt_object_class_type type, rt_object_t object);
+void rt_thread_release(rt_thread_t thread);
+#endif
 
 #ifdef RT_USING_HOOK
 
-static void (*rt_thread_suspend_hook)(rt_thread_t thread);
-static void (*rt_thread_resume_hook) (rt_thread_t thread);
-static void (*rt_thread_inited_hook) (rt_thread_t thread);
+static RT_OBJECT_HOOK_LIST(rt_thread_t thread) rt_thread_suspend_hook;
+static RT_OBJECT_HOOK_LIST(rt_thread_t thread) rt_thread_resume_hook;
+static RT_OBJECT_HOOK_LIST(rt_thread_t thread) rt_thread_inited_hook;
 
 /**
  * @ingroup Hook
@@ -47,11 +51,34 @@ static void (*rt_thread_inited_hook) (rt_thread_t thread);
  *
  * @param hook the specified hook function
  *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
+ *
  * @note the hook function must be simple and never be blocked or suspend.
  */
-void rt_thread_suspend_sethook(void (*hook)(rt_thread_t thread))
+rt_err_t rt_thread_suspend_sethook(void (*hook)(rt_thread_t thread))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_thread_suspend_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * @ingroup Hook
+ * This function will delete a hook function which was set by rt_thread_suspend_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_thread_suspend_delhook(void (*hook)(rt_thread_t thread))
 {
-    rt_thread_suspend_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_thread_suspend_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -60,11 +87,34 @@ void rt_thread_suspend_sethook(void (*hook)(rt_thread_t thread))
  *
  * @param hook the specified hook function
  *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
+ *
  * @note the hook function must be simple and never be blocked or suspend.
  */
-void rt_thread_resume_sethook(void (*hook)(rt_thread_t thread))
+rt_err_t rt_thread_resume_sethook(void (*hook)(rt_thread_t thread))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_thread_resume_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * @ingroup Hook
+ * This function will delete a hook function which was set by rt_thread_resume_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_thread_resume_delhook(void (*hook)(rt_thread_t thread))
 {
-    rt_thread_resume_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_thread_resume_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -72,10 +122,33 @@ void rt_thread_resume_sethook(void (*hook)(rt_thread_t thread))
  * This function sets a hook function when a thread is initialized.
  *
  * @param hook the specified hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
+ */
+rt_err_t rt_thread_inited_sethook(void (*hook)(rt_thread_t thread))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_thread_inited_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * @ingroup Hook
+ * This function will delete a hook function which was set by rt_thread_inited_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
  */
-void rt_thread_inited_sethook(void (*hook)(rt_thread_t thread))
+rt_err_t rt_thread_inited_delhook(void (*hook)(rt_thread_t thread))
 {
-    rt_thread_inited_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_thread_inited_hook, hook, result);
+
+    return result;
 }
 
 #endif
@@ -94,6 +167,15 @@ static void _thread_cleanup_execute(rt_thread_t thread)
     rt_hw_interrupt_enable(level);
 }
 
+static void _thread_timer_detach(rt_thread_t thread)
+{
+#ifdef RT_USING_THREAD_COMPACT
+    rt_thread_timeout_stop(thread);
+#else
+    rt_timer_detach(&(thread->thread_timer));
+#endif
+}
+
 void rt_thread_exit(void)
 {
     struct rt_thread *thread;
@@ -113,7 +195,7 @@ void rt_thread_exit(void)
     thread->stat = RT_THREAD_CLOSE;
 
     /* remove it from timer list */
-    rt_timer_detach(&thread->thread_timer);
+    _thread_timer_detach(thread);
 
     if (rt_object_is_systemobject((rt_object_t)thread) == RT_TRUE)
     {
@@ -185,14 +267,22 @@ static rt_err_t _rt_thread_init(struct rt_thread *thread,
     /* initialize cleanup function and user data */
     thread->cleanup   = 0;
     thread->user_data = 0;
+#ifdef RT_USING_HEAP_INFO
+    thread->heap_used = 0;
+#endif
 
     /* initialize thread timer */
+#ifdef RT_USING_THREAD_COMPACT
+    rt_list_init(&(thread->timeout_list));
+    thread->timeout_tick = 0;
+#else
     rt_timer_init(&(thread->thread_timer),
                   thread->name,
                   rt_thread_timeout,
                   thread,
                   0,
                   RT_TIMER_FLAG_ONE_SHOT);
+#endif
 
     RT_OBJECT_HOOK_CALL(rt_thread_inited_hook, (thread));
 
@@ -326,7 +416,7 @@ rt_err_t rt_thread_detach(rt_thread_t thread)
     _thread_cleanup_execute(thread);
 
     /* release thread timer */
-    rt_timer_detach(&(thread->thread_timer));
+    _thread_timer_detach(thread);
 
     /* change stat */
     thread->stat = RT_THREAD_CLOSE;
@@ -349,6 +439,202 @@ rt_err_t rt_thread_detach(rt_thread_t thread)
 }
 
 #ifdef RT_USING_HEAP
+#ifdef RT_USING_THREAD_CACHE
+#ifndef RT_THREAD_CACHE_SIZE
+#define RT_THREAD_CACHE_SIZE        8               /* numbers of cached threads */
+#endif
+#define THREAD_CACHE_STACK_MAX      16384           /* the biggest cached stack */
+#define THREAD_CACHE_SLACK_SHIFT    3               /* a cached stack may be 1/8 bigger than asked */
+
+/*
+ * The recycled threads with their stacks. The stacks are allocated in the
+ * size asked for, a cached one is only reused for a stack size a little
+ * smaller than it, so no stack is rounded up for the cache.
+ */
+static struct rt_thread *_thread_cache[RT_THREAD_CACHE_SIZE];
+static rt_uint16_t _thread_cache_count;
+
+/*
+ * get the cached thread of the smallest stack which fits stack_size, the
+ * latest cached one of the same size, whose memory is likely still in cache.
+ */
+static struct rt_thread *_thread_cache_get(rt_uint32_t stack_size)
+{
+    int index, fit = -1;
+    rt_base_t level;
+    struct rt_thread *thread = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+    for (index = _thread_cache_count - 1; index >= 0; index --)
+    {
+        if (_thread_cache[index]->stack_size >= stack_size &&
+            _thread_cache[index]->stack_size - stack_size <= (stack_size >> THREAD_CACHE_SLACK_SHIFT) &&
+            (fit < 0 || _thread_cache[index]->stack_size < _thread_cache[fit]->stack_size))
+        {
+            fit = index;
+        }
+    }
+    if (fit >= 0)
+    {
+        thread = _thread_cache[fit];
+        _thread_cache_count --;
+        for (index = fit; index < _thread_cache_count; index ++)
+            _thread_cache[index] = _thread_cache[index + 1];
+    }
+    rt_hw_interrupt_enable(level);
+
+    return thread;
+}
+
+static rt_bool_t _thread_cache_put(struct rt_thread *thread)
+{
+    rt_base_t level;
+    rt_bool_t result = RT_FALSE;
+
+    if (thread->stack_size > THREAD_CACHE_STACK_MAX)
+        return RT_FALSE;
+
+    level = rt_hw_interrupt_disable();
+    if (_thread_cache_count < RT_THREAD_CACHE_SIZE)
+    {
+        _thread_cache[_thread_cache_count] = thread;
+        _thread_cache_count ++;
+        result = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+
+/* return the cached threads to heap, RT_FALSE if there is none */
+static rt_bool_t _thread_cache_flush(void)
+{
+    rt_base_t level;
+    struct rt_thread *thread;
+    rt_bool_t result = RT_FALSE;
+
+    while (1)
+    {
+        thread = RT_NULL;
+
+        level = rt_hw_interrupt_disable();
+        if (_thread_cache_count > 0)
+        {
+            _thread_cache_count --;
+            thread = _thread_cache[_thread_cache_count];
+        }
+        rt_hw_interrupt_enable(level);
+
+        if (thread == RT_NULL)
+            break;
+
+#ifdef RT_USING_THREAD_COLOCATED_STACK
+#ifdef ARCH_CPU_STACK_GROWS_UPWARD
+        RT_KERNEL_FREE(thread);
+#else
+        RT_KERNEL_FREE(thread->stack_addr);
+#endif
+#else
+        RT_KERNEL_FREE(thread->stack_addr);
+        rt_object_release(RT_Object_Class_Thread, (rt_object_t)thread);
+#endif
+        result = RT_TRUE;
+    }
+
+    return result;
+}
+
+/*
+ * recycle the closed threads without waiting for the idle thread, except the
+ * current one: it may have deleted itself and still run on its stack.
+ */
+static void _thread_defunct_recycle(void)
+{
+    rt_base_t level;
+    rt_list_t *node;
+    struct rt_thread *thread;
+
+    while (1)
+    {
+        thread = RT_NULL;
+
+        level = rt_hw_interrupt_disable();
+        for (node = rt_thread_defunct.next; node != &rt_thread_defunct; node = node->next)
+        {
+            if (node != &(rt_current_thread->tlist))
+            {
+                thread = rt_list_entry(node, struct rt_thread, tlist);
+                rt_list_remove(node);
+                break;
+            }
+        }
+        rt_hw_interrupt_enable(level);
+
+        if (thread == RT_NULL)
+            break;
+
+        rt_thread_release(thread);
+    }
+}
+
+/* allocate the memory of thread, retry once after the cache is returned to heap */
+#define THREAD_MEMORY_ALLOC(ptr, alloc)                                     \
+    do                                                                      \
+    {                                                                       \
+        (ptr) = (alloc);                                                    \
+        if ((ptr) == RT_NULL && _thread_cache_flush())                      \
+            (ptr) = (alloc);                                                \
+    } while (0)
+#else
+#define THREAD_MEMORY_ALLOC(ptr, alloc) (ptr) = (alloc)
+#endif
+
+#if defined(RT_USING_THREAD_CACHE) || defined(RT_USING_THREAD_COLOCATED_STACK)
+/* add a thread in dynamic memory to object system as rt_object_allocate does */
+static void _thread_object_attach(struct rt_thread *thread, const char *name)
+{
+    rt_memset(thread, 0x0, sizeof(struct rt_thread));
+    rt_object_init((rt_object_t)thread, RT_Object_Class_Thread, name);
+    thread->type &= ~RT_Object_Class_Static;
+}
+#endif
+
+/*
+ * This function will release the memory of a closed dynamic thread, the
+ * thread shall not be running.
+ *
+ * @param thread the thread to be released
+ *
+ * @note Please do not invoke this function in user application.
+ */
+void rt_thread_release(rt_thread_t thread)
+{
+#ifdef RT_USING_THREAD_CACHE
+    if (_thread_cache_put(thread))
+    {
+        /* keep the memory in cache, only remove it from object system */
+        rt_object_detach((rt_object_t)thread);
+
+        return;
+    }
+#endif
+
+#ifdef RT_USING_THREAD_COLOCATED_STACK
+    rt_object_detach((rt_object_t)thread);
+    /* the thread object and stack are in one memory block */
+#ifdef ARCH_CPU_STACK_GROWS_UPWARD
+    RT_KERNEL_FREE(thread);
+#else
+    RT_KERNEL_FREE(thread->stack_addr);
+#endif
+#else
+    /* release thread's stack */
+    RT_KERNEL_FREE(thread->stack_addr);
+    /* delete thread object */
+    rt_object_delete((rt_object_t)thread);
+#endif
+}
+
 /**
  * This function will create a thread object and allocate thread object memory
  * and stack.
@@ -372,12 +658,53 @@ rt_thread_t rt_thread_create(const char *name,
     struct rt_thread *thread;
     void *stack_start;
 
-    thread = (struct rt_thread *)rt_object_allocate(RT_Object_Class_Thread,
-                                                    name);
+#ifdef RT_USING_THREAD_CACHE
+    /* recycle the threads which exited by themselves without the idle thread */
+    _thread_defunct_recycle();
+
+    thread = _thread_cache_get(stack_size);
+    if (thread != RT_NULL)
+    {
+        /* the whole cached stack is used */
+        stack_start = thread->stack_addr;
+        stack_size = thread->stack_size;
+        _thread_object_attach(thread, name);
+
+        goto __init;
+    }
+#endif
+
+#ifdef RT_USING_THREAD_COLOCATED_STACK
+    {
+        rt_uint8_t *block;
+        rt_size_t tcb_size;
+
+        /*
+         * one memory block for both the stack and thread object, the object
+         * is placed at the end where the stack does not grow to.
+         */
+        stack_size = RT_ALIGN(stack_size, RT_ALIGN_SIZE);
+        tcb_size = RT_ALIGN(sizeof(struct rt_thread), RT_ALIGN_SIZE);
+        THREAD_MEMORY_ALLOC(block, (rt_uint8_t *)RT_KERNEL_MALLOC(stack_size + tcb_size));
+        if (block == RT_NULL)
+            return RT_NULL;
+
+#ifdef ARCH_CPU_STACK_GROWS_UPWARD
+        thread = (struct rt_thread *)block;
+        stack_start = (void *)(block + tcb_size);
+#else
+        stack_start = (void *)block;
+        thread = (struct rt_thread *)(block + stack_size);
+#endif
+        _thread_object_attach(thread, name);
+    }
+#else
+    THREAD_MEMORY_ALLOC(thread, (struct rt_thread *)rt_object_allocate(RT_Object_Class_Thread,
+                                                                       name));
     if (thread == RT_NULL)
         return RT_NULL;
 
-    stack_start = (void *)RT_KERNEL_MALLOC(stack_size);
+    THREAD_MEMORY_ALLOC(stack_start, (void *)RT_KERNEL_MALLOC(stack_size));
     if (stack_start == RT_NULL)
     {
         /* allocate stack failure */
@@ -385,6 +712,11 @@ rt_thread_t rt_thread_create(const char *name,
 
         return RT_NULL;
     }
+#endif
+
+#ifdef RT_USING_THREAD_CACHE
+__init:
+#endif
 
     _rt_thread_init(thread,
                     name,
@@ -427,7 +759,7 @@ rt_err_t rt_thread_delete(rt_thread_t thread)
     _thread_cleanup_execute(thread);
 
     /* release thread timer */
-    rt_timer_detach(&(thread->thread_timer));
+    _thread_timer_detach(thread);
 
     /* disable interrupt */
     lock = rt_hw_interrupt_disable();
@@ -511,8 +843,7 @@ rt_err_t rt_thread_sleep(rt_tick_t tick)
     rt_thread_suspend(thread);
 
     /* reset the timeout of thread timer and start it */
-    rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &tick);
-    rt_timer_start(&(thread->thread_timer));
+    rt_thread_timeout_start(thread, tick);
 
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
@@ -569,8 +900,7 @@ rt_err_t rt_thread_delay_until(rt_tick_t *tick, rt_tick_t inc_tick)
         rt_thread_suspend(thread);
 
         /* reset the timeout of thread timer and start it */
-        rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, tick);
-        rt_timer_start(&(thread->thread_timer));
+        rt_thread_timeout_start(thread, *tick);
 
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
@@ -735,7 +1065,7 @@ rt_err_t rt_thread_suspend(rt_thread_t thread)
     thread->stat = RT_THREAD_SUSPEND | (thread->stat & ~RT_THREAD_STAT_MASK);
 
     /* stop thread timer anyway */
-    rt_timer_stop(&(thread->thread_timer));
+    rt_thread_timeout_stop(thread);
 
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
@@ -775,7 +1105,7 @@ rt_err_t rt_thread_resume(rt_thread_t thread)
     /* remove from suspend list */
     rt_list_remove(&(thread->tlist));
 
-    rt_timer_stop(&thread->thread_timer);
+    rt_thread_timeout_stop(thread);
 
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
@@ -832,3 +1162,82 @@ rt_thread_t rt_thread_find(char *name)
 }
 
 /**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#define THREAD_OFFSET(field)    ((rt_ubase_t)&(((struct rt_thread *)0)->field))
+#define THREAD_FIELD_END(field) (THREAD_OFFSET(field) + sizeof(((struct rt_thread *)0)->field))
+#define THREAD_FIELD(field)     rt_kprintf("%-16s %6d %6d\n", #field,                 \
+                                           (int)THREAD_OFFSET(field),               \
+                                           (int)sizeof(((struct rt_thread *)0)->field))
+
+/* the memory footprint of thread control block and the layout of its fields */
+static long thread_layout(void)
+{
+    rt_ubase_t hot_begin, hot_end, offset, timer_size;
+
+#ifdef RT_USING_THREAD_COMPACT
+    timer_size = sizeof(rt_list_t) + sizeof(rt_tick_t);
+#else
+    timer_size = sizeof(struct rt_timer);
+#endif
+
+    rt_kprintf("struct rt_thread: %d bytes, %s layout, timer %d bytes\n",
+               (int)sizeof(struct rt_thread),
+#ifdef RT_USING_THREAD_COMPACT
+               "compact",
+#else
+               "default",
+#endif
+               (int)timer_size);
+
+    rt_kprintf("field            offset   size\n");
+    rt_kprintf("---------------- ------ ------\n");
+    THREAD_FIELD(name);
+    THREAD_FIELD(list);
+    THREAD_FIELD(tlist);
+    THREAD_FIELD(sp);
+    THREAD_FIELD(stat);
+    THREAD_FIELD(current_priority);
+    THREAD_FIELD(number_mask);
+    THREAD_FIELD(remaining_tick);
+    THREAD_FIELD(init_tick);
+    THREAD_FIELD(error);
+#ifdef RT_USING_THREAD_COMPACT
+    THREAD_FIELD(timeout_list);
+#else
+    THREAD_FIELD(thread_timer);
+#endif
+    THREAD_FIELD(entry);
+    THREAD_FIELD(stack_addr);
+    THREAD_FIELD(cleanup);
+    THREAD_FIELD(user_data);
+
+    /* the span of the fields which are accessed by rt_schedule */
+    hot_begin = THREAD_OFFSET(tlist);
+    hot_end = THREAD_FIELD_END(tlist);
+    offset = THREAD_OFFSET(sp);
+    if (offset < hot_begin) hot_begin = offset;
+    offset = THREAD_FIELD_END(sp);
+    if (offset > hot_end) hot_end = offset;
+    offset = THREAD_OFFSET(stat);
+    if (offset < hot_begin) hot_begin = offset;
+    offset = THREAD_FIELD_END(number_mask);
+    if (offset > hot_end) hot_end = offset;
+    offset = THREAD_FIELD_END(remaining_tick);
+    if (offset > hot_end) hot_end = offset;
+
+    rt_kprintf("scheduler fields: %d - %d, %d cache lines of %d bytes\n",
+               (int)hot_begin, (int)hot_end,
+               (int)((hot_end - 1) / RT_CPU_CACHE_LINE_SZ - hot_begin / RT_CPU_CACHE_LINE_SZ + 1),
+               RT_CPU_CACHE_LINE_SZ);
+
+    return 0;
+}
+MSH_CMD_EXPORT(thread_layout, show the size and field layout of thread control block);
+
+#undef THREAD_FIELD
+#undef THREAD_FIELD_END
+#undef THREAD_OFFSET
+#endif
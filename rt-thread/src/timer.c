@@ -24,6 +24,11 @@
 /* hard timer list */
 static rt_list_t rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
 
+#ifdef RT_USING_THREAD_COMPACT
+/* thread timeout list, sorted by the timeout tick */
+static rt_list_t rt_thread_timeout_list = RT_LIST_OBJECT_INIT(rt_thread_timeout_list);
+#endif
+
 #ifdef RT_USING_TIMER_SOFT
 
 #define RT_SOFT_TIMER_IDLE              1
@@ -47,10 +52,10 @@ static rt_uint8_t timer_thread_stack[RT_TIMER_THREAD_STACK_SIZE];
 #endif
 
 #ifdef RT_USING_HOOK
-extern void (*rt_object_take_hook)(struct rt_object *object);
-extern void (*rt_object_put_hook)(struct rt_object *object);
-static void (*rt_timer_enter_hook)(struct rt_timer *timer);
-static void (*rt_timer_exit_hook)(struct rt_timer *timer);
+extern RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_take_hook;
+extern RT_OBJECT_HOOK_LIST(struct rt_object *object) rt_object_put_hook;
+static RT_OBJECT_HOOK_LIST(struct rt_timer *timer) rt_timer_enter_hook;
+static RT_OBJECT_HOOK_LIST(struct rt_timer *timer) rt_timer_exit_hook;
 
 /**
  * @addtogroup Hook
@@ -63,10 +68,32 @@ static void (*rt_timer_exit_hook)(struct rt_timer *timer);
  * timer timeout callback function.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
  */
-void rt_timer_enter_sethook(void (*hook)(struct rt_timer *timer))
+rt_err_t rt_timer_enter_sethook(void (*hook)(struct rt_timer *timer))
 {
-    rt_timer_enter_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_timer_enter_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_timer_enter_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
+ */
+rt_err_t rt_timer_enter_delhook(void (*hook)(struct rt_timer *timer))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_timer_enter_hook, hook, result);
+
+    return result;
 }
 
 /**
@@ -74,10 +101,32 @@ void rt_timer_enter_sethook(void (*hook)(struct rt_timer *timer))
  * timer timeout callback function.
  *
  * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the hook list is full.
+ */
+rt_err_t rt_timer_exit_sethook(void (*hook)(struct rt_timer *timer))
+{
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_ADD(rt_timer_exit_hook, hook, result);
+
+    return result;
+}
+
+/**
+ * This function will delete a hook function which was set by rt_timer_exit_sethook.
+ *
+ * @param hook the hook function
+ *
+ * @return RT_EOK on successful, -RT_ENOSYS if the hook was not found.
  */
-void rt_timer_exit_sethook(void (*hook)(struct rt_timer *timer))
+rt_err_t rt_timer_exit_delhook(void (*hook)(struct rt_timer *timer))
 {
-    rt_timer_exit_hook = hook;
+    rt_err_t result;
+
+    RT_OBJECT_HOOK_LIST_DEL(rt_timer_exit_hook, hook, result);
+
+    return result;
 }
 
 /**@}*/
@@ -513,6 +562,71 @@ rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg)
     return RT_EOK;
 }
 
+/**
+ * This function will start the timeout of a suspended thread, the thread will
+ * be resumed with -RT_ETIMEOUT by rt_thread_timeout() when it expires.
+ *
+ * @param thread the suspended thread
+ * @param tick the timeout ticks
+ */
+void rt_thread_timeout_start(rt_thread_t thread, rt_tick_t tick)
+{
+#ifdef RT_USING_THREAD_COMPACT
+    struct rt_thread *t;
+    rt_list_t *node;
+    register rt_base_t level;
+
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(tick < RT_TICK_MAX / 2);
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    rt_list_remove(&(thread->timeout_list));
+    thread->timeout_tick = rt_tick_get() + tick;
+
+    /* insert after the threads of the same timeout tick */
+    for (node = rt_thread_timeout_list.next;
+         node != &rt_thread_timeout_list;
+         node = node->next)
+    {
+        t = rt_list_entry(node, struct rt_thread, timeout_list);
+        if ((t->timeout_tick - thread->timeout_tick) != 0 &&
+            (t->timeout_tick - thread->timeout_tick) < RT_TICK_MAX / 2)
+        {
+            break;
+        }
+    }
+    rt_list_insert_before(node, &(thread->timeout_list));
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+#else
+    rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &tick);
+    rt_timer_start(&(thread->thread_timer));
+#endif
+}
+
+/**
+ * This function will stop the timeout of a thread.
+ *
+ * @param thread the thread
+ */
+void rt_thread_timeout_stop(rt_thread_t thread)
+{
+#ifdef RT_USING_THREAD_COMPACT
+    register rt_base_t level;
+
+    RT_ASSERT(thread != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&(thread->timeout_list));
+    rt_hw_interrupt_enable(level);
+#else
+    rt_timer_stop(&(thread->thread_timer));
+#endif
+}
+
 /**
  * This function will check timer list, if a timeout event happens, the
  * corresponding timeout function will be invoked.
@@ -582,6 +696,24 @@ void rt_timer_check(void)
         else break;
     }
 
+#ifdef RT_USING_THREAD_COMPACT
+    while (!rt_list_isempty(&rt_thread_timeout_list))
+    {
+        struct rt_thread *thread;
+
+        thread = rt_list_entry(rt_thread_timeout_list.next,
+                               struct rt_thread, timeout_list);
+        if ((current_tick - thread->timeout_tick) >= RT_TICK_MAX / 2)
+            break;
+
+        rt_list_remove(&(thread->timeout_list));
+        rt_thread_timeout(thread);
+
+        /* re-get tick */
+        current_tick = rt_tick_get();
+    }
+#endif
+
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
@@ -595,7 +727,31 @@ void rt_timer_check(void)
  */
 rt_tick_t rt_timer_next_timeout_tick(void)
 {
+#ifdef RT_USING_THREAD_COMPACT
+    struct rt_thread *thread;
+    register rt_base_t level;
+    rt_tick_t timeout_tick, current_tick;
+
+    timeout_tick = rt_timer_list_next_timeout(rt_timer_list);
+
+    level = rt_hw_interrupt_disable();
+    if (!rt_list_isempty(&rt_thread_timeout_list))
+    {
+        thread = rt_list_entry(rt_thread_timeout_list.next,
+                               struct rt_thread, timeout_list);
+        current_tick = rt_tick_get();
+        if (timeout_tick == RT_TICK_MAX ||
+            (thread->timeout_tick - current_tick) < (timeout_tick - current_tick))
+        {
+            timeout_tick = thread->timeout_tick;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return timeout_tick;
+#else
     return rt_timer_list_next_timeout(rt_timer_list);
+#endif
 }
 
 #ifdef RT_USING_TIMER_SOFT
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The cost of the memory of a request, which makes 50 small allocations and
+ * then releases them all: with rt_malloc and rt_free, and with an arena
+ * which is reset at the end of the request.
+ */
+
+#include <rtthread.h>
+#include <cpuport.h>
+#include "arena.h"
+
+#define BENCH_REQUESTS  200000
+#define REQUEST_ALLOCS  50
+
+static const rt_uint16_t request_sizes[REQUEST_ALLOCS] =
+{
+     24,  64,  16, 120,  32,  48, 200,  16,  16,  80,
+     40,  96,  24,  16, 256,  32,  64,  16,  48,  24,
+    128,  16,  32,  72,  16,  40, 180,  24,  16,  64,
+     32,  16,  96,  48,  16,  24, 160,  32,  16,  56,
+     16,  88,  24,  40,  16, 112,  32,  16,  64,  24,
+};
+
+static void *blocks[REQUEST_ALLOCS];
+
+static void report(const char *name, rt_uint64_t elapsed)
+{
+    elapsed /= BENCH_REQUESTS;
+    rt_kprintf("%-24s %d ns/request\n", name, (int)elapsed);
+}
+
+int main(void)
+{
+    struct rt_arena arena;
+    rt_uint64_t elapsed;
+    int request, index;
+
+    elapsed = sim_time_ns();
+    for (request = 0; request < BENCH_REQUESTS; request++)
+    {
+        for (index = 0; index < REQUEST_ALLOCS; index++)
+        {
+            blocks[index] = rt_malloc(request_sizes[index]);
+            RT_ASSERT(blocks[index] != RT_NULL);
+            *(volatile rt_uint8_t *)blocks[index] = 1;
+        }
+        for (index = 0; index < REQUEST_ALLOCS; index++)
+            rt_free(blocks[index]);
+    }
+    report("rt_malloc/rt_free", sim_time_ns() - elapsed);
+
+    rt_arena_init(&arena, 0);
+    elapsed = sim_time_ns();
+    for (request = 0; request < BENCH_REQUESTS; request++)
+    {
+        for (index = 0; index < REQUEST_ALLOCS; index++)
+        {
+            blocks[index] = rt_arena_alloc(&arena, request_sizes[index]);
+            RT_ASSERT(blocks[index] != RT_NULL);
+            *(volatile rt_uint8_t *)blocks[index] = 1;
+        }
+        rt_arena_reset(&arena);
+    }
+    report("rt_arena_alloc/reset", sim_time_ns() - elapsed);
+    rt_kprintf("%-24s %d chunks max\n", "", arena.chunk_max);
+    rt_arena_detach(&arena);
+
+    sim_exit(0);
+
+    return 0;
+}
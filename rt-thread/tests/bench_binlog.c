@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The cost of a log line with three arguments: formatted by rt_snprintf,
+ * which is what rt_kprintf costs before the console output, and recorded by
+ * rt_binlog. The timestamp of rt_binlog is the time stamp counter of host on
+ * the simulator, its cost is shown alone, a cycle counter read on target
+ * costs a few cycles.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <cpuport.h>
+#include "binlog.h"
+
+#define BENCH_LOGS      2000000
+
+static char line[RT_CONSOLEBUF_SIZE];
+static volatile rt_uint32_t sink;
+
+static void report(const char *name, rt_uint64_t elapsed)
+{
+    /* in picoseconds per log */
+    elapsed = elapsed * 1000 / BENCH_LOGS;
+    rt_kprintf("%-24s %d.%03d ns/log\n", name, (int)(elapsed / 1000), (int)(elapsed % 1000));
+}
+
+int main(void)
+{
+    rt_uint64_t elapsed;
+    int index;
+
+    elapsed = sim_time_ns();
+    for (index = 0; index < BENCH_LOGS; index++)
+        rt_snprintf(line, sizeof(line), "irq %d state %x name %s\n", index, index * 3, "uart1");
+    report("rt_snprintf", sim_time_ns() - elapsed);
+
+    elapsed = sim_time_ns();
+    for (index = 0; index < BENCH_LOGS; index++)
+        sink = rt_hw_timestamp_get();
+    report("rt_hw_timestamp_get", sim_time_ns() - elapsed);
+
+    /* the buffer is emptied every 32 logs, which costs little */
+    elapsed = sim_time_ns();
+    for (index = 0; index < BENCH_LOGS; index++)
+    {
+        rt_binlog("irq %d state %x name %s\n", index, index * 3, "uart1");
+        if ((index & 31) == 31)
+            rt_binlog_clear();
+    }
+    report("rt_binlog", sim_time_ns() - elapsed);
+
+    elapsed = sim_time_ns();
+    for (index = 0; index < BENCH_LOGS; index++)
+    {
+        rt_binlog("irq %d %d %d %d %d %d\n", index, index + 1, index + 2, index + 3, index + 4, index + 5);
+        if ((index & 31) == 31)
+            rt_binlog_clear();
+    }
+    report("rt_binlog, 6 arguments", sim_time_ns() - elapsed);
+
+    sim_exit(0);
+
+    return 0;
+}
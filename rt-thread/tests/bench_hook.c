@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The cost of a hook call site, in a function which is called in a loop:
+ * without hook site, with the single hook pointer used before the hook lists,
+ * and with a hook list, both empty and with one hook.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <cpuport.h>
+
+#define BENCH_CALLS     100000000
+
+#define POINTER_HOOK_CALL(func, argv) \
+    do { if ((func) != RT_NULL) func argv; } while (0)
+
+static RT_OBJECT_HOOK_LIST(int value) list_hook;
+static void (*volatile pointer_hook)(int value);
+static volatile int sink;
+
+static void hook(int value)
+{
+    sink += value;
+}
+
+static void __attribute__((noinline)) site_none(int value)
+{
+    sink += value;
+}
+
+static void __attribute__((noinline)) site_pointer(int value)
+{
+    POINTER_HOOK_CALL(pointer_hook, (value));
+    sink += value;
+}
+
+static void __attribute__((noinline)) site_list(int value)
+{
+    RT_OBJECT_HOOK_CALL(list_hook, (value));
+    sink += value;
+}
+
+static void bench(const char *name, void (*site)(int value))
+{
+    rt_uint64_t elapsed;
+    int index;
+
+    elapsed = sim_time_ns();
+    for (index = 0; index < BENCH_CALLS; index++)
+        site(index);
+    elapsed = sim_time_ns() - elapsed;
+
+    /* in picoseconds per call */
+    elapsed = elapsed * 1000 / BENCH_CALLS;
+    rt_kprintf("%-24s %d.%03d ns/call\n", name, (int)(elapsed / 1000), (int)(elapsed % 1000));
+}
+
+int main(void)
+{
+    rt_err_t result;
+
+    bench("no hook site", site_none);
+    bench("hook pointer, empty", site_pointer);
+    bench("hook list, empty", site_list);
+
+    pointer_hook = hook;
+    RT_OBJECT_HOOK_LIST_ADD(list_hook, hook, result);
+    RT_ASSERT(result == RT_EOK);
+
+    bench("hook pointer, 1 hook", site_pointer);
+    bench("hook list, 1 hook", site_list);
+
+    sim_exit(0);
+
+    return 0;
+}
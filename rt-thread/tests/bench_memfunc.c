@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Throughput of rt_memcpy/rt_memset/rt_memmove/rt_memcmp in MB/s, by size
+ * and by the misalignment of destination/source.
+ */
+
+#include <rtthread.h>
+#include <cpuport.h>
+
+#define BENCH_BYTES     (64 * 1024 * 1024)
+
+ALIGN(64) static rt_uint8_t buf_a[65536 + 128];
+ALIGN(64) static rt_uint8_t buf_b[65536 + 128];
+
+static const rt_size_t sizes[] = {8, 32, 128, 512, 4096, 65536};
+static const int align[][2] = {{0, 0}, {1, 1}, {1, 3}};
+static const char *const names[] = {"memcpy", "memset", "memmove", "memcmp"};
+
+static volatile int sink;
+
+static rt_uint32_t bench(int op, rt_uint8_t *dst, rt_uint8_t *src, rt_size_t size)
+{
+    rt_uint64_t start, elapsed;
+    rt_uint32_t index, count;
+
+    count = BENCH_BYTES / (size + 16);
+    start = sim_time_ns();
+    for (index = 0; index < count; index++)
+    {
+        switch (op)
+        {
+        case 0: rt_memcpy(dst, src, size); break;
+        case 1: rt_memset(dst, index, size); break;
+        case 2: rt_memmove(dst + 8, dst, size); break;
+        default: sink += rt_memcmp(dst, src, size); break;
+        }
+        __asm__ volatile("" ::: "memory");
+    }
+    elapsed = sim_time_ns() - start;
+
+    /* bytes per microsecond is MB/s */
+    return (rt_uint32_t)((rt_uint64_t)size * count * 1000 / (elapsed + 1));
+}
+
+int main(void)
+{
+    int op, al, si;
+
+    rt_kprintf("MB/s    dst/src");
+    for (si = 0; si < (int)(sizeof(sizes) / sizeof(sizes[0])); si++)
+        rt_kprintf(" %7d", sizes[si]);
+    rt_kprintf("\n");
+
+    for (op = 0; op < 4; op++)
+    {
+        for (al = 0; al < 3; al++)
+        {
+            /* there is no source of memset */
+            if (op == 1 && al == 2)
+                continue;
+
+            rt_kprintf("%-7s %d/%d    ", names[op], align[al][0], align[al][1]);
+            for (si = 0; si < (int)(sizeof(sizes) / sizeof(sizes[0])); si++)
+            {
+                rt_memset(buf_a, 1, sizeof(buf_a));
+                rt_memset(buf_b, 1, sizeof(buf_b));
+                rt_kprintf(" %7d", bench(op, buf_a + align[al][0], buf_b + align[al][1], sizes[si]));
+            }
+            rt_kprintf("\n");
+        }
+    }
+
+    sim_exit(0);
+
+    return 0;
+}
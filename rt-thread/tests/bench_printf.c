@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Time of rt_snprintf in ns per call: the plain conversions, a log line and
+ * the conversions with width, which take the generic path. Built with
+ * __ARM_ARCH_6M__, it shows the division by 10 of the cores without divider.
+ */
+
+#include <rtthread.h>
+#include <cpuport.h>
+
+#define BENCH_CALLS     2000000
+
+static char buf[128];
+static const char *const names[] = {"%d small", "%d large", "%u %x %s", "log line", "%5d %08x", "%lu large"};
+
+int main(void)
+{
+    rt_uint64_t start, elapsed;
+    rt_uint32_t index;
+    int op;
+
+    for (op = 0; op < (int)(sizeof(names) / sizeof(names[0])); op++)
+    {
+        start = sim_time_ns();
+        for (index = 0; index < BENCH_CALLS; index++)
+        {
+            switch (op)
+            {
+            case 0: rt_snprintf(buf, sizeof(buf), "%d", (int)(index & 255)); break;
+            case 1: rt_snprintf(buf, sizeof(buf), "%d", (int)(index * 2654435761U) | 0x40000000); break;
+            case 2: rt_snprintf(buf, sizeof(buf), "%u %x %s", index, index * 7, "thread"); break;
+            case 3:
+                rt_snprintf(buf, sizeof(buf), "[%d] tid=%s prio=%d stack=%x used=%d%%\n",
+                            (int)index, "tshell", 20, 0x2000f00, 45);
+                break;
+            case 4: rt_snprintf(buf, sizeof(buf), "%5d %08x", (int)(index & 4095), index); break;
+            default: rt_snprintf(buf, sizeof(buf), "%lu", (unsigned long)(index * 2654435761U) | 0x40000000); break;
+            }
+            __asm__ volatile("" ::: "memory");
+        }
+        elapsed = sim_time_ns() - start;
+
+        /* in tenths of ns per call */
+        elapsed = elapsed * 10 / BENCH_CALLS;
+        rt_kprintf("%-10s %4d.%d ns\n", names[op], (int)(elapsed / 10), (int)(elapsed % 10));
+    }
+
+    sim_exit(0);
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Time of rt_strlen/rt_strnlen/rt_strcmp/rt_strncmp in ns per call, by the
+ * length of strings and the alignment of start.
+ */
+
+#include <rtthread.h>
+#include <cpuport.h>
+
+#define BENCH_CALLS     5000000
+
+ALIGN(64) static char buf_a[600];
+ALIGN(64) static char buf_b[600];
+
+static const int lengths[] = {4, 8, 16, 32, 64, 256};
+static const char *const names[] = {"strlen", "strnlen", "strcmp", "strncmp"};
+
+static volatile long sink;
+
+/* in tenths of ns per call */
+static rt_uint32_t bench(int op, const char *a, const char *b)
+{
+    rt_uint64_t start, elapsed;
+    rt_uint32_t index;
+
+    start = sim_time_ns();
+    for (index = 0; index < BENCH_CALLS; index++)
+    {
+        switch (op)
+        {
+        case 0: sink += rt_strlen(a); break;
+        case 1: sink += rt_strnlen(a, 500); break;
+        case 2: sink += rt_strcmp(a, b); break;
+        default: sink += rt_strncmp(a, b, 500); break;
+        }
+        __asm__ volatile("" ::: "memory");
+    }
+    elapsed = sim_time_ns() - start;
+
+    return (rt_uint32_t)(elapsed * 10 / BENCH_CALLS);
+}
+
+int main(void)
+{
+    rt_uint32_t tenths;
+    int op, offset, li;
+
+    rt_kprintf("ns      start");
+    for (li = 0; li < (int)(sizeof(lengths) / sizeof(lengths[0])); li++)
+        rt_kprintf(" %6d", lengths[li]);
+    rt_kprintf("\n");
+
+    for (op = 0; op < 4; op++)
+    {
+        for (offset = 0; offset < 2; offset++)
+        {
+            rt_kprintf("%-7s +%d   ", names[op], offset);
+            for (li = 0; li < (int)(sizeof(lengths) / sizeof(lengths[0])); li++)
+            {
+                rt_memset(buf_a, 'q', sizeof(buf_a));
+                rt_memset(buf_b, 'q', sizeof(buf_b));
+                buf_a[offset + lengths[li]] = '\0';
+                buf_b[offset + lengths[li]] = '\0';
+
+                tenths = bench(op, buf_a + offset, buf_b + offset);
+                rt_kprintf(" %4d.%d", tenths / 10, tenths % 10);
+            }
+            rt_kprintf("\n");
+        }
+    }
+
+    sim_exit(0);
+
+    return 0;
+}
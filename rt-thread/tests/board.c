@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined(RT_USING_USER_MAIN) && defined(RT_USING_HEAP)
+#define RT_HEAP_SIZE (8 * 1024 * 1024)
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t rt_heap[RT_HEAP_SIZE];
+#endif
+
+/*
+ * There is no timer interrupt on the simulator. The idle thread runs when the
+ * other threads are waiting for something, so the time jumps to the next tick.
+ */
+static void sim_tick(void)
+{
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    rt_tick_increase();
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+
+/**
+ * This function will initial your board.
+ */
+void rt_hw_board_init(void)
+{
+    rt_thread_idle_sethook(sim_tick);
+
+    /* Call components board initial (use INIT_BOARD_EXPORT()) */
+#ifdef RT_USING_COMPONENTS_INIT
+    rt_components_board_init();
+#endif
+
+#if defined(RT_USING_USER_MAIN) && defined(RT_USING_HEAP)
+    rt_system_heap_init(rt_heap, rt_heap + RT_HEAP_SIZE);
+#endif
+}
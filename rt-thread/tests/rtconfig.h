@@ -0,0 +1,62 @@
+/* RT-Thread config file of the host tests */
+
+#ifndef __RTTHREAD_CFG_H__
+#define __RTTHREAD_CFG_H__
+
+/*
+ * The tests are built on the simulator (libcpu/sim), an option under test is
+ * set by the Makefile with -D, e.g. -DRT_USING_SLAB selects the slab heap.
+ */
+
+#if defined(__x86_64__)
+#define ARCH_CPU_64BIT
+#define RT_ALIGN_SIZE   8
+#else
+#define RT_ALIGN_SIZE   4
+#endif
+
+/* Basic Configuration */
+#define RT_THREAD_PRIORITY_MAX  32
+#define RT_TICK_PER_SECOND  1000
+#define RT_NAME_MAX    8
+#define RT_USING_USER_MAIN
+#define RT_MAIN_THREAD_STACK_SIZE     65536
+#define RT_MAIN_THREAD_PRIORITY       10
+
+/* the host code needs more stack than a MCU */
+#define IDLE_THREAD_STACK_SIZE        16384
+
+/* Debug Configuration */
+#define RT_DEBUG
+#define RT_DEBUG_INIT 0
+#define RT_USING_OVERFLOW_CHECK
+
+/* Hook Configuration, the board simulates the OS tick in idle hook */
+#define RT_USING_HOOK
+#define RT_USING_IDLE_HOOK
+
+/* Software timers Configuration */
+#define RT_TIMER_THREAD_PRIO        4
+#define RT_TIMER_THREAD_STACK_SIZE  16384
+
+/* IPC(Inter-process communication) Configuration */
+#define RT_USING_SEMAPHORE
+#define RT_USING_MUTEX
+#define RT_USING_EVENT
+#define RT_USING_MAILBOX
+#define RT_USING_MESSAGEQUEUE
+
+/* Memory Management Configuration */
+#define RT_USING_MEMPOOL
+#define RT_USING_HEAP
+#if defined(RT_USING_MEMHEAP_AS_HEAP)
+#define RT_USING_MEMHEAP
+#elif !defined(RT_USING_SLAB)
+#define RT_USING_SMALL_MEM
+#endif
+
+/* Console Configuration */
+#define RT_USING_CONSOLE
+#define RT_CONSOLEBUF_SIZE          256
+
+#endif
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the arena allocator (components/utiity/arena): the chunks from heap
+ * and from a memory pool, the dedicated chunks of the allocations larger than
+ * a chunk, rewind and reset.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+#include "arena.h"
+
+#define CHUNK_SIZE      1024
+#define POOL_BLOCK      512
+
+static struct rt_arena arena;
+static rt_uint32_t used;
+static rt_uint8_t pool[16 * 1024];
+
+static rt_uint32_t used_memory(void)
+{
+    rt_uint32_t total, used, max_used;
+
+    rt_memory_info(&total, &used, &max_used);
+
+    return used;
+}
+
+void setUp(void)
+{
+    used = used_memory();
+    rt_arena_init(&arena, CHUNK_SIZE);
+}
+
+void tearDown(void)
+{
+    rt_arena_detach(&arena);
+    TEST_ASSERT_EQUAL(0, arena.chunk_count);
+    TEST_ASSERT_EQUAL(used, used_memory());
+}
+
+static void test_alloc(void)
+{
+    rt_uint8_t *a, *b;
+
+    a = rt_arena_alloc(&arena, 10);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL(0, (rt_ubase_t)a % RT_ALIGN_SIZE);
+    b = rt_arena_alloc(&arena, 10);
+    TEST_ASSERT_EQUAL_PTR(a + RT_ALIGN(10, RT_ALIGN_SIZE), b);
+
+    TEST_ASSERT_EQUAL_STRING("hello", rt_arena_strdup(&arena, "hello"));
+    b = rt_arena_calloc(&arena, 4, 8);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EACH_EQUAL_HEX8(0, b, 32);
+    TEST_ASSERT_EQUAL(1, arena.chunk_count);
+}
+
+/* an allocation larger than a chunk does not take the rest of current chunk */
+static void test_oversize_keeps_chunk(void)
+{
+    rt_uint8_t *a, *big, *b;
+
+    a = rt_arena_alloc(&arena, 16);
+    TEST_ASSERT_NOT_NULL(a);
+
+    big = rt_arena_alloc(&arena, 2 * CHUNK_SIZE);
+    TEST_ASSERT_NOT_NULL(big);
+    rt_memset(big, 0x5a, 2 * CHUNK_SIZE);
+    TEST_ASSERT_EQUAL(2, arena.chunk_count);
+
+    b = rt_arena_alloc(&arena, 16);
+    TEST_ASSERT_EQUAL_PTR(a + 16, b);
+
+    /* the current chunk is still filled before a new one */
+    while (arena.chunk_count == 2)
+        TEST_ASSERT_NOT_NULL(rt_arena_alloc(&arena, 100));
+    TEST_ASSERT_EQUAL(3, arena.chunk_count);
+}
+
+/* the dedicated chunks allocated after the position are released */
+static void test_rewind(void)
+{
+    struct rt_arena_mark mark;
+    rt_uint8_t *a, *b;
+    int index;
+
+    a = rt_arena_alloc(&arena, 10);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(rt_arena_alloc(&arena, 2000));
+    rt_arena_mark(&arena, &mark);
+
+    /* behind the marked chunk */
+    TEST_ASSERT_NOT_NULL(rt_arena_alloc(&arena, 2000));
+    TEST_ASSERT_NOT_NULL(rt_arena_alloc(&arena, 3000));
+    TEST_ASSERT_EQUAL(4, arena.chunk_count);
+    rt_arena_rewind(&arena, &mark);
+    TEST_ASSERT_EQUAL(2, arena.chunk_count);
+
+    /* and behind the new chunks */
+    for (index = 0; index < 30; index++)
+    {
+        TEST_ASSERT_NOT_NULL(rt_arena_alloc(&arena, 100));
+        TEST_ASSERT_NOT_NULL(rt_arena_alloc(&arena, 1500));
+    }
+    TEST_ASSERT_TRUE(arena.chunk_count > 32);
+    rt_arena_rewind(&arena, &mark);
+    TEST_ASSERT_EQUAL(2, arena.chunk_count);
+
+    b = rt_arena_alloc(&arena, 10);
+    TEST_ASSERT_EQUAL_PTR(a + RT_ALIGN(10, RT_ALIGN_SIZE), b);
+}
+
+/* one chunk of the normal size is kept */
+static void test_reset(void)
+{
+    rt_uint8_t *a;
+    int index;
+
+    /* the first chunk is dedicated */
+    TEST_ASSERT_NOT_NULL(rt_arena_alloc(&arena, 2000));
+    a = rt_arena_alloc(&arena, 10);
+    TEST_ASSERT_NOT_NULL(a);
+    for (index = 0; index < 30; index++)
+    {
+        TEST_ASSERT_NOT_NULL(rt_arena_alloc(&arena, 100));
+        TEST_ASSERT_NOT_NULL(rt_arena_alloc(&arena, 1500));
+    }
+
+    rt_arena_reset(&arena);
+    TEST_ASSERT_EQUAL(1, arena.chunk_count);
+    a = rt_arena_alloc(&arena, 1000 - 16);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL(1, arena.chunk_count);
+
+    rt_arena_reset(&arena);
+    TEST_ASSERT_EQUAL_PTR(a, rt_arena_alloc(&arena, 4));
+}
+
+static void test_mempool(void)
+{
+    struct rt_mempool mp;
+    struct rt_arena pool_arena;
+    int index;
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_mp_init(&mp, "arena", pool, sizeof(pool), POOL_BLOCK));
+    rt_arena_init_mp(&pool_arena, &mp);
+
+    TEST_ASSERT_NULL(rt_arena_alloc(&pool_arena, POOL_BLOCK + 1));
+    for (index = 0; index < 100; index++)
+        TEST_ASSERT_NOT_NULL(rt_arena_alloc(&pool_arena, 64));
+
+    rt_arena_reset(&pool_arena);
+    TEST_ASSERT_EQUAL(1, pool_arena.chunk_count);
+    TEST_ASSERT_EQUAL(mp.block_total_count - 1, mp.block_free_count);
+
+    rt_arena_detach(&pool_arena);
+    TEST_ASSERT_EQUAL(mp.block_total_count, mp.block_free_count);
+    rt_mp_detach(&mp);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_alloc);
+    RUN_TEST(test_oversize_keeps_chunk);
+    RUN_TEST(test_rewind);
+    RUN_TEST(test_reset);
+    RUN_TEST(test_mempool);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
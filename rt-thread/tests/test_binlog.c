@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the binary log: the records of each number of arguments are read
+ * back whole, across the end of ring, and the logs which do not fit are
+ * dropped.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+#include "binlog.h"
+
+#define RECORD_WORDS    (RT_BINLOG_HEADER_SIZE + RT_BINLOG_ARGS_MAX)
+
+static rt_ubase_t record[RECORD_WORDS];
+
+static const char *const formats[RT_BINLOG_ARGS_MAX + 1] =
+{
+    "none\n", "%d\n", "%d %d\n", "%d %d %d\n", "%d %d %d %d\n",
+    "%d %d %d %d %d\n", "%d %d %d %d %d %d\n", "%d %d %d %d %d %d %d\n",
+    "%d %d %d %d %d %d %d %d\n",
+};
+
+/* log the numbers from base with argc arguments */
+static void log_args(int argc, rt_ubase_t base)
+{
+    switch (argc)
+    {
+    case 0: rt_binlog("none\n"); break;
+    case 1: rt_binlog("%d\n", base); break;
+    case 2: rt_binlog("%d %d\n", base, base + 1); break;
+    case 3: rt_binlog("%d %d %d\n", base, base + 1, base + 2); break;
+    case 4: rt_binlog("%d %d %d %d\n", base, base + 1, base + 2, base + 3); break;
+    case 5: rt_binlog("%d %d %d %d %d\n", base, base + 1, base + 2, base + 3, base + 4); break;
+    case 6:
+        rt_binlog("%d %d %d %d %d %d\n", base, base + 1, base + 2, base + 3, base + 4, base + 5);
+        break;
+    case 7:
+        rt_binlog("%d %d %d %d %d %d %d\n", base, base + 1, base + 2, base + 3, base + 4, base + 5,
+                  base + 6);
+        break;
+    default:
+        rt_binlog("%d %d %d %d %d %d %d %d\n", base, base + 1, base + 2, base + 3, base + 4,
+                  base + 5, base + 6, base + 7);
+        break;
+    }
+}
+
+/* read one record and check it is the one of log_args */
+static void check_record(int argc, rt_ubase_t base)
+{
+    int index;
+
+    TEST_ASSERT_EQUAL(RT_BINLOG_HEADER_SIZE + argc,
+                      rt_binlog_read(record, RT_BINLOG_HEADER_SIZE + argc));
+    TEST_ASSERT_EQUAL_STRING(formats[argc], (const char *)record[0]);
+    TEST_ASSERT_EQUAL(argc, record[1]);
+    for (index = 0; index < argc; index++)
+        TEST_ASSERT_EQUAL(base + index, record[RT_BINLOG_HEADER_SIZE + index]);
+}
+
+void setUp(void)
+{
+    rt_binlog_clear();
+}
+
+void tearDown(void)
+{
+}
+
+static void test_arguments(void)
+{
+    int argc;
+
+    for (argc = 0; argc <= RT_BINLOG_ARGS_MAX; argc++)
+        log_args(argc, argc * 100);
+    for (argc = 0; argc <= RT_BINLOG_ARGS_MAX; argc++)
+        check_record(argc, argc * 100);
+
+    TEST_ASSERT_EQUAL(0, rt_binlog_read(record, RECORD_WORDS));
+}
+
+/* the records of each size are written across the end of ring */
+static void test_wrap(void)
+{
+    rt_ubase_t base;
+    int argc, round;
+
+    for (round = 0, base = 0; round < 5 * RT_BINLOG_BUFFER_SIZE; round++)
+    {
+        argc = round % (RT_BINLOG_ARGS_MAX + 1);
+        /* one record behind, so some are read across the end too */
+        log_args(argc, base);
+        if (round > 0)
+            check_record((round - 1) % (RT_BINLOG_ARGS_MAX + 1), base - 10);
+        base += 10;
+    }
+    check_record((round - 1) % (RT_BINLOG_ARGS_MAX + 1), base - 10);
+}
+
+/* the records which do not fit are dropped, the ones in buffer are whole */
+static void test_full(void)
+{
+    rt_uint32_t stamp = 0;
+    int count, index;
+
+    /* a record of 5 words, the buffer is not a multiple of it */
+    for (count = 0; count < RT_BINLOG_BUFFER_SIZE; count++)
+        log_args(2, count);
+
+    for (index = 0; index < RT_BINLOG_BUFFER_SIZE / 5; index++)
+    {
+        check_record(2, index);
+        /* the timestamps are in order */
+        TEST_ASSERT_TRUE(index == 0 || (rt_int32_t)(record[2] - stamp) >= 0);
+        stamp = record[2];
+    }
+    TEST_ASSERT_EQUAL(0, rt_binlog_read(record, RECORD_WORDS));
+
+    /* the space is given back */
+    log_args(8, 1000);
+    check_record(8, 1000);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_arguments);
+    RUN_TEST(test_wrap);
+    RUN_TEST(test_full);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the asynchronous console (RT_USING_CONSOLE_ASYNC): the output of
+ * rt_kprintf is written out by the flusher in order, across the end of
+ * ring, the output which does not fit is dropped, and rt_kprintf takes no
+ * more stack than the formatting itself.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define CAPTURE_SIZE    16384
+#define STACK_SIZE      8192
+
+static struct rt_device capture_device;
+static char captured[CAPTURE_SIZE];
+static rt_size_t captured_length;
+static char expected[CAPTURE_SIZE];
+static rt_size_t expected_length;
+
+static rt_bool_t capturing;
+
+/* the output is kept during a test, and goes to host console out of it */
+static rt_size_t capture_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    char text[64];
+    rt_size_t length, written;
+
+    if (capturing)
+    {
+        if (size > CAPTURE_SIZE - captured_length)
+            size = CAPTURE_SIZE - captured_length;
+        rt_memcpy(&captured[captured_length], buffer, size);
+        captured_length += size;
+
+        return size;
+    }
+
+    for (written = 0; written < size; written += length)
+    {
+        length = size - written;
+        if (length > sizeof(text) - 1)
+            length = sizeof(text) - 1;
+        rt_memcpy(text, (const char *)buffer + written, length);
+        text[length] = '\0';
+        rt_hw_console_output(text);
+    }
+
+    return size;
+}
+
+/* print a line, and keep it in the expected output */
+static rt_size_t print_line(int index)
+{
+    rt_size_t length;
+
+    rt_kprintf("line %d of the console test %s\n", index, index & 1 ? "odd" : "even");
+    length = rt_snprintf(&expected[expected_length], CAPTURE_SIZE - expected_length,
+                         "line %d of the console test %s\n", index, index & 1 ? "odd" : "even");
+
+    return length;
+}
+
+static void check_output(void)
+{
+    rt_thread_mdelay(10);
+    capturing = RT_FALSE;
+
+    TEST_ASSERT_EQUAL(expected_length, captured_length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, captured, expected_length);
+}
+
+void setUp(void)
+{
+    /* the flusher runs once main sleeps */
+    rt_thread_mdelay(10);
+    captured_length = 0;
+    expected_length = 0;
+    capturing = RT_TRUE;
+}
+
+void tearDown(void)
+{
+    capturing = RT_FALSE;
+}
+
+/* the lines are written out in order, many of them across the end of ring */
+static void test_order(void)
+{
+    int index;
+
+    for (index = 0; index < 300; index++)
+    {
+        expected_length += print_line(index);
+        if (index % 10 == 9)
+            rt_thread_mdelay(1);
+    }
+
+    check_output();
+}
+
+/* the lines which do not fit are dropped whole, and reported */
+static void test_full(void)
+{
+    rt_size_t length, free = RT_CONSOLE_ASYNC_BUF_SIZE;
+    int index, dropped = 0;
+
+    for (index = 0; index < 200; index++)
+    {
+        length = print_line(index);
+        /* the terminating null byte shall fit too */
+        if (length < free)
+        {
+            expected_length += length;
+            free -= length;
+        }
+        else
+        {
+            dropped++;
+        }
+    }
+    TEST_ASSERT_TRUE(dropped > 0);
+    expected_length += rt_snprintf(&expected[expected_length], CAPTURE_SIZE - expected_length,
+                                   "\n[console: %d messages dropped]\n", dropped);
+
+    check_output();
+}
+
+static struct rt_thread snprintf_thread, kprintf_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t snprintf_stack[STACK_SIZE];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t kprintf_stack[STACK_SIZE];
+static char line[RT_CONSOLEBUF_SIZE];
+
+static void snprintf_entry(void *parameter)
+{
+    rt_snprintf(line, sizeof(line), "%s %d %x\n", "stack", 12345, 0x5a5a);
+}
+
+static void kprintf_entry(void *parameter)
+{
+    rt_kprintf("%s %d %x\n", "stack", 12345, 0x5a5a);
+}
+
+/* the bytes of stack used by a thread running entry */
+static rt_size_t stack_used(rt_thread_t thread, rt_uint8_t *stack, void (*entry)(void *parameter))
+{
+    rt_size_t unused;
+
+    rt_thread_init(thread, "stack", entry, RT_NULL, stack, STACK_SIZE, 5, 10);
+    /* it is done once started, as its priority is higher */
+    rt_thread_startup(thread);
+
+    for (unused = 0; unused < STACK_SIZE && stack[unused] == '#'; unused++);
+
+    return STACK_SIZE - unused;
+}
+
+/* there is no buffer on the stack of callers, which may be the interrupts */
+static void test_stack(void)
+{
+    rt_size_t formatting, printing;
+
+    formatting = stack_used(&snprintf_thread, snprintf_stack, snprintf_entry);
+    printing = stack_used(&kprintf_thread, kprintf_stack, kprintf_entry);
+    /* the line is written out to capture */
+    rt_thread_mdelay(10);
+    TEST_ASSERT_TRUE(printing < formatting + RT_CONSOLEBUF_SIZE / 2);
+}
+
+int main(void)
+{
+    capture_device.type = RT_Device_Class_Char;
+    capture_device.write = capture_write;
+    rt_device_register(&capture_device, "capture", RT_DEVICE_FLAG_RDWR);
+    rt_console_set_device("capture");
+    rt_console_async_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_order);
+    RUN_TEST(test_full);
+    RUN_TEST(test_stack);
+    /* the console is synchronous for the report */
+    rt_console_flush();
+    sim_exit(UNITY_END());
+
+    return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the heap introspection (RT_USING_HEAP_INFO) on the small memory,
+ * slab and memheap allocators: a block is uncharged from the thread which
+ * allocated it, and the largest free block is exact.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define STACK_SIZE      8192
+#define BLOCK_SIZE      1000
+
+static struct rt_semaphore done;
+static void *owner_block;
+
+static void owner_entry(void *parameter)
+{
+    owner_block = rt_malloc(BLOCK_SIZE);
+
+    /* keep alive until the block is freed */
+    if (parameter != RT_NULL)
+        rt_sem_take(&done, RT_WAITING_FOREVER);
+}
+
+/* start a thread which allocates a block, and waits if keep is set */
+static rt_thread_t owner_start(rt_bool_t keep)
+{
+    rt_thread_t thread;
+
+    thread = rt_thread_create("owner", owner_entry, keep ? &done : RT_NULL, STACK_SIZE, 5, 10);
+    TEST_ASSERT_NOT_NULL(thread);
+    /* it runs right now, as its priority is higher */
+    rt_thread_startup(thread);
+    TEST_ASSERT_NOT_NULL(owner_block);
+
+    return thread;
+}
+
+void setUp(void)
+{
+    owner_block = RT_NULL;
+    rt_sem_init(&done, "done", 0, RT_IPC_FLAG_FIFO);
+}
+
+void tearDown(void)
+{
+    rt_sem_detach(&done);
+    /* reap the closed threads */
+    rt_thread_idle_excute();
+}
+
+/* the block freed by another thread is uncharged from its owner */
+static void test_free_by_other(void)
+{
+    rt_thread_t self, thread;
+    rt_base_t used;
+
+    self = rt_thread_self();
+    thread = owner_start(RT_TRUE);
+    used = self->heap_used;
+    TEST_ASSERT_TRUE(thread->heap_used >= BLOCK_SIZE);
+
+    rt_free(owner_block);
+    TEST_ASSERT_EQUAL(0, thread->heap_used);
+    TEST_ASSERT_EQUAL(used, self->heap_used);
+
+    rt_sem_release(&done);
+}
+
+/* the block moved by another thread is charged to that thread */
+static void test_realloc_by_other(void)
+{
+    rt_thread_t self, thread;
+    rt_base_t used;
+    void *block;
+
+    self = rt_thread_self();
+    thread = owner_start(RT_TRUE);
+    used = self->heap_used;
+    block = rt_realloc(owner_block, 10 * BLOCK_SIZE);
+    TEST_ASSERT_NOT_NULL(block);
+    TEST_ASSERT_EQUAL(0, thread->heap_used);
+    TEST_ASSERT_TRUE(self->heap_used - used >= 10 * BLOCK_SIZE);
+
+    rt_free(block);
+    TEST_ASSERT_EQUAL(used, self->heap_used);
+
+    rt_sem_release(&done);
+}
+
+/* nothing is uncharged for the block of a deleted thread */
+static void test_free_after_owner_exit(void)
+{
+    rt_thread_t self;
+    rt_base_t used;
+
+    self = rt_thread_self();
+    used = self->heap_used;
+
+    owner_start(RT_FALSE);
+    rt_thread_idle_excute();
+
+    rt_free(owner_block);
+    TEST_ASSERT_EQUAL(used, self->heap_used);
+}
+
+static rt_size_t largest_free(void)
+{
+    struct rt_heap_info info;
+
+    rt_heap_info_get(&info);
+
+    return info.largest_free;
+}
+
+/*
+ * the free blocks of 40000, 50000 and 60000 bytes are in one size class,
+ * after the rest of heap is used up.
+ */
+static void test_largest_free(void)
+{
+    void **blocks = RT_NULL, **block;
+    void *a, *b, *c;
+    rt_size_t size;
+
+    a = rt_malloc(40000);
+    TEST_ASSERT_NOT_NULL(rt_malloc(64));
+    b = rt_malloc(60000);
+    TEST_ASSERT_NOT_NULL(rt_malloc(64));
+    c = rt_malloc(50000);
+    TEST_ASSERT_NOT_NULL(rt_malloc(64));
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NOT_NULL(c);
+
+    for (size = 65536; size >= 16; size /= 2)
+    {
+        while ((block = (void **)rt_malloc(size)) != RT_NULL)
+        {
+            *block = blocks;
+            blocks = block;
+        }
+    }
+
+    rt_free(a);
+    rt_free(b);
+    size = largest_free();
+    TEST_ASSERT_TRUE(size >= 60000 && size < 60000 + 4096);
+
+    /* the largest one is taken, then the other one is the only block */
+    b = rt_malloc(60000);
+    TEST_ASSERT_NOT_NULL(b);
+    size = largest_free();
+    TEST_ASSERT_TRUE(size >= 40000 && size < 40000 + 4096);
+
+    /* the largest one is taken, then the others are walked */
+    rt_free(b);
+    rt_free(c);
+    b = rt_malloc(60000);
+    TEST_ASSERT_NOT_NULL(b);
+    size = largest_free();
+    TEST_ASSERT_TRUE(size >= 50000 && size < 50000 + 4096);
+
+    rt_free(b);
+    while (blocks != RT_NULL)
+    {
+        block = blocks;
+        blocks = (void **)*block;
+        rt_free(block);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_free_by_other);
+    RUN_TEST(test_realloc_by_other);
+    RUN_TEST(test_free_after_owner_exit);
+    RUN_TEST(test_largest_free);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
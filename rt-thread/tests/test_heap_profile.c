@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the heap profiler (RT_USING_HEAP_PROFILE), built with small tables
+ * of 4 call sites and 8 blocks: the live bytes of each call site, the removal
+ * of sampled blocks from the probe chains, the estimate of sampled small
+ * blocks and the samples dropped when a table is full.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+static void *blocks[RT_HEAP_PROFILE_BLOCKS * 2];
+static struct rt_heap_profile_site sites[RT_HEAP_PROFILE_SITES];
+
+/* the call sites, of different sizes so that they are not folded */
+#define ALLOC_SITE(name, size)                                              \
+    static void __attribute__((noinline)) name(void **blocks, int count)    \
+    {                                                                       \
+        int index;                                                          \
+        for (index = 0; index < count; index++)                             \
+            blocks[index] = rt_malloc(size);                                \
+    }
+
+ALLOC_SITE(alloc_a, 24)
+ALLOC_SITE(alloc_b, 40)
+ALLOC_SITE(alloc_c, 56)
+ALLOC_SITE(alloc_d, 72)
+ALLOC_SITE(alloc_e, 88)
+
+static void __attribute__((noinline)) calloc_site(void **blocks, int count)
+{
+    int index;
+
+    for (index = 0; index < count; index++)
+        blocks[index] = rt_calloc(4, 10);
+}
+
+/* the blocks of 32, 64, ... bytes */
+static void __attribute__((noinline)) alloc_sized(void **blocks, int count)
+{
+    int index;
+
+    for (index = 0; index < count; index++)
+        blocks[index] = rt_malloc(32 * (index + 1));
+}
+
+typedef void (*site_t)(void **blocks, int count);
+static const site_t functions[] = {alloc_a, alloc_b, alloc_c, alloc_d, alloc_e, calloc_site, alloc_sized};
+
+/*
+ * the call site in function, RT_NULL if it is not recorded. A call site is
+ * in the function which starts nearest below it.
+ */
+static struct rt_heap_profile_site *site_of(site_t function)
+{
+    int count, index, other;
+    rt_ubase_t caller;
+
+    count = rt_heap_profile_top(sites, RT_HEAP_PROFILE_SITES);
+    for (index = 0; index < count; index++)
+    {
+        caller = (rt_ubase_t)sites[index].caller;
+        if (caller <= (rt_ubase_t)function)
+            continue;
+
+        for (other = 0; other < (int)(sizeof(functions) / sizeof(functions[0])); other++)
+        {
+            if ((rt_ubase_t)functions[other] > (rt_ubase_t)function &&
+                (rt_ubase_t)functions[other] < caller)
+                break;
+        }
+        if (other == (int)(sizeof(functions) / sizeof(functions[0])))
+            return &sites[index];
+    }
+
+    return RT_NULL;
+}
+
+static void free_blocks(void **blocks, int count)
+{
+    int index;
+
+    for (index = 0; index < count; index++)
+        rt_free(blocks[index]);
+}
+
+void setUp(void)
+{
+    /* every block is sampled for its own size */
+    rt_heap_profile_set(0);
+    rt_heap_profile_set(1);
+}
+
+void tearDown(void)
+{
+    rt_heap_profile_set(0);
+}
+
+/* the live bytes of each call site, in the descending order */
+static void test_sites(void)
+{
+    struct rt_heap_profile_site *site;
+
+    alloc_a(&blocks[0], 3);
+    alloc_b(&blocks[3], 2);
+    calloc_site(&blocks[5], 1);
+
+    TEST_ASSERT_EQUAL(3, rt_heap_profile_top(sites, RT_HEAP_PROFILE_SITES));
+    TEST_ASSERT_EQUAL(80, sites[0].live);
+    TEST_ASSERT_EQUAL(72, sites[1].live);
+    TEST_ASSERT_EQUAL(40, sites[2].live);
+
+    site = site_of(alloc_a);
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL(72, site->live);
+    TEST_ASSERT_EQUAL(3, site->count);
+    site = site_of(alloc_b);
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL(80, site->live);
+    TEST_ASSERT_EQUAL(2, site->count);
+    /* the block of rt_calloc is of its caller, not of rt_calloc */
+    site = site_of(calloc_site);
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL(40, site->live);
+
+    /* the bytes freed are subtracted, the total is kept */
+    rt_free(blocks[0]);
+    site = site_of(alloc_a);
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL(48, site->live);
+    TEST_ASSERT_EQUAL(2, site->count);
+    TEST_ASSERT_EQUAL(72, site->total);
+
+    free_blocks(&blocks[1], 5);
+    site = site_of(alloc_b);
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL(0, site->live);
+    TEST_ASSERT_EQUAL(0, site->count);
+    TEST_ASSERT_EQUAL(80, site->total);
+    TEST_ASSERT_EQUAL(0, rt_heap_profile_dropped());
+}
+
+/*
+ * the blocks left in the probe chains are still found when a block is
+ * removed, in any order of free
+ */
+static void test_block_remove(void)
+{
+    static const rt_uint8_t orders[][RT_HEAP_PROFILE_BLOCKS - 1] =
+    {
+        {0, 1, 2, 3, 4, 5, 6},
+        {6, 5, 4, 3, 2, 1, 0},
+        {1, 3, 5, 0, 2, 4, 6},
+        {3, 2, 4, 1, 5, 0, 6},
+    };
+    struct rt_heap_profile_site *site;
+    rt_size_t live;
+    int order, index, count;
+
+    for (order = 0; order < (int)(sizeof(orders) / sizeof(orders[0])); order++)
+    {
+        count = RT_HEAP_PROFILE_BLOCKS - 1;
+        alloc_sized(blocks, count);
+        for (index = 0, live = 0; index < count; index++)
+            live += 32 * (index + 1);
+
+        for (index = 0; index < count; index++)
+        {
+            rt_free(blocks[orders[order][index]]);
+            live -= 32 * (orders[order][index] + 1);
+
+            site = site_of(alloc_sized);
+            TEST_ASSERT_NOT_NULL(site);
+            TEST_ASSERT_EQUAL(live, site->live);
+            TEST_ASSERT_EQUAL(count - index - 1, site->count);
+        }
+    }
+    TEST_ASSERT_EQUAL(0, rt_heap_profile_dropped());
+}
+
+/* the small blocks stand for the bytes of the sample points they cross */
+static void test_estimate(void)
+{
+    struct rt_heap_profile_site *site;
+    int index;
+
+    rt_heap_profile_set(0);
+    rt_heap_profile_set(256);
+
+    for (index = 0; index < 4000; index++)
+    {
+        alloc_c(blocks, 1);
+        rt_free(blocks[0]);
+    }
+
+    site = site_of(alloc_c);
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL(0, site->live);
+    TEST_ASSERT_EQUAL(0, site->count);
+    TEST_ASSERT_TRUE(site->total > 4000 * 56 * 9 / 10);
+    TEST_ASSERT_TRUE(site->total < 4000 * 56 * 11 / 10);
+    TEST_ASSERT_EQUAL(0, rt_heap_profile_dropped());
+}
+
+/* the samples are dropped and counted when a table is full */
+static void test_dropped(void)
+{
+    struct rt_heap_profile_site *site;
+
+    /* the table of blocks */
+    alloc_a(blocks, RT_HEAP_PROFILE_BLOCKS + 3);
+    TEST_ASSERT_EQUAL(3, rt_heap_profile_dropped());
+    site = site_of(alloc_a);
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL(RT_HEAP_PROFILE_BLOCKS * 24, site->live);
+    free_blocks(blocks, RT_HEAP_PROFILE_BLOCKS + 3);
+    site = site_of(alloc_a);
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL(0, site->live);
+
+    /* the table of call sites */
+    rt_heap_profile_reset();
+    alloc_a(&blocks[0], 1);
+    alloc_b(&blocks[1], 1);
+    alloc_c(&blocks[2], 1);
+    alloc_d(&blocks[3], 1);
+    alloc_e(&blocks[4], 1);
+    TEST_ASSERT_EQUAL(1, rt_heap_profile_dropped());
+    TEST_ASSERT_EQUAL(RT_HEAP_PROFILE_SITES, rt_heap_profile_top(sites, RT_HEAP_PROFILE_SITES));
+    TEST_ASSERT_NOT_NULL(site_of(alloc_d));
+    TEST_ASSERT_NULL(site_of(alloc_e));
+    free_blocks(blocks, 5);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sites);
+    RUN_TEST(test_block_remove);
+    RUN_TEST(test_estimate);
+    RUN_TEST(test_dropped);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+static int calls[RT_HOOK_LIST_SIZE + 1];
+
+#define HOOK(n) static void hook##n(rt_thread_t thread) { calls[n]++; }
+HOOK(0) HOOK(1) HOOK(2) HOOK(3) HOOK(4)
+#undef HOOK
+
+static void (*const hooks[])(rt_thread_t thread) = {hook0, hook1, hook2, hook3, hook4};
+
+static void thread_entry(void *parameter)
+{
+}
+
+/* the inited hook is called once by each rt_thread_create */
+static void create_thread(void)
+{
+    rt_thread_t thread;
+
+    thread = rt_thread_create("hook", thread_entry, RT_NULL, 4096, 20, 10);
+    TEST_ASSERT_NOT_NULL(thread);
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_delete(thread));
+}
+
+void setUp(void)
+{
+    rt_memset(calls, 0, sizeof(calls));
+    rt_thread_inited_sethook(RT_NULL);
+}
+
+void tearDown(void)
+{
+    rt_thread_inited_sethook(RT_NULL);
+}
+
+static void test_hook_list(void)
+{
+    int index;
+
+    for (index = 0; index < RT_HOOK_LIST_SIZE; index++)
+        TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hooks[index]));
+    TEST_ASSERT_EQUAL(-RT_EFULL, rt_thread_inited_sethook(hooks[RT_HOOK_LIST_SIZE]));
+
+    create_thread();
+    for (index = 0; index < RT_HOOK_LIST_SIZE; index++)
+        TEST_ASSERT_EQUAL(1, calls[index]);
+    TEST_ASSERT_EQUAL(0, calls[RT_HOOK_LIST_SIZE]);
+}
+
+static void test_hook_duplicate(void)
+{
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hook0));
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hook0));
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hook1));
+
+    create_thread();
+    TEST_ASSERT_EQUAL(1, calls[0]);
+    TEST_ASSERT_EQUAL(1, calls[1]);
+
+    /* a single delete removes it */
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_delhook(hook0));
+    TEST_ASSERT_EQUAL(-RT_ENOSYS, rt_thread_inited_delhook(hook0));
+
+    create_thread();
+    TEST_ASSERT_EQUAL(1, calls[0]);
+    TEST_ASSERT_EQUAL(2, calls[1]);
+}
+
+static void test_hook_duplicate_full(void)
+{
+    int index;
+
+    for (index = 0; index < RT_HOOK_LIST_SIZE; index++)
+        TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hooks[index]));
+
+    /* a hook on a full list is not an error */
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hooks[RT_HOOK_LIST_SIZE - 1]));
+
+    /* the free slot is reused */
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_delhook(hooks[0]));
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hooks[RT_HOOK_LIST_SIZE]));
+
+    create_thread();
+    TEST_ASSERT_EQUAL(0, calls[0]);
+    for (index = 1; index <= RT_HOOK_LIST_SIZE; index++)
+        TEST_ASSERT_EQUAL(1, calls[index]);
+}
+
+static void test_hook_clear(void)
+{
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hook0));
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hook1));
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(RT_NULL));
+
+    create_thread();
+    TEST_ASSERT_EQUAL(0, calls[0]);
+    TEST_ASSERT_EQUAL(0, calls[1]);
+}
+
+/* a RT_NULL hook is not found, the empty slots keep the count of hooks */
+static void test_hook_delete_null(void)
+{
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hook0));
+    TEST_ASSERT_EQUAL(-RT_ENOSYS, rt_thread_inited_delhook(RT_NULL));
+    TEST_ASSERT_EQUAL(-RT_ENOSYS, rt_thread_inited_delhook(RT_NULL));
+
+    create_thread();
+    TEST_ASSERT_EQUAL(1, calls[0]);
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_delhook(hook0));
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_inited_sethook(hook1));
+    create_thread();
+    TEST_ASSERT_EQUAL(1, calls[0]);
+    TEST_ASSERT_EQUAL(1, calls[1]);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_hook_list);
+    RUN_TEST(test_hook_duplicate);
+    RUN_TEST(test_hook_duplicate_full);
+    RUN_TEST(test_hook_clear);
+    RUN_TEST(test_hook_delete_null);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define OBJECT_SIZE     40
+#define SLAB_OBJECTS    8
+
+static struct rt_kmem_cache cache;
+static int hook_calls;
+static rt_bool_t hook_header_ok;
+
+/* the hooks see the header of the pool of slab */
+static void mp_hook(struct rt_mempool *mp, void *block)
+{
+    hook_calls++;
+    if (rt_object_get_type(&(mp->parent)) != RT_Object_Class_MemPool ||
+        rt_object_is_systemobject(&(mp->parent)) ||
+        rt_strncmp(mp->parent.name, "test", RT_NAME_MAX) != 0 ||
+        !rt_list_isempty(&(mp->parent.list)))
+    {
+        hook_header_ok = RT_FALSE;
+    }
+}
+
+void setUp(void)
+{
+    rt_kmem_cache_init(&cache, "test", OBJECT_SIZE, SLAB_OBJECTS);
+}
+
+void tearDown(void)
+{
+    rt_kmem_cache_detach(&cache);
+}
+
+/* the slabs are not memory pool objects */
+static void test_slab_is_not_object(void)
+{
+    void *objects[SLAB_OBJECTS * 3];
+    int pools, index;
+
+    pools = rt_object_get_length(RT_Object_Class_MemPool);
+
+    for (index = 0; index < SLAB_OBJECTS * 3; index++)
+    {
+        objects[index] = rt_kmem_cache_alloc(&cache);
+        TEST_ASSERT_NOT_NULL(objects[index]);
+    }
+    TEST_ASSERT_EQUAL(3, cache.slab_count);
+    TEST_ASSERT_EQUAL(pools, rt_object_get_length(RT_Object_Class_MemPool));
+    TEST_ASSERT_NULL(rt_object_find("test", RT_Object_Class_MemPool));
+
+    for (index = 0; index < SLAB_OBJECTS * 3; index++)
+        rt_kmem_cache_free(&cache, objects[index]);
+    TEST_ASSERT_EQUAL(1, cache.slab_count);
+    TEST_ASSERT_EQUAL(pools, rt_object_get_length(RT_Object_Class_MemPool));
+}
+
+static void test_slab_objects(void)
+{
+    rt_uint8_t *objects[SLAB_OBJECTS + 1];
+    int index;
+
+    for (index = 0; index < SLAB_OBJECTS + 1; index++)
+    {
+        objects[index] = rt_kmem_cache_alloc(&cache);
+        TEST_ASSERT_NOT_NULL(objects[index]);
+        TEST_ASSERT_EQUAL(0, (rt_ubase_t)objects[index] % RT_ALIGN_SIZE);
+        rt_memset(objects[index], 0x5a, OBJECT_SIZE);
+    }
+    TEST_ASSERT_EQUAL(2, cache.miss_count);
+    TEST_ASSERT_EQUAL(SLAB_OBJECTS - 1, cache.hit_count);
+
+    for (index = 0; index < SLAB_OBJECTS + 1; index++)
+        rt_kmem_cache_free(&cache, objects[index]);
+    TEST_ASSERT_EQUAL(0, cache.used_count);
+}
+
+/* the object header of the pool of slab is initialized for the hooks */
+static void test_slab_hooks(void)
+{
+    void *objects[SLAB_OBJECTS * 2];
+    int index;
+
+    hook_calls = 0;
+    hook_header_ok = RT_TRUE;
+    rt_mp_alloc_sethook(mp_hook);
+    rt_mp_free_sethook(mp_hook);
+
+    /* the heap garbage is where the headers of the new slabs are */
+    rt_free(rt_memset(rt_malloc(4096), 0xa5, 4096));
+    for (index = 0; index < SLAB_OBJECTS * 2; index++)
+        objects[index] = rt_kmem_cache_alloc(&cache);
+    for (index = 0; index < SLAB_OBJECTS * 2; index++)
+        rt_kmem_cache_free(&cache, objects[index]);
+
+    rt_mp_alloc_delhook(mp_hook);
+    rt_mp_free_delhook(mp_hook);
+    TEST_ASSERT_EQUAL(SLAB_OBJECTS * 4, hook_calls);
+    TEST_ASSERT_TRUE(hook_header_ok);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_slab_is_not_object);
+    RUN_TEST(test_slab_objects);
+    RUN_TEST(test_slab_hooks);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
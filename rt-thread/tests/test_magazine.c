@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the heap magazines (RT_USING_HEAP_MAGAZINE) on the small memory,
+ * slab and memheap allocators.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define CHUNKS          300
+
+static void *chunks[CHUNKS];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#ifndef RT_USING_MEMHEAP_AS_HEAP
+static rt_size_t hook_size;
+
+static void malloc_hook(void *ptr, rt_size_t size)
+{
+    hook_size = size;
+}
+
+/* the hook sees the requested size, not the size class */
+static void test_hook_size(void)
+{
+    void *block;
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_malloc_sethook(malloc_hook));
+
+    /* a miss, then a hit */
+    block = rt_malloc(40);
+    TEST_ASSERT_NOT_NULL(block);
+    TEST_ASSERT_EQUAL(40, hook_size);
+    rt_free(block);
+
+    block = rt_malloc(40);
+    TEST_ASSERT_NOT_NULL(block);
+    TEST_ASSERT_EQUAL(40, hook_size);
+    rt_free(block);
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_malloc_delhook(malloc_hook));
+}
+#endif
+
+/*
+ * the chunks bigger than a size class are not cached for it, as they may not
+ * have the alignment of an allocation of the class size.
+ */
+static void test_align(void)
+{
+    int index;
+
+    for (index = 0; index < CHUNKS; index++)
+    {
+        chunks[index] = rt_malloc(RT_HEAP_MAGAZINE_MAX + 16);
+        TEST_ASSERT_NOT_NULL(chunks[index]);
+    }
+    for (index = 0; index < CHUNKS; index++)
+        rt_free(chunks[index]);
+
+    for (index = 0; index < CHUNKS; index++)
+    {
+        chunks[index] = rt_malloc_align(RT_HEAP_MAGAZINE_MAX, RT_HEAP_MAGAZINE_MAX);
+        TEST_ASSERT_NOT_NULL(chunks[index]);
+        TEST_ASSERT_EQUAL(0, (rt_ubase_t)chunks[index] & (RT_HEAP_MAGAZINE_MAX - 1));
+    }
+    for (index = 0; index < CHUNKS; index++)
+        rt_free_align(chunks[index]);
+}
+
+/*
+ * the cached chunks are returned to heap when it runs out: the heap is used
+ * up except a hole, which is then taken by the cached chunks.
+ */
+#define HOLE_SIZE       65536
+#ifdef RT_USING_SLAB
+/*
+ * the chunks take two zones, the one freed by draining is taken by the zone
+ * of another size class.
+ */
+#define DRAIN_SIZE      512
+#else
+/* more than the free memory around the cached chunks in hole */
+#define DRAIN_SIZE      (HOLE_SIZE - 256)
+#endif
+
+static void test_drain(void)
+{
+    void **blocks = RT_NULL, **block;
+    void *hole;
+    rt_size_t size;
+    int index;
+
+    hole = rt_malloc(HOLE_SIZE);
+    TEST_ASSERT_NOT_NULL(hole);
+
+    for (size = 65536; size >= 16; size /= 2)
+    {
+        while ((block = (void **)rt_malloc(size)) != RT_NULL)
+        {
+            *block = blocks;
+            blocks = block;
+        }
+    }
+
+    /* the magazine of 128 bytes is filled from the hole */
+    rt_free(hole);
+    for (index = 0; index < CHUNKS; index++)
+    {
+        chunks[index] = rt_malloc(128);
+        TEST_ASSERT_NOT_NULL(chunks[index]);
+    }
+    for (index = 0; index < CHUNKS; index++)
+        rt_free(chunks[index]);
+
+    block = (void **)rt_malloc(DRAIN_SIZE);
+    TEST_ASSERT_NOT_NULL(block);
+    rt_free(block);
+
+    while (blocks != RT_NULL)
+    {
+        block = blocks;
+        blocks = (void **)*block;
+        rt_free(block);
+    }
+}
+
+static struct rt_thread free_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t free_stack[8192];
+static int asserted;
+static rt_bool_t freed_twice;
+
+/* the thread freeing twice stops at the assertion */
+static void assert_hook(const char *ex, const char *func, rt_size_t line)
+{
+    asserted++;
+    rt_thread_detach(rt_thread_self());
+    rt_schedule();
+}
+
+static void free_entry(void *parameter)
+{
+    rt_free(parameter);
+    rt_free(parameter);
+    freed_twice = RT_TRUE;
+}
+
+/* a chunk freed twice asserts, instead of being cached twice */
+static void test_double_free(void)
+{
+    void *block;
+    int index;
+
+    block = rt_malloc(64);
+    TEST_ASSERT_NOT_NULL(block);
+
+    rt_assert_set_hook(assert_hook);
+    rt_thread_init(&free_thread, "free", free_entry, block, free_stack, sizeof(free_stack), 5, 10);
+    /* it is done once started, as its priority is higher */
+    rt_thread_startup(&free_thread);
+    rt_assert_set_hook(RT_NULL);
+
+    TEST_ASSERT_EQUAL(1, asserted);
+    TEST_ASSERT_FALSE(freed_twice);
+
+    /* the chunk is cached once */
+    chunks[0] = rt_malloc(64);
+    chunks[1] = rt_malloc(64);
+    TEST_ASSERT_EQUAL_PTR(block, chunks[0]);
+    TEST_ASSERT_TRUE(chunks[1] != block);
+    rt_free(chunks[0]);
+    rt_free(chunks[1]);
+
+    /* the heap runs out, so the magazines are drained */
+    for (index = 0; index < CHUNKS; index++)
+        chunks[index] = rt_malloc(HOLE_SIZE);
+    for (index = 0; index < CHUNKS; index++)
+        rt_free(chunks[index]);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+#ifndef RT_USING_MEMHEAP_AS_HEAP
+    RUN_TEST(test_hook_size);
+#endif
+    RUN_TEST(test_align);
+    RUN_TEST(test_drain);
+    RUN_TEST(test_double_free);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
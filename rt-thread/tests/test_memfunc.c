@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Random test of rt_memcpy/rt_memset/rt_memmove/rt_memcmp against byte loops,
+ * with random sizes, offsets and overlaps. The whole buffers are compared, so
+ * a byte written outside of the range is found too.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define BUF_SIZE        640
+#define ITERATIONS      50000
+
+static rt_uint8_t buf_a[BUF_SIZE], buf_b[BUF_SIZE];
+static rt_uint8_t ref_a[BUF_SIZE], ref_b[BUF_SIZE];
+static rt_uint32_t seed;
+
+static rt_uint32_t rnd(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/* mostly small sizes, which take the head and tail paths */
+static rt_size_t rnd_size(void)
+{
+    return rnd() % 3 ? rnd() % 80 : rnd() % 512;
+}
+
+static void fill(void)
+{
+    int i;
+
+    for (i = 0; i < BUF_SIZE; i++)
+    {
+        buf_a[i] = ref_a[i] = (rt_uint8_t)rnd();
+        buf_b[i] = ref_b[i] = (rt_uint8_t)rnd();
+    }
+}
+
+static void check(void)
+{
+    int i;
+
+    for (i = 0; i < BUF_SIZE; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX8(ref_a[i], buf_a[i]);
+        TEST_ASSERT_EQUAL_HEX8(ref_b[i], buf_b[i]);
+    }
+}
+
+void setUp(void)
+{
+    seed = 0x2f6b6d1d;
+}
+
+void tearDown(void)
+{
+}
+
+static void test_memcpy(void)
+{
+    int it;
+    rt_size_t i, n, oa, ob;
+
+    for (it = 0; it < ITERATIONS; it++)
+    {
+        n = rnd_size();
+        oa = rnd() % 32;
+        ob = rnd() % 32;
+        fill();
+
+        TEST_ASSERT_EQUAL_PTR(buf_a + oa, rt_memcpy(buf_a + oa, buf_b + ob, n));
+        for (i = 0; i < n; i++)
+            ref_a[oa + i] = ref_b[ob + i];
+        check();
+    }
+}
+
+static void test_memset(void)
+{
+    int it, c;
+    rt_size_t i, n, oa;
+
+    for (it = 0; it < ITERATIONS; it++)
+    {
+        n = rnd_size();
+        oa = rnd() % 32;
+        c = (int)(rnd() % 512) - 256;
+        fill();
+
+        TEST_ASSERT_EQUAL_PTR(buf_a + oa, rt_memset(buf_a + oa, c, n));
+        for (i = 0; i < n; i++)
+            ref_a[oa + i] = (rt_uint8_t)c;
+        check();
+    }
+}
+
+static void test_memmove(void)
+{
+    int it;
+    rt_size_t i, n, src, dst;
+
+    for (it = 0; it < ITERATIONS; it++)
+    {
+        n = rnd_size();
+        src = 64 + rnd() % 32;
+        /* overlap in both directions, or no overlap */
+        dst = src + rnd() % 64 - 32;
+        fill();
+
+        TEST_ASSERT_EQUAL_PTR(buf_a + dst, rt_memmove(buf_a + dst, buf_a + src, n));
+        if (dst < src)
+        {
+            for (i = 0; i < n; i++)
+                ref_a[dst + i] = ref_a[src + i];
+        }
+        else
+        {
+            for (i = n; i > 0; i--)
+                ref_a[dst + i - 1] = ref_a[src + i - 1];
+        }
+        check();
+    }
+}
+
+static void test_memcmp(void)
+{
+    int it, expect;
+    rt_size_t i, n, oa, ob;
+
+    for (it = 0; it < ITERATIONS; it++)
+    {
+        n = rnd_size();
+        oa = rnd() % 32;
+        ob = rnd() % 32;
+        fill();
+
+        for (i = 0; i < n; i++)
+            buf_b[ob + i] = ref_b[ob + i] = buf_a[oa + i];
+        /* one different byte, anywhere in the range */
+        if (n && rnd() % 4)
+        {
+            i = rnd() % n;
+            buf_b[ob + i] ^= (rt_uint8_t)(rnd() % 255 + 1);
+            ref_b[ob + i] = buf_b[ob + i];
+        }
+
+        expect = 0;
+        for (i = 0; i < n; i++)
+        {
+            if (buf_a[oa + i] != buf_b[ob + i])
+            {
+                expect = buf_a[oa + i] - buf_b[ob + i];
+                break;
+            }
+        }
+
+        TEST_ASSERT_EQUAL_INT(expect, rt_memcmp(buf_a + oa, buf_b + ob, n));
+        TEST_ASSERT_EQUAL_INT(-expect, rt_memcmp(buf_b + ob, buf_a + oa, n));
+        check();
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_memcpy);
+    RUN_TEST(test_memset);
+    RUN_TEST(test_memmove);
+    RUN_TEST(test_memcmp);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
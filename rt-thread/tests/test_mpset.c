@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the memory pool set (RT_USING_MPSET): the size class taken by an
+ * allocation, the fallback to a larger class, the wait on an exhausted
+ * class and the watermarks of used blocks shown by list_mempool.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define CLASSES         3
+#define BLOCKS          4
+#define POOL_SIZE(size) (BLOCKS * ((size) + sizeof(rt_uint8_t *)))
+
+static const rt_size_t sizes[CLASSES] = {32, 64, 128};
+static struct rt_mempool pools[CLASSES];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t pool_buffer[CLASSES][POOL_SIZE(128)];
+static struct rt_mpset set;
+static void *blocks[CLASSES * BLOCKS];
+
+/* the class of a block, -1 if it is not in a pool of the set */
+static int class_of(void *block)
+{
+    int index;
+
+    for (index = 0; index < CLASSES; index++)
+    {
+        if ((rt_uint8_t *)block >= pool_buffer[index] &&
+            (rt_uint8_t *)block < pool_buffer[index] + POOL_SIZE(sizes[index]))
+            return index;
+    }
+
+    return -1;
+}
+
+void setUp(void)
+{
+    int index;
+
+    rt_mpset_init(&set);
+    /* the pools are added out of order */
+    for (index = CLASSES - 1; index >= 0; index--)
+    {
+        rt_mp_init(&pools[index], "mpset", pool_buffer[index], POOL_SIZE(sizes[index]), sizes[index]);
+        TEST_ASSERT_EQUAL(RT_EOK, rt_mpset_add(&set, &pools[index]));
+    }
+}
+
+void tearDown(void)
+{
+    int index;
+
+    for (index = 0; index < CLASSES; index++)
+        rt_mp_detach(&pools[index]);
+}
+
+/* the pools are sorted by block size, which is a distinct power of two */
+static void test_add(void)
+{
+    static struct rt_mempool pool;
+    static rt_uint8_t buffer[POOL_SIZE(48)];
+    int index;
+
+    TEST_ASSERT_EQUAL(CLASSES, set.count);
+    for (index = 0; index < CLASSES; index++)
+        TEST_ASSERT_EQUAL_PTR(&pools[index], set.mp[index]);
+
+    rt_mp_init(&pool, "mpset", buffer, POOL_SIZE(48), 48);
+    TEST_ASSERT_EQUAL(-RT_EINVAL, rt_mpset_add(&set, &pool));
+    rt_mp_detach(&pool);
+
+    rt_mp_init(&pool, "mpset", buffer, POOL_SIZE(32), 32);
+    TEST_ASSERT_EQUAL(-RT_EINVAL, rt_mpset_add(&set, &pool));
+    rt_mp_detach(&pool);
+    TEST_ASSERT_EQUAL(CLASSES, set.count);
+}
+
+/* an allocation takes the smallest class which fits it */
+static void test_class(void)
+{
+    static const rt_size_t requests[] = {1, 32, 33, 64, 65, 128};
+    static const int classes[] = {0, 0, 1, 1, 2, 2};
+    void *block;
+    int index;
+
+    for (index = 0; index < (int)(sizeof(requests) / sizeof(requests[0])); index++)
+    {
+        block = rt_mpset_alloc(&set, requests[index], RT_WAITING_NO);
+        TEST_ASSERT_NOT_NULL(block);
+        TEST_ASSERT_EQUAL(classes[index], class_of(block));
+        rt_mpset_free(block);
+    }
+
+    TEST_ASSERT_NULL(rt_mpset_alloc(&set, 129, RT_WAITING_FOREVER));
+    TEST_ASSERT_EQUAL(-RT_ENOMEM, rt_get_errno());
+}
+
+/* an exhausted class borrows from the larger classes, not the smaller ones */
+static void test_fallback(void)
+{
+    int index;
+
+    for (index = 0; index < CLASSES * BLOCKS; index++)
+    {
+        blocks[index] = rt_mpset_alloc(&set, 16, RT_WAITING_NO);
+        TEST_ASSERT_NOT_NULL(blocks[index]);
+        TEST_ASSERT_EQUAL(index / BLOCKS, class_of(blocks[index]));
+    }
+    TEST_ASSERT_NULL(rt_mpset_alloc(&set, 16, RT_WAITING_NO));
+
+    /* a freed block of the fitting class is taken again first */
+    rt_mpset_free(blocks[BLOCKS * 2]);
+    rt_mpset_free(blocks[0]);
+    blocks[0] = rt_mpset_alloc(&set, 16, RT_WAITING_NO);
+    TEST_ASSERT_EQUAL(0, class_of(blocks[0]));
+    blocks[BLOCKS * 2] = rt_mpset_alloc(&set, 16, RT_WAITING_NO);
+    TEST_ASSERT_EQUAL(2, class_of(blocks[BLOCKS * 2]));
+
+    /* the middle class does not borrow from the smallest one */
+    rt_mpset_free(blocks[1]);
+    TEST_ASSERT_NULL(rt_mpset_alloc(&set, 64, RT_WAITING_NO));
+
+    for (index = 0; index < CLASSES * BLOCKS; index++)
+    {
+        if (index != 1)
+            rt_mpset_free(blocks[index]);
+    }
+}
+
+static struct rt_thread free_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t free_stack[8192];
+
+static void free_entry(void *parameter)
+{
+    rt_thread_mdelay(5);
+    rt_mpset_free(parameter);
+}
+
+/* the wait is on the fitting class, once all larger classes are exhausted */
+static void test_wait(void)
+{
+    rt_tick_t start;
+    void *block;
+    int index;
+
+    for (index = 0; index < CLASSES * BLOCKS; index++)
+        blocks[index] = rt_mpset_alloc(&set, 32, RT_WAITING_NO);
+
+    start = rt_tick_get();
+    TEST_ASSERT_NULL(rt_mpset_alloc(&set, 32, 10));
+    TEST_ASSERT_TRUE(rt_tick_get() - start >= 10);
+
+    /* the thread of lower priority frees a block of the class later */
+    rt_thread_init(&free_thread, "free", free_entry, blocks[2], free_stack, sizeof(free_stack), 20, 10);
+    rt_thread_startup(&free_thread);
+    start = rt_tick_get();
+    block = rt_mpset_alloc(&set, 32, RT_WAITING_FOREVER);
+    TEST_ASSERT_EQUAL_PTR(blocks[2], block);
+    TEST_ASSERT_TRUE(rt_tick_get() - start >= 5);
+
+    for (index = 0; index < CLASSES * BLOCKS; index++)
+        rt_mpset_free(blocks[index]);
+}
+
+/* each class keeps the watermark of its used blocks, the borrowed ones included */
+static void test_watermark(void)
+{
+    int index;
+
+    for (index = 0; index < BLOCKS + 2; index++)
+        blocks[index] = rt_mpset_alloc(&set, 32, RT_WAITING_NO);
+    blocks[index] = rt_mpset_alloc(&set, 128, RT_WAITING_NO);
+    for (index = 0; index < BLOCKS + 3; index++)
+        rt_mpset_free(blocks[index]);
+
+    TEST_ASSERT_EQUAL(BLOCKS, pools[0].block_used_max);
+    TEST_ASSERT_EQUAL(2, pools[1].block_used_max);
+    TEST_ASSERT_EQUAL(1, pools[2].block_used_max);
+    for (index = 0; index < CLASSES; index++)
+        TEST_ASSERT_EQUAL(BLOCKS, pools[index].block_free_count);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_add);
+    RUN_TEST(test_class);
+    RUN_TEST(test_fallback);
+    RUN_TEST(test_wait);
+    RUN_TEST(test_watermark);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
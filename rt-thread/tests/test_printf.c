@@ -0,0 +1,558 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of rt_vsnprintf against a reference formatter, which is written from
+ * the rules of the kernel one: the numbers near the powers of 10 and 2 in
+ * every conversion, and random formats with flags, width, precision,
+ * qualifiers and truncating buffer sizes. The return value and the whole
+ * buffer shall be the same. It is built with the division by 10 of the cores
+ * without divider (__ARM_ARCH_6M__) and with RT_PRINTF_LONGLONG too.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define BUF_SIZE        160
+#define RANDOM_FORMATS  300000
+
+/* the number is a long as in the kernel, or a long long */
+#ifdef RT_PRINTF_LONGLONG
+typedef unsigned long long ref_num_t;
+typedef long long ref_snum_t;
+#else
+typedef unsigned long ref_num_t;
+typedef long ref_snum_t;
+#endif
+
+static char out[BUF_SIZE], ref[BUF_SIZE];
+static rt_uint32_t seed = 7;
+
+static rt_uint32_t rnd(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/* the reference, the kernel rules are noted where they differ from C */
+struct ref_output
+{
+    char *buf;
+    rt_size_t size;
+    rt_size_t length;
+};
+
+/* the index of c in set, -1 if it is not there */
+static int ref_index(const char *set, char c)
+{
+    int index;
+
+    for (index = 0; set[index] != '\0'; index++)
+    {
+        if (set[index] == c)
+            return index;
+    }
+
+    return -1;
+}
+
+static void ref_put(struct ref_output *output, char c, int count)
+{
+    while (count-- > 0)
+    {
+        if (output->length < output->size)
+            output->buf[output->length] = c;
+        output->length++;
+    }
+}
+
+/* the digits in reverse order, 10 by subtraction, as no division is at hand */
+static int ref_digits(char *digits, ref_num_t num, int base, int upper)
+{
+    const char *hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    ref_num_t powers[20];
+    int count = 0, index, digit;
+
+    if (base != 10)
+    {
+        do
+        {
+            digits[count++] = hex[num & (base - 1)];
+            num >>= (base == 16) ? 4 : 3;
+        } while (num != 0);
+
+        return count;
+    }
+
+    /* the powers of 10 up to num */
+    powers[0] = 1;
+    for (count = 1; powers[count - 1] <= (ref_num_t)-1 / 10 && powers[count - 1] * 10 <= num; count++)
+        powers[count] = powers[count - 1] * 10;
+
+    for (index = count; index-- > 0;)
+    {
+        for (digit = 0; num >= powers[index]; digit++)
+            num -= powers[index];
+        digits[index] = '0' + digit;
+    }
+
+    return count;
+}
+
+static void ref_number(struct ref_output *output, ref_num_t num, int base, int is_signed,
+                       int flags, int width, int precision, int upper)
+{
+    char digits[32];
+    int count, digits_width, sign = 0, pad;
+
+    if (is_signed && (ref_snum_t)num < 0)
+    {
+        sign = '-';
+        num = 0 - num;
+    }
+    else if (is_signed && (flags & 2))
+    {
+        sign = '+';
+    }
+    else if (is_signed && (flags & 4))
+    {
+        sign = ' ';
+    }
+
+    count = ref_digits(digits, num, base, upper);
+    digits_width = precision > count ? precision : count;
+    pad = width - digits_width - (sign != 0);
+
+    /* '0' is kept with a precision, '-' wins over it, '#' has no prefix */
+    if (!(flags & (1 | 16)))
+        ref_put(output, ' ', pad);
+    if (sign)
+        ref_put(output, sign, 1);
+    if ((flags & 16) && !(flags & 1))
+        ref_put(output, '0', pad);
+    ref_put(output, '0', digits_width - count);
+    /* a precision of 0 drops the digits, not only the ones of 0 */
+    if (precision != 0)
+    {
+        while (count-- > 0)
+            ref_put(output, digits[count], 1);
+    }
+    if (flags & 1)
+        ref_put(output, ' ', pad);
+}
+
+static rt_int32_t ref_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list args)
+{
+    struct ref_output output = {buf, size, 0};
+    int flags, width, precision, qualifier, length, index;
+    const char *s;
+    ref_num_t num;
+    char c;
+
+    for (; *fmt; fmt++)
+    {
+        if (*fmt != '%')
+        {
+            ref_put(&output, *fmt, 1);
+            continue;
+        }
+
+        /* '-' 1, '+' 2, ' ' 4, '#' 8, '0' 16 */
+        flags = 0;
+        for (fmt++; ref_index("-+ #0", *fmt) >= 0; fmt++)
+            flags |= 1 << ref_index("-+ #0", *fmt);
+
+        width = -1;
+        if (*fmt == '*')
+        {
+            fmt++;
+            width = va_arg(args, int);
+            if (width < 0)
+            {
+                width = -width;
+                flags |= 1;
+            }
+        }
+        else if (*fmt >= '0' && *fmt <= '9')
+        {
+            for (width = 0; *fmt >= '0' && *fmt <= '9'; fmt++)
+                width = width * 10 + *fmt - '0';
+        }
+
+        precision = -1;
+        if (*fmt == '.')
+        {
+            fmt++;
+            precision = 0;
+            if (*fmt == '*')
+            {
+                fmt++;
+                precision = va_arg(args, int);
+            }
+            else
+            {
+                for (; *fmt >= '0' && *fmt <= '9'; fmt++)
+                    precision = precision * 10 + *fmt - '0';
+            }
+            if (precision < 0)
+                precision = 0;
+        }
+
+        qualifier = 0;
+        if (*fmt == 'h' || *fmt == 'l')
+            qualifier = *fmt++;
+#ifdef RT_PRINTF_LONGLONG
+        else if (*fmt == 'L')
+            qualifier = *fmt++;
+        if (qualifier == 'l' && *fmt == 'l')
+        {
+            qualifier = 'L';
+            fmt++;
+        }
+#endif
+
+        switch (*fmt)
+        {
+        case 'c':
+            /* the width pads with spaces only */
+            c = (char)va_arg(args, int);
+            if (!(flags & 1))
+                ref_put(&output, ' ', width - 1);
+            ref_put(&output, c, 1);
+            if (flags & 1)
+                ref_put(&output, ' ', width - 1);
+            break;
+
+        case 's':
+            s = va_arg(args, const char *);
+            if (s == RT_NULL)
+                s = "(NULL)";
+            /* the width cuts the string too */
+            length = rt_strlen(s);
+            if (width >= 0 && length > width)
+                length = width;
+            if (precision > 0 && length > precision)
+                length = precision;
+            if (!(flags & 1))
+                ref_put(&output, ' ', width - length);
+            for (index = 0; index < length; index++)
+                ref_put(&output, s[index], 1);
+            if (flags & 1)
+                ref_put(&output, ' ', width - length);
+            break;
+
+        case 'p':
+            /* a pointer is a long, zero padded to its size by default */
+            if (width == -1)
+            {
+                width = sizeof(void *) * 2;
+                flags |= 16;
+            }
+#ifdef RT_PRINTF_LONGLONG
+            num = (long long)(long)va_arg(args, void *);
+#else
+            num = (long)va_arg(args, void *);
+#endif
+            ref_number(&output, num, 16, 0, flags, width, precision, 0);
+            break;
+
+        case '%':
+            /* the flags and width are dropped */
+            ref_put(&output, '%', 1);
+            break;
+
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+#ifdef RT_PRINTF_LONGLONG
+            if (qualifier == 'L')
+                num = va_arg(args, long long);
+            else
+#endif
+            if (qualifier == 'h')
+                num = (*fmt == 'd' || *fmt == 'i') ? (ref_num_t)(rt_int16_t)va_arg(args, int)
+                                                   : (rt_uint16_t)va_arg(args, int);
+            else
+                num = (*fmt == 'd' || *fmt == 'i') ? (ref_num_t)(rt_int32_t)va_arg(args, rt_uint32_t)
+                                                   : va_arg(args, rt_uint32_t);
+
+            ref_number(&output, num, *fmt == 'o' ? 8 : (*fmt == 'x' || *fmt == 'X') ? 16 : 10,
+                       *fmt == 'd' || *fmt == 'i', flags, width, precision, *fmt == 'X');
+            break;
+
+        default:
+            /* an unknown conversion is printed as is, without its flags */
+            ref_put(&output, '%', 1);
+            if (*fmt == '\0')
+                fmt--;
+            else
+                ref_put(&output, *fmt, 1);
+            break;
+        }
+    }
+
+    if (size > 0)
+        buf[output.length < size ? output.length : size - 1] = '\0';
+
+    return (rt_int32_t)output.length;
+}
+
+/* format by both, the bytes past the output shall be the same too */
+static void check_format(rt_size_t size, const char *fmt, ...)
+{
+    va_list args;
+    rt_int32_t length, ref_length;
+
+    rt_memset(out, 'Z', sizeof(out));
+    rt_memset(ref, 'Z', sizeof(ref));
+
+    va_start(args, fmt);
+    length = rt_vsnprintf(out, size, fmt, args);
+    va_end(args);
+    va_start(args, fmt);
+    ref_length = ref_vsnprintf(ref, size, fmt, args);
+    va_end(args);
+
+    if (length != ref_length || rt_memcmp(out, ref, sizeof(out)) != 0)
+    {
+        rt_kprintf("format \"%s\" size %d: \"%.*s\" (%d), reference \"%.*s\" (%d)\n",
+                   fmt, (int)size, BUF_SIZE, out, length, BUF_SIZE, ref, ref_length);
+        TEST_FAIL();
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* the known outputs, the reference is checked with them too */
+static void test_known(void)
+{
+    char buf[64];
+    int index;
+    static const char *const formats[] = {"%o", "%5o", "%lo", "%d", "%u", "%x", "%5.3d", "%-6d|", "%+05d", "%.0d|"};
+    static const rt_uint32_t values[] = {8, 511, 0xffffffff, 0x80000000, 4294967295U, 0xdeadbeef, 7, 42, 42, 5};
+    static const char *const expected[] = {"10", "  777", "37777777777", "-2147483648", "4294967295",
+                                           "deadbeef", "  007", "42    |", "+0042", "|"};
+
+    for (index = 0; index < (int)(sizeof(formats) / sizeof(formats[0])); index++)
+    {
+        rt_snprintf(buf, sizeof(buf), formats[index], values[index]);
+        TEST_ASSERT_EQUAL_STRING(expected[index], buf);
+        check_format(BUF_SIZE, formats[index], values[index]);
+    }
+}
+
+/* the numbers around the powers of 10 and 2, in the plain and the generic paths */
+static void test_digits(void)
+{
+    static const char *const formats[] = {"%u", "%d", "%x", "%1u", "%1d", "%o", "%X", "%+.12i"};
+    rt_uint32_t power, value;
+    int index, delta, shift;
+
+    for (value = 0; value < 100000; value++)
+    {
+        for (index = 0; index < (int)(sizeof(formats) / sizeof(formats[0])); index++)
+            check_format(BUF_SIZE, formats[index], value);
+    }
+
+    for (power = 1; power != 0; power = (power < 1000000000U) ? power * 10 : 0)
+    {
+        for (delta = -1000; delta <= 1000; delta++)
+        {
+            for (index = 0; index < (int)(sizeof(formats) / sizeof(formats[0])); index++)
+            {
+                check_format(BUF_SIZE, formats[index], power + delta);
+                check_format(BUF_SIZE, formats[index], 0U - power + delta);
+            }
+        }
+    }
+
+    for (shift = 0; shift < 32; shift++)
+    {
+        for (delta = -100; delta <= 100; delta++)
+        {
+            for (index = 0; index < (int)(sizeof(formats) / sizeof(formats[0])); index++)
+                check_format(BUF_SIZE, formats[index], (1U << shift) + delta);
+        }
+    }
+
+#ifdef RT_PRINTF_LONGLONG
+    {
+        unsigned long long power_ll, value_ll;
+
+        for (power_ll = 1; power_ll <= 10000000000000000000ULL; power_ll *= 10)
+        {
+            for (delta = -1000; delta <= 1000; delta++)
+            {
+                value_ll = power_ll + delta;
+                check_format(BUF_SIZE, "%llu", value_ll);
+                check_format(BUF_SIZE, "%lld", value_ll);
+                check_format(BUF_SIZE, "%llx", value_ll);
+                check_format(BUF_SIZE, "%llo", value_ll);
+                check_format(BUF_SIZE, "%llu", 0ULL - power_ll + delta);
+                check_format(BUF_SIZE, "%lld", 0ULL - power_ll + delta);
+            }
+            if (power_ll == 10000000000000000000ULL)
+                break;
+        }
+        for (shift = 0; shift < 64; shift++)
+        {
+            for (delta = -100; delta <= 100; delta++)
+            {
+                check_format(BUF_SIZE, "%llu", (1ULL << shift) + delta);
+                check_format(BUF_SIZE, "%20lld", (1ULL << shift) + delta);
+            }
+        }
+    }
+#endif
+}
+
+/* append a decimal number to the format */
+static char *put_decimal(char *fmt, int value)
+{
+    if (value >= 10)
+        *fmt++ = '0' + value / 10;
+    *fmt++ = '0' + value % 10;
+
+    return fmt;
+}
+
+static void test_random(void)
+{
+    static const char conversions[] = "diuxXocsp%k";
+    char fmt[32], *f, conversion, qualifier;
+    int count, index, width, precision, star_width, star_precision;
+    rt_size_t size;
+    unsigned long long value;
+    const char *s;
+
+    for (count = 0; count < RANDOM_FORMATS; count++)
+    {
+        f = fmt;
+        width = precision = -1;
+        star_width = star_precision = 0;
+        qualifier = 0;
+
+        *f++ = '[';
+        *f++ = '%';
+        if (rnd() % 2)
+        {
+            for (index = 0; index < 3; index++)
+            {
+                if (rnd() % 3 == 0)
+                    *f++ = "-+ #0"[rnd() % 5];
+            }
+        }
+        if (rnd() % 3 == 0)
+        {
+            if (rnd() % 4)
+            {
+                width = rnd() % 25;
+                f = put_decimal(f, width);
+            }
+            else
+            {
+                *f++ = '*';
+                star_width = 1;
+                width = (int)(rnd() % 40) - 20;
+            }
+        }
+        if (rnd() % 4 == 0)
+        {
+            *f++ = '.';
+            if (rnd() % 4)
+            {
+                precision = rnd() % 12;
+                f = put_decimal(f, precision);
+            }
+            else
+            {
+                *f++ = '*';
+                star_precision = 1;
+                precision = (int)(rnd() % 14) - 2;
+            }
+        }
+        conversion = conversions[rnd() % (sizeof(conversions) - 1)];
+        if (ref_index("diuxXo", conversion) >= 0)
+        {
+            index = rnd() % 6;
+            if (index == 0)
+                *f++ = qualifier = 'h';
+            else if (index == 1)
+                *f++ = qualifier = 'l';
+#ifdef RT_PRINTF_LONGLONG
+            else if (index == 2)
+            {
+                *f++ = 'l';
+                *f++ = 'l';
+                qualifier = 'L';
+            }
+#endif
+        }
+        *f++ = conversion;
+        *f++ = ']';
+        *f = '\0';
+
+        /* small, 16 bits, 32 bits, negative, all ones and wide values */
+        value = ((unsigned long long)rnd() << 32) | rnd();
+        switch (rnd() % 6)
+        {
+        case 0: value &= 0xff; break;
+        case 1: value &= 0xffff; break;
+        case 2: value &= 0xffffffff; break;
+        case 3: value = 0ULL - (value & 0xffff); break;
+        case 4: value = rnd() % 3 ? 0 : 0xffffffff; break;
+        default: break;
+        }
+        s = rnd() % 8 ? "hello world" : RT_NULL;
+        size = rnd() % 10 ? BUF_SIZE : rnd() % 12;
+
+#define CHECK(arg)                                                                              \
+        do                                                                                      \
+        {                                                                                       \
+            if (star_width && star_precision)                                                   \
+                check_format(size, fmt, width, precision, arg);                                 \
+            else if (star_width)                                                                \
+                check_format(size, fmt, width, arg);                                            \
+            else if (star_precision)                                                            \
+                check_format(size, fmt, precision, arg);                                        \
+            else                                                                                \
+                check_format(size, fmt, arg);                                                   \
+        }                                                                                       \
+        while (0)
+
+        if (conversion == 's')
+            CHECK(s);
+        else if (conversion == 'p')
+            CHECK((void *)(rt_ubase_t)value);
+        else if (qualifier == 'L')
+            CHECK(value);
+        else
+            CHECK((rt_uint32_t)value);
+#undef CHECK
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_known);
+    RUN_TEST(test_digits);
+    RUN_TEST(test_random);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of rt_realloc_inplace and rt_realloc on the system heap, it is built
+ * for the small memory (mem.c), the slab (slab.c) and the memheap (memheap.c)
+ * allocators.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define STRESS_BLOCKS   300
+#define STRESS_ROUNDS   200000
+
+static void *blocks[STRESS_BLOCKS];
+static rt_size_t sizes[STRESS_BLOCKS];
+static rt_uint8_t patterns[STRESS_BLOCKS];
+static rt_uint32_t seed = 2;
+
+static rt_uint32_t random(void)
+{
+    seed = seed * 1103515245 + 12345;
+
+    return seed >> 8;
+}
+
+static void check_block(const void *block, rt_uint8_t pattern, rt_size_t size)
+{
+    rt_size_t index;
+
+    for (index = 0; index < size; index++)
+        TEST_ASSERT_EQUAL_HEX8(pattern, ((const rt_uint8_t *)block)[index]);
+}
+
+#ifndef RT_USING_SLAB
+static rt_uint32_t used_memory(void)
+{
+    rt_uint32_t total, used, max_used;
+
+    rt_memory_info(&total, &used, &max_used);
+
+    return used;
+}
+#endif
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void test_shrink(void)
+{
+    void *block;
+
+    block = rt_malloc(1000);
+    TEST_ASSERT_NOT_NULL(block);
+    rt_memset(block, 0x5a, 1000);
+
+    TEST_ASSERT_EQUAL_PTR(block, rt_realloc_inplace(block, 1000));
+    TEST_ASSERT_EQUAL_PTR(block, rt_realloc_inplace(block, 64));
+    check_block(block, 0x5a, 64);
+    TEST_ASSERT_EQUAL_PTR(block, rt_realloc_inplace(block, 1));
+    check_block(block, 0x5a, 1);
+
+    rt_free(block);
+}
+
+#ifdef RT_USING_SLAB
+/* a block is resized in its zone chunk or its pages */
+static void test_slab_chunk(void)
+{
+    void *block;
+
+    /* the chunks of 100 bytes are 104 bytes */
+    block = rt_malloc(100);
+    TEST_ASSERT_NOT_NULL(block);
+    rt_memset(block, 0x5a, 100);
+    TEST_ASSERT_EQUAL_PTR(block, rt_realloc_inplace(block, 104));
+    TEST_ASSERT_NULL(rt_realloc_inplace(block, 105));
+    check_block(block, 0x5a, 100);
+    rt_free(block);
+
+    /* the big blocks are in pages */
+    block = rt_malloc(60000);
+    TEST_ASSERT_NOT_NULL(block);
+    TEST_ASSERT_EQUAL_PTR(block, rt_realloc_inplace(block, RT_ALIGN(60000, RT_MM_PAGE_SIZE)));
+    TEST_ASSERT_NULL(rt_realloc_inplace(block, RT_ALIGN(60000, RT_MM_PAGE_SIZE) + 1));
+    rt_free(block);
+}
+#else
+/* a block grows into the free block next to it */
+static void test_grow_into_next(void)
+{
+    rt_uint8_t *a, *b, *c, *r;
+    rt_uint32_t used;
+
+    used = used_memory();
+
+    a = rt_malloc(100);
+    b = rt_malloc(2000);
+    c = rt_malloc(100);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT_TRUE(a < b && b < c);
+    rt_memset(a, 0x5a, 100);
+
+    /* b is used */
+    TEST_ASSERT_NULL(rt_realloc_inplace(a, 400));
+    check_block(a, 0x5a, 100);
+
+    rt_free(b);
+    r = rt_realloc(a, 1000);
+    TEST_ASSERT_EQUAL_PTR(a, r);
+    check_block(a, 0x5a, 100);
+
+    /* the whole free block, then c is used */
+    TEST_ASSERT_EQUAL_PTR(a, rt_realloc_inplace(a, 2000));
+    TEST_ASSERT_NULL(rt_realloc_inplace(a, 2200));
+
+    /* the tail freed by shrink is reused */
+    TEST_ASSERT_EQUAL_PTR(a, rt_realloc_inplace(a, 64));
+    b = rt_malloc(1500);
+    TEST_ASSERT_TRUE(b > a && b < c);
+    rt_free(b);
+
+    /* it can not grow, so it is moved */
+    r = rt_realloc(a, 3000);
+    TEST_ASSERT_NOT_NULL(r);
+    TEST_ASSERT_TRUE(r != a);
+    check_block(r, 0x5a, 64);
+
+    rt_free(r);
+    rt_free(c);
+    TEST_ASSERT_EQUAL(used, used_memory());
+}
+#endif
+
+static void test_stress(void)
+{
+    rt_size_t size, keep;
+    void *block;
+    int round, index;
+
+    for (round = 0; round < STRESS_ROUNDS; round++)
+    {
+        index = random() % STRESS_BLOCKS;
+        if (blocks[index] == RT_NULL)
+        {
+            sizes[index] = 1 + random() % 2000;
+            patterns[index] = (rt_uint8_t)random();
+            blocks[index] = rt_malloc(sizes[index]);
+            TEST_ASSERT_NOT_NULL(blocks[index]);
+            rt_memset(blocks[index], patterns[index], sizes[index]);
+        }
+        else if (random() % 3)
+        {
+            size = 1 + random() % 3000;
+            keep = size < sizes[index] ? size : sizes[index];
+
+            if (random() & 1)
+                block = rt_realloc(blocks[index], size);
+            else
+                block = rt_realloc_inplace(blocks[index], size);
+
+            if (block != RT_NULL)
+            {
+                check_block(block, patterns[index], keep);
+                blocks[index] = block;
+                sizes[index] = size;
+                rt_memset(block, patterns[index], size);
+            }
+            else
+            {
+                /* the block is not changed */
+                check_block(blocks[index], patterns[index], sizes[index]);
+            }
+        }
+        else
+        {
+            rt_free(blocks[index]);
+            blocks[index] = RT_NULL;
+        }
+    }
+
+    for (index = 0; index < STRESS_BLOCKS; index++)
+    {
+        rt_free(blocks[index]);
+        blocks[index] = RT_NULL;
+    }
+
+    /* the heap is still in one piece */
+    block = rt_malloc(4 * 1024 * 1024);
+    TEST_ASSERT_NOT_NULL(block);
+    rt_free(block);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_shrink);
+#ifdef RT_USING_SLAB
+    RUN_TEST(test_slab_chunk);
+#else
+    RUN_TEST(test_grow_into_next);
+#endif
+    RUN_TEST(test_stress);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the wakeup-to-run latency statistics (RT_USING_SCHED_LATENCY). The
+ * timestamp is a clock of the test, which is advanced while the scheduler is
+ * locked between the wakeup of a thread and the switch to it.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define PRIORITY        5
+
+static rt_uint32_t clock;
+
+rt_uint32_t rt_hw_timestamp_get(void)
+{
+    return clock;
+}
+
+static struct rt_thread thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t thread_stack[8192];
+static int runs;
+
+/* the thread runs once each time it is woken up */
+static void thread_entry(void *parameter)
+{
+    while (1)
+    {
+        runs++;
+        rt_thread_suspend(rt_thread_self());
+        rt_schedule();
+    }
+}
+
+/* wake the thread up, it is switched to after latency */
+static void wakeup(rt_uint32_t latency)
+{
+    int before = runs;
+
+    rt_enter_critical();
+    rt_thread_resume(&thread);
+    clock += latency;
+    rt_exit_critical();
+
+    TEST_ASSERT_EQUAL(before + 1, runs);
+}
+
+void setUp(void)
+{
+    rt_sched_latency_reset();
+}
+
+void tearDown(void)
+{
+}
+
+/* the statistics of the priority of thread, the others are not touched */
+static void test_stat(void)
+{
+    struct rt_sched_latency latency;
+    int index;
+
+    for (index = 0; index < 198; index++)
+        wakeup(10);
+    wakeup(5000);
+    wakeup(3000);
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_sched_latency_get(PRIORITY, &latency));
+    TEST_ASSERT_EQUAL(200, latency.count);
+    TEST_ASSERT_EQUAL(10, latency.min);
+    TEST_ASSERT_EQUAL(5000, latency.max);
+    TEST_ASSERT_EQUAL(198 * 10 + 5000 + 3000, latency.sum);
+    /* 10 is in [8, 16), 3000 and 5000 are in [2048, 4096) and [4096, 8192) */
+    TEST_ASSERT_EQUAL(198, latency.histogram[4]);
+    TEST_ASSERT_EQUAL(1, latency.histogram[12]);
+    TEST_ASSERT_EQUAL(1, latency.histogram[13]);
+    /* 2 samples of 200 are left out of the 99th percentile */
+    TEST_ASSERT_EQUAL(15, rt_sched_latency_p99(&latency));
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_sched_latency_get(PRIORITY + 1, &latency));
+    TEST_ASSERT_EQUAL(0, latency.count);
+    TEST_ASSERT_EQUAL(-RT_EINVAL, rt_sched_latency_get(RT_THREAD_PRIORITY_MAX, &latency));
+}
+
+/* the bucket of a latency is the number of its significant bits */
+static void test_bucket(void)
+{
+    static const rt_uint32_t latencies[] = {0, 1, 2, 3, 4, 255, 256, 0x7fffffff, 0x80000000};
+    static const int buckets[] = {0, 1, 2, 2, 3, 8, 9, 31, 31};
+    struct rt_sched_latency latency;
+    int index;
+
+    for (index = 0; index < (int)(sizeof(latencies) / sizeof(latencies[0])); index++)
+    {
+        rt_sched_latency_reset();
+        wakeup(latencies[index]);
+
+        rt_sched_latency_get(PRIORITY, &latency);
+        TEST_ASSERT_EQUAL(1, latency.count);
+        TEST_ASSERT_EQUAL(latencies[index], latency.min);
+        TEST_ASSERT_EQUAL(latencies[index], latency.max);
+        TEST_ASSERT_EQUAL(1, latency.histogram[buckets[index]]);
+        /* the bound of bucket is cut to the maximal latency */
+        TEST_ASSERT_EQUAL(latencies[index], rt_sched_latency_p99(&latency));
+    }
+}
+
+/* the p99 is the bound of the bucket which 99% of the samples reach */
+static void test_p99(void)
+{
+    struct rt_sched_latency latency;
+    int index;
+
+    /* with 100 samples, the largest one is left out */
+    for (index = 0; index < 99; index++)
+        wakeup(100);
+    wakeup(100000);
+    rt_sched_latency_get(PRIORITY, &latency);
+    TEST_ASSERT_EQUAL(127, rt_sched_latency_p99(&latency));
+
+    /* with 2 samples more, it is not */
+    wakeup(100000);
+    wakeup(100000);
+    rt_sched_latency_get(PRIORITY, &latency);
+    TEST_ASSERT_EQUAL(100000, rt_sched_latency_p99(&latency));
+}
+
+/* a reset clears the statistics, the next samples start from scratch */
+static void test_reset(void)
+{
+    struct rt_sched_latency latency;
+    int index;
+
+    wakeup(1000);
+    rt_sched_latency_reset();
+
+    rt_sched_latency_get(PRIORITY, &latency);
+    TEST_ASSERT_EQUAL(0, latency.count);
+    TEST_ASSERT_EQUAL(0, latency.max);
+    TEST_ASSERT_EQUAL(0, latency.sum);
+    for (index = 0; index < RT_SCHED_LATENCY_BUCKETS; index++)
+        TEST_ASSERT_EQUAL(0, latency.histogram[index]);
+
+    wakeup(20);
+    rt_sched_latency_get(PRIORITY, &latency);
+    TEST_ASSERT_EQUAL(1, latency.count);
+    TEST_ASSERT_EQUAL(20, latency.min);
+    TEST_ASSERT_EQUAL(20, latency.max);
+}
+
+int main(void)
+{
+    rt_thread_init(&thread, "latency", thread_entry, RT_NULL,
+                   thread_stack, sizeof(thread_stack), PRIORITY, 10);
+    /* the first run is not a wakeup */
+    rt_thread_startup(&thread);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_stat);
+    RUN_TEST(test_bucket);
+    RUN_TEST(test_p99);
+    RUN_TEST(test_reset);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
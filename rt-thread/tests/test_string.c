@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Exhaustive test of rt_strlen/rt_strnlen/rt_strcmp/rt_strncmp against byte
+ * loops, the return values shall be the same. The strings end right before
+ * an inaccessible page, so any read past the end faults: every length, start
+ * alignment and relative alignment of the strings, with a difference or a
+ * null byte at every position.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define GUARD_SIZE      128
+#define LENGTH_MAX      100
+#define COMPARE_MAX     48
+#define SHIFT_MAX       16
+
+static char *end_a, *end_b;
+static const rt_uint8_t values[] = {0, 1, 'a', 0x7f, 0x80, 0xff};
+
+/* the byte loops before the word scans */
+static rt_int32_t ref_strncmp(const char *cs, const char *ct, rt_ubase_t count)
+{
+    register signed char __res = 0;
+
+    while (count)
+    {
+        if ((__res = *cs - *ct++) != 0 || !*cs++)
+            break;
+        count --;
+    }
+
+    return __res;
+}
+
+static rt_int32_t ref_strcmp(const char *cs, const char *ct)
+{
+    while (*cs && *cs == *ct)
+    {
+        cs++;
+        ct++;
+    }
+
+    return (*cs - *ct);
+}
+
+static rt_size_t ref_strnlen(const char *s, rt_ubase_t maxlen)
+{
+    const char *sc;
+
+    for (sc = s; (rt_ubase_t)(sc - s) < maxlen && *sc != '\0'; ++sc);
+
+    return sc - s;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* a string of every length ends at the guard page, in every alignment */
+static void test_strlen(void)
+{
+    char *s;
+    int length, index, max;
+
+    for (length = 0; length <= LENGTH_MAX; length++)
+    {
+        s = end_a - length - 1;
+        for (index = 0; index < length; index++)
+            s[index] = 1 + (index * 37) % 255;
+        s[length] = '\0';
+
+        TEST_ASSERT_EQUAL(length, rt_strlen(s));
+        for (max = 0; max <= length + 20; max++)
+            TEST_ASSERT_EQUAL(ref_strnlen(s, max), rt_strnlen(s, max));
+    }
+}
+
+/* the bytes up to the guard page are not terminated, maxlen bounds the scan */
+static void test_strnlen_unterminated(void)
+{
+    int max;
+
+    rt_memset(end_a - LENGTH_MAX, 'z', LENGTH_MAX);
+    for (max = 0; max <= LENGTH_MAX; max++)
+        TEST_ASSERT_EQUAL(max, rt_strnlen(end_a - max, max));
+}
+
+static void check_compare(const char *s1, const char *s2, int count_max)
+{
+    int count;
+
+    TEST_ASSERT_EQUAL(ref_strcmp(s1, s2), rt_strcmp(s1, s2));
+    TEST_ASSERT_EQUAL(ref_strcmp(s2, s1), rt_strcmp(s2, s1));
+    for (count = 0; count <= count_max; count++)
+    {
+        TEST_ASSERT_EQUAL(ref_strncmp(s1, s2, count), rt_strncmp(s1, s2, count));
+        TEST_ASSERT_EQUAL(ref_strncmp(s2, s1, count), rt_strncmp(s2, s1, count));
+    }
+}
+
+/*
+ * the first string ends at a guard page, the second one is shifted by every
+ * relative alignment, with a difference or an early null at every position.
+ */
+static void test_strcmp(void)
+{
+    char *s1, *s2;
+    int length, shift, position, value, index;
+
+    for (length = 0; length <= COMPARE_MAX; length++)
+    {
+        for (shift = 0; shift < SHIFT_MAX; shift++)
+        {
+            s1 = end_a - length - 1;
+            s2 = end_b - length - 1 - shift;
+
+            for (position = -1; position <= length; position++)
+            {
+                for (value = 0; value < (int)sizeof(values); value++)
+                {
+                    for (index = 0; index < length; index++)
+                        s1[index] = s2[index] = 'a' + (index * 3) % 26;
+                    s1[length] = s2[length] = '\0';
+                    if (position >= 0)
+                        s2[position] = values[value];
+
+                    check_compare(s1, s2, length + 10);
+
+                    /* there is no difference to vary */
+                    if (position < 0)
+                        break;
+                }
+            }
+        }
+    }
+}
+
+/* the second string ends at a guard page instead */
+static void test_strcmp_equal(void)
+{
+    char *s1, *s2;
+    int length, shift, index;
+
+    for (length = 0; length <= COMPARE_MAX; length++)
+    {
+        for (shift = 0; shift < SHIFT_MAX; shift++)
+        {
+            s1 = end_a - length - 1 - shift;
+            s2 = end_b - length - 1;
+            for (index = 0; index < length; index++)
+                s1[index] = s2[index] = 'A' + index % 26;
+            s1[length] = s2[length] = '\0';
+
+            TEST_ASSERT_EQUAL(0, rt_strcmp(s1, s2));
+            TEST_ASSERT_EQUAL(0, rt_strncmp(s1, s2, length + 5));
+        }
+    }
+}
+
+int main(void)
+{
+    end_a = (char *)sim_guard_alloc(GUARD_SIZE) + GUARD_SIZE;
+    end_b = (char *)sim_guard_alloc(GUARD_SIZE) + GUARD_SIZE;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_strlen);
+    RUN_TEST(test_strnlen_unterminated);
+    RUN_TEST(test_strcmp);
+    RUN_TEST(test_strcmp_equal);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the thread cache (RT_USING_THREAD_CACHE): the threads deleted or
+ * exited are recycled by rt_thread_create, but never the running one, the
+ * memory is not freed in the context of rt_thread_delete, and the cache is
+ * returned to heap when it runs out. The stacks are not rounded up for the
+ * cache, a cached one is reused for the stack sizes a little smaller.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define STACK_SIZE      8192
+
+#ifdef RT_USING_KMEM_CACHE
+/* a new slab of thread objects may be taken */
+#define OBJECT_MEMORY   1024
+#else
+/* the object with the headers of heap blocks */
+#define OBJECT_MEMORY   (sizeof(struct rt_thread) + 64)
+#endif
+
+static rt_thread_t self_thread, self_created;
+static int free_calls;
+
+static void idle_entry(void *parameter)
+{
+}
+
+static void self_delete_entry(void *parameter)
+{
+    self_thread = rt_thread_self();
+
+    /* the thread is switched out at the first schedule once deleted */
+    rt_enter_critical();
+    rt_thread_delete(self_thread);
+    /* it is still running on its stack */
+    self_created = rt_thread_create("created", idle_entry, RT_NULL, STACK_SIZE, 20, 10);
+    rt_exit_critical();
+
+    /* never come back */
+    TEST_FAIL();
+}
+
+static void free_hook(void *ptr)
+{
+    free_calls++;
+}
+
+void setUp(void)
+{
+    free_calls = 0;
+}
+
+void tearDown(void)
+{
+    rt_free_delhook(free_hook);
+    /* reap the closed threads */
+    rt_thread_idle_excute();
+}
+
+static void test_create_after_self_delete(void)
+{
+    rt_thread_t thread;
+
+    thread = rt_thread_create("self", self_delete_entry, RT_NULL, STACK_SIZE, 5, 10);
+    TEST_ASSERT_NOT_NULL(thread);
+    /* it runs right now, as its priority is higher */
+    rt_thread_startup(thread);
+
+    TEST_ASSERT_EQUAL_PTR(thread, self_thread);
+    TEST_ASSERT_NOT_NULL(self_created);
+    TEST_ASSERT_TRUE(self_created != self_thread);
+    TEST_ASSERT_EQUAL(RT_THREAD_CLOSE, self_thread->stat & RT_THREAD_STAT_MASK);
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_delete(self_created));
+}
+
+static void test_delete_is_deferred(void)
+{
+    rt_thread_t thread, created;
+    rt_base_t level;
+
+    thread = rt_thread_create("defer", idle_entry, RT_NULL, STACK_SIZE, 20, 10);
+    TEST_ASSERT_NOT_NULL(thread);
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_free_sethook(free_hook));
+    level = rt_hw_interrupt_disable();
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_delete(thread));
+    rt_hw_interrupt_enable(level);
+    TEST_ASSERT_EQUAL(0, free_calls);
+
+    /* the next creation recycles it */
+    created = rt_thread_create("reuse", idle_entry, RT_NULL, STACK_SIZE, 20, 10);
+    TEST_ASSERT_EQUAL_PTR(thread, created);
+    TEST_ASSERT_EQUAL(0, free_calls);
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_delete(created));
+}
+
+static void test_exited_thread_is_recycled(void)
+{
+    rt_thread_t thread, created;
+
+    thread = rt_thread_create("exit", idle_entry, RT_NULL, STACK_SIZE, 5, 10);
+    TEST_ASSERT_NOT_NULL(thread);
+    rt_thread_startup(thread);
+
+    created = rt_thread_create("reuse", idle_entry, RT_NULL, STACK_SIZE, 20, 10);
+    TEST_ASSERT_EQUAL_PTR(thread, created);
+
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_delete(created));
+}
+
+/* the stacks are allocated in the size asked for, not rounded up */
+static void test_stack_size(void)
+{
+    rt_thread_t thread;
+
+    thread = rt_thread_create("size", idle_entry, RT_NULL, 3000, 20, 10);
+    TEST_ASSERT_NOT_NULL(thread);
+    TEST_ASSERT_EQUAL(3000, thread->stack_size);
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_delete(thread));
+}
+
+/*
+ * the memory of a thread is its stack and object, neither the stack nor the
+ * block with the object co-located is taken to the next power of 2.
+ */
+static void test_thread_memory(void)
+{
+    rt_thread_t thread;
+    rt_uint32_t total, used, used_before, max_used;
+    rt_uint32_t stack_size;
+    int index;
+
+    for (index = 0; index < 8; index++)
+    {
+        stack_size = (2048 << (index / 2)) + (index & 1) * RT_ALIGN_SIZE;
+
+        rt_memory_info(&total, &used_before, &max_used);
+        thread = rt_thread_create("memory", idle_entry, RT_NULL, stack_size, 20, 10);
+        TEST_ASSERT_NOT_NULL(thread);
+        TEST_ASSERT_EQUAL(stack_size, thread->stack_size);
+        rt_memory_info(&total, &used, &max_used);
+        TEST_ASSERT_TRUE(used - used_before <= stack_size + OBJECT_MEMORY);
+        TEST_ASSERT_EQUAL(RT_EOK, rt_thread_delete(thread));
+        rt_thread_idle_excute();
+    }
+}
+
+/* a cached stack is reused for the stack sizes a little smaller, the best fit first */
+static void test_stack_fit(void)
+{
+    rt_thread_t small, large, thread;
+
+    small = rt_thread_create("small", idle_entry, RT_NULL, 2048, 20, 10);
+    large = rt_thread_create("large", idle_entry, RT_NULL, 4096, 20, 10);
+    TEST_ASSERT_NOT_NULL(small);
+    TEST_ASSERT_NOT_NULL(large);
+    rt_thread_delete(small);
+    rt_thread_delete(large);
+    rt_thread_idle_excute();
+
+    /* the larger stack would fit, but is too much bigger */
+    thread = rt_thread_create("fit", idle_entry, RT_NULL, 2000, 20, 10);
+    TEST_ASSERT_EQUAL_PTR(small, thread);
+    TEST_ASSERT_EQUAL(2048, thread->stack_size);
+    rt_thread_delete(thread);
+    rt_thread_idle_excute();
+
+    thread = rt_thread_create("fit", idle_entry, RT_NULL, 3072, 20, 10);
+    TEST_ASSERT_TRUE(thread != small && thread != large);
+    TEST_ASSERT_EQUAL(3072, thread->stack_size);
+    rt_thread_delete(thread);
+
+    thread = rt_thread_create("fit", idle_entry, RT_NULL, 4000, 20, 10);
+    TEST_ASSERT_EQUAL_PTR(large, thread);
+    rt_thread_delete(thread);
+}
+
+static void test_cache_flush(void)
+{
+    rt_thread_t threads[4], thread;
+    void **blocks = RT_NULL, **block;
+    rt_size_t size;
+    int index;
+
+    /* fill the cache of 16K stacks */
+    for (index = 0; index < 4; index++)
+    {
+        threads[index] = rt_thread_create("big", idle_entry, RT_NULL, 16384, 20, 10);
+        TEST_ASSERT_NOT_NULL(threads[index]);
+    }
+    for (index = 0; index < 4; index++)
+        rt_thread_delete(threads[index]);
+    rt_thread_idle_excute();
+
+    /* run out of heap */
+    for (size = 65536; size >= sizeof(void *); size /= 2)
+    {
+        while ((block = (void **)rt_malloc(size)) != RT_NULL)
+        {
+            *block = blocks;
+            blocks = block;
+        }
+    }
+
+    /* the other stack size is allocated from the memory of cache */
+    thread = rt_thread_create("small", idle_entry, RT_NULL, 1024, 20, 10);
+    TEST_ASSERT_NOT_NULL(thread);
+    TEST_ASSERT_EQUAL(RT_EOK, rt_thread_delete(thread));
+
+    while (blocks != RT_NULL)
+    {
+        block = blocks;
+        blocks = (void **)*block;
+        rt_free(block);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_create_after_self_delete);
+    RUN_TEST(test_delete_is_deferred);
+    RUN_TEST(test_exited_thread_is_recycled);
+    RUN_TEST(test_stack_size);
+    RUN_TEST(test_stack_fit);
+    RUN_TEST(test_thread_memory);
+    RUN_TEST(test_cache_flush);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
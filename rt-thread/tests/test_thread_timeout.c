@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the thread timeouts, built in the default layout of thread control
+ * block and in the compact one (RT_USING_THREAD_COMPACT), where the timeouts
+ * are on a list of their own instead of the built-in timers: the expiry, the
+ * stop on wakeup, rt_timer_check and rt_timer_next_timeout_tick.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+
+#define WAITERS         4
+#define PRIORITY        5
+
+static struct rt_thread waiters[WAITERS];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t waiter_stacks[WAITERS][8192];
+static struct rt_semaphore sems[WAITERS];
+static rt_int32_t timeouts[WAITERS];
+static rt_err_t results[WAITERS];
+static rt_tick_t ticks[WAITERS];
+static int order[WAITERS];
+static int woken;
+
+/* a waiter takes its semaphore once, with the timeout of it */
+static void waiter_entry(void *parameter)
+{
+    int index = (int)(rt_ubase_t)parameter;
+
+    results[index] = rt_sem_take(&sems[index], timeouts[index]);
+    ticks[index] = rt_tick_get();
+    order[woken++] = index;
+}
+
+/* start the waiters of timeouts, they run at once and wait */
+static void start_waiters(const rt_int32_t *timeout, int count)
+{
+    int index;
+
+    for (index = 0; index < count; index++)
+    {
+        timeouts[index] = timeout[index];
+        rt_thread_init(&waiters[index], "waiter", waiter_entry, (void *)(rt_ubase_t)index,
+                       waiter_stacks[index], sizeof(waiter_stacks[index]), PRIORITY, 10);
+        rt_thread_startup(&waiters[index]);
+    }
+}
+
+/* the ticks from now to the next timeout */
+static rt_tick_t next_timeout(void)
+{
+    return rt_timer_next_timeout_tick() - rt_tick_get();
+}
+
+void setUp(void)
+{
+    int index;
+
+    for (index = 0; index < WAITERS; index++)
+    {
+        rt_sem_init(&sems[index], "sem", 0, RT_IPC_FLAG_FIFO);
+        results[index] = RT_EOK;
+        ticks[index] = 0;
+    }
+    woken = 0;
+}
+
+void tearDown(void)
+{
+    int index;
+
+    for (index = 0; index < WAITERS; index++)
+        rt_sem_detach(&sems[index]);
+}
+
+/* the waiters time out at their ticks, the ones of the same tick in order */
+static void test_expiry(void)
+{
+    static const rt_int32_t timeout[WAITERS] = {30, 10, 20, 10};
+    static const int expected[WAITERS] = {1, 3, 2, 0};
+    rt_tick_t start;
+    int index;
+
+    start = rt_tick_get();
+    start_waiters(timeout, WAITERS);
+    TEST_ASSERT_EQUAL(10, next_timeout());
+
+    rt_thread_mdelay(40);
+    TEST_ASSERT_EQUAL(WAITERS, woken);
+    for (index = 0; index < WAITERS; index++)
+    {
+        TEST_ASSERT_EQUAL(expected[index], order[index]);
+        TEST_ASSERT_EQUAL(-RT_ETIMEOUT, results[index]);
+        TEST_ASSERT_EQUAL(start + timeout[index], ticks[index]);
+    }
+    TEST_ASSERT_EQUAL(RT_TICK_MAX, rt_timer_next_timeout_tick());
+}
+
+/* a waiter woken up before its timeout does not time out later */
+static void test_stop(void)
+{
+    static const rt_int32_t timeout[2] = {10, 20};
+    rt_tick_t start;
+
+    start = rt_tick_get();
+    start_waiters(timeout, 2);
+
+    rt_thread_mdelay(5);
+    rt_sem_release(&sems[0]);
+    TEST_ASSERT_EQUAL(1, woken);
+    TEST_ASSERT_EQUAL(RT_EOK, results[0]);
+    TEST_ASSERT_EQUAL(start + 5, ticks[0]);
+    /* the timeout of the waiter left is the next one */
+    TEST_ASSERT_EQUAL(15, next_timeout());
+
+    rt_sem_release(&sems[1]);
+    TEST_ASSERT_EQUAL(2, woken);
+    TEST_ASSERT_EQUAL(RT_EOK, results[1]);
+    TEST_ASSERT_EQUAL(RT_TICK_MAX, rt_timer_next_timeout_tick());
+
+    /* no timeout comes after the stop */
+    rt_thread_mdelay(30);
+    TEST_ASSERT_EQUAL(2, woken);
+}
+
+static int timer_count;
+
+static void timer_timeout(void *parameter)
+{
+    timer_count++;
+}
+
+/* the next timeout is the earliest one of the timers and the threads */
+static void test_next_timeout(void)
+{
+    static const rt_int32_t timeout[2] = {20, 10};
+    struct rt_timer timer;
+    rt_tick_t tick = 15;
+
+    timer_count = 0;
+    start_waiters(timeout, 2);
+    TEST_ASSERT_EQUAL(10, next_timeout());
+
+    rt_timer_init(&timer, "timer", timer_timeout, RT_NULL, 5, RT_TIMER_FLAG_ONE_SHOT);
+    rt_timer_start(&timer);
+    TEST_ASSERT_EQUAL(5, next_timeout());
+    rt_timer_stop(&timer);
+    TEST_ASSERT_EQUAL(10, next_timeout());
+
+    rt_timer_control(&timer, RT_TIMER_CTRL_SET_TIME, &tick);
+    rt_timer_start(&timer);
+    TEST_ASSERT_EQUAL(10, next_timeout());
+
+    /* the scheduler is locked, the expired waiter is made ready only */
+    rt_enter_critical();
+    rt_tick_set(rt_tick_get() + 10);
+    rt_timer_check();
+    TEST_ASSERT_EQUAL(0, woken);
+    TEST_ASSERT_EQUAL(RT_THREAD_READY, waiters[1].stat & RT_THREAD_STAT_MASK);
+    TEST_ASSERT_EQUAL(RT_THREAD_SUSPEND, waiters[0].stat & RT_THREAD_STAT_MASK);
+    TEST_ASSERT_EQUAL(5, next_timeout());
+    rt_exit_critical();
+    TEST_ASSERT_EQUAL(1, woken);
+    TEST_ASSERT_EQUAL(-RT_ETIMEOUT, results[1]);
+
+    /* the timer and the waiter left */
+    rt_enter_critical();
+    rt_tick_set(rt_tick_get() + 5);
+    rt_timer_check();
+    TEST_ASSERT_EQUAL(1, timer_count);
+    TEST_ASSERT_EQUAL(5, next_timeout());
+    rt_tick_set(rt_tick_get() + 5);
+    rt_timer_check();
+    rt_exit_critical();
+    TEST_ASSERT_EQUAL(2, woken);
+    TEST_ASSERT_EQUAL(-RT_ETIMEOUT, results[0]);
+    TEST_ASSERT_EQUAL(RT_TICK_MAX, rt_timer_next_timeout_tick());
+
+    rt_timer_detach(&timer);
+}
+
+/* the timeouts across the wrap of tick */
+static void test_wrap(void)
+{
+    static const rt_int32_t timeout[3] = {20, 3, 10};
+    static const int expected[3] = {1, 2, 0};
+    rt_tick_t start;
+    int index;
+
+    rt_tick_set(RT_TICK_MAX - 5);
+    start = rt_tick_get();
+    start_waiters(timeout, 3);
+    TEST_ASSERT_EQUAL(3, next_timeout());
+
+    rt_thread_mdelay(30);
+    TEST_ASSERT_EQUAL(3, woken);
+    for (index = 0; index < 3; index++)
+    {
+        TEST_ASSERT_EQUAL(expected[index], order[index]);
+        TEST_ASSERT_EQUAL(-RT_ETIMEOUT, results[index]);
+        TEST_ASSERT_EQUAL(start + timeout[index], ticks[index]);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_expiry);
+    RUN_TEST(test_stop);
+    RUN_TEST(test_next_timeout);
+    RUN_TEST(test_wrap);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
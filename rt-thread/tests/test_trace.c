@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Test of the trace start: the events are recorded once started, and a full
+ * hook list fails the start with no trace hook left on the other lists.
+ */
+
+#include <rtthread.h>
+#include <unity.h>
+#include <cpuport.h>
+#include "trace.h"
+
+static struct rt_trace_event events[16];
+
+#define HOOK(n)                                                         \
+    static void switch##n(rt_thread_t from, rt_thread_t to) { }         \
+    static void timer##n(struct rt_timer *timer) { }                    \
+    static void free##n(void *ptr) { }
+HOOK(0) HOOK(1) HOOK(2) HOOK(3)
+#undef HOOK
+
+static void (*const switch_hooks[])(rt_thread_t from, rt_thread_t to) = {switch0, switch1, switch2, switch3};
+static void (*const timer_hooks[])(struct rt_timer *timer) = {timer0, timer1, timer2, timer3};
+static void (*const free_hooks[])(void *ptr) = {free0, free1, free2, free3};
+
+void setUp(void)
+{
+    rt_trace_clear();
+}
+
+void tearDown(void)
+{
+    rt_trace_stop();
+    rt_scheduler_sethook(RT_NULL);
+    rt_timer_exit_sethook(RT_NULL);
+    rt_free_sethook(RT_NULL);
+}
+
+static void test_start(void)
+{
+    TEST_ASSERT_EQUAL(RT_EOK, rt_trace_start());
+    /* started twice is still started */
+    TEST_ASSERT_EQUAL(RT_EOK, rt_trace_start());
+
+    rt_free(rt_malloc(32));
+    rt_thread_mdelay(1);
+    rt_trace_stop();
+    TEST_ASSERT_TRUE(rt_trace_read(events, 16) > 0);
+
+    rt_thread_mdelay(1);
+    TEST_ASSERT_EQUAL(0, rt_trace_read(events, 16));
+}
+
+/* the last list is full, the hooks of the lists before are removed */
+static void test_start_full(void)
+{
+    int index;
+
+    TEST_ASSERT_EQUAL(4, RT_HOOK_LIST_SIZE);
+    for (index = 0; index < RT_HOOK_LIST_SIZE; index++)
+        TEST_ASSERT_EQUAL(RT_EOK, rt_timer_exit_sethook(timer_hooks[index]));
+
+    TEST_ASSERT_EQUAL(-RT_EFULL, rt_trace_start());
+    rt_free(rt_malloc(32));
+    rt_thread_mdelay(1);
+    TEST_ASSERT_EQUAL(0, rt_trace_read(events, 16));
+
+    /* the whole lists are free again */
+    for (index = 0; index < RT_HOOK_LIST_SIZE; index++)
+    {
+        TEST_ASSERT_EQUAL(RT_EOK, rt_scheduler_sethook(switch_hooks[index]));
+        TEST_ASSERT_EQUAL(RT_EOK, rt_free_sethook(free_hooks[index]));
+    }
+    rt_scheduler_sethook(RT_NULL);
+    rt_free_sethook(RT_NULL);
+
+    /* it starts once there is room */
+    TEST_ASSERT_EQUAL(RT_EOK, rt_timer_exit_delhook(timer3));
+    TEST_ASSERT_EQUAL(RT_EOK, rt_trace_start());
+    rt_thread_mdelay(1);
+    TEST_ASSERT_TRUE(rt_trace_read(events, 16) > 0);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_start);
+    RUN_TEST(test_start_full);
+    sim_exit(UNITY_END());
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2023, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     agent        first version
+#
+"""Render the output of msh command `binlog dump` to text.
+
+The records only hold the address of the format string, so the format
+strings (and the constant strings passed to "%s") are read from the ELF
+image which runs on target.
+
+usage: binlog2txt.py rtthread.elf console.log [-o log.txt]
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+HEADER_RE = re.compile(r'#RTBINLOG\s+(\d+)\s+(\d+)\s+(\d+)')
+RECORD_RE = re.compile(r'^L((?:\s+[0-9a-fA-F]+)+)\s*$')
+END_RE = re.compile(r'#END\s+(\d+)')
+
+# printf conversion: flags, width, precision, length, conversion
+SPEC_RE = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|z|t|j)?([diouxXcsp%])')
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+
+class Image(object):
+    """The loadable sections of an ELF file, to read memory by address."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s is not an ELF file' % path)
+
+        is64 = self.data[4] == 2
+        endian = '<' if self.data[5] == 1 else '>'
+        if is64:
+            shoff, = struct.unpack_from(endian + 'Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data, 0x3a)
+            shdr = endian + 'IIQQQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data, 0x2e)
+            shdr = endian + 'IIIIII'
+
+        self.sections = []
+        for index in range(shnum):
+            _, stype, flags, addr, offset, size = struct.unpack_from(
+                shdr, self.data, shoff + index * shentsize)
+            if flags & SHF_ALLOC and stype != SHT_NOBITS and size:
+                self.sections.append((addr, size, offset))
+
+    def string(self, addr):
+        """Return the C string at addr, or None if it is not in the image."""
+        for start, size, offset in self.sections:
+            if start <= addr < start + size:
+                begin = offset + addr - start
+                end = self.data.find(b'\0', begin, offset + size)
+                if end < 0:
+                    end = offset + size
+                return self.data[begin:end].decode('utf-8', 'replace')
+        return None
+
+
+def parse(lines):
+    """Return (freq, word size, records, dropped) of all dumps in lines."""
+    freq, word, records, dropped = None, 4, [], 0
+
+    for line in lines:
+        line = line.strip()
+        # the console may prefix a dump line with the shell prompt
+        m = HEADER_RE.search(line)
+        if m:
+            if int(m.group(1)) != 1:
+                raise ValueError('unsupported binlog version %s' % m.group(1))
+            # the records are removed by dump, so the dumps are consecutive
+            freq, word = int(m.group(2)), int(m.group(3))
+            continue
+        if freq is None:
+            continue
+
+        m = RECORD_RE.match(line)
+        if m:
+            records.append([int(v, 16) for v in m.group(1).split()])
+            continue
+        m = END_RE.search(line)
+        if m:
+            dropped = int(m.group(1))
+
+    if freq is None:
+        raise ValueError('no binlog dump found')
+    return freq, word, records, dropped
+
+
+def render(image, fmt, args, word):
+    """Format like rt_kprintf, the arguments are the raw words."""
+    out = []
+    pos = 0
+    args = list(args)
+    bits = word * 8
+
+    def take():
+        return args.pop(0) if args else 0
+
+    # the "l" of rt_kprintf is 32 bits, a wider argument is not recorded
+    def signed(value, length):
+        width = min(bits, 64) if length in ('ll', 'j', 'z', 't') else 32
+        value &= (1 << width) - 1
+        return value - (1 << width) if value >> (width - 1) else value
+
+    for m in SPEC_RE.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, length, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+
+        if width == '*':
+            width = str(signed(take(), None))
+        if prec == '*':
+            prec = str(signed(take(), None))
+        spec = '%' + flags + (width or '') + ('.' + prec if prec is not None else '')
+        value = take()
+
+        if conv in 'di':
+            out.append((spec + 'd') % signed(value, length))
+        elif conv in 'ouxX':
+            if length not in ('ll', 'j', 'z', 't'):
+                value &= 0xffffffff
+            out.append((spec + ('d' if conv == 'u' else conv)) % value)
+        elif conv == 'c':
+            out.append((spec + 'c') % chr(value & 0xff))
+        elif conv == 's':
+            string = image.string(value)
+            if string is None:
+                string = '<0x%x>' % value
+            out.append((spec + 's') % string)
+        elif conv == 'p':
+            out.append('%0*x' % (word * 2, value))
+
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def convert(image, freq, word, records):
+    lines = []
+    base, last, wrap = None, 0, 0
+
+    for record in records:
+        if len(record) < 3 or len(record) != 3 + record[1]:
+            lines.append('<broken record: %s>\n' % ' '.join('%x' % v for v in record))
+            continue
+        addr, argc, stamp = record[:3]
+
+        # unwrap the 32 bits timestamp
+        if base is None:
+            base, last = stamp, stamp
+        if stamp < last:
+            wrap += 1 << 32
+        last = stamp
+        seconds = float(stamp + wrap - base) / freq
+
+        fmt = image.string(addr)
+        if fmt is None:
+            text = '<unknown format 0x%x>%s\n' % (addr, ''.join(' %x' % v for v in record[3:]))
+        else:
+            text = render(image, fmt, record[3:], word)
+        if not text.endswith('\n'):
+            text += '\n'
+        lines.append('[%12.6f] %s' % (seconds, text))
+
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description='render RT-Thread binary log dump to text')
+    parser.add_argument('elf', help='ELF image which runs on target')
+    parser.add_argument('input', help='console log which contains the output of "binlog dump"')
+    parser.add_argument('-o', '--output', help='output text file, default to stdout')
+    args = parser.parse_args()
+
+    image = Image(args.elf)
+    with open(args.input, errors='replace') as f:
+        freq, word, records, dropped = parse(f)
+
+    if dropped:
+        sys.stderr.write('warning: %d logs were dropped since the buffer was full\n' % dropped)
+
+    lines = convert(image, freq, word, records)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.writelines(lines)
+    else:
+        sys.stdout.writelines(lines)
+
+
+if __name__ == '__main__':
+    main()
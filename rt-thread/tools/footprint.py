@@ -0,0 +1,439 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2023, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     agent        first version
+#
+"""Report the static RAM and flash footprint of the kernel for a rtconfig.h.
+
+The kernel and the components are compiled with the given compiler and
+configuration, then the sections and symbols of the object files are read
+to report:
+
+  - the size of each kernel object (struct rt_thread, rt_semaphore ...)
+  - text, rodata, data and bss of each source file
+  - the static RAM map: TCBs, stacks, scheduler tables, timer lists,
+    console buffers ...
+
+With --explore, the kernel is rebuilt with each option switched off and
+each size parameter reduced, and the savings are listed.
+
+The objects are not linked, so the flash is the upper bound before the
+unused functions are removed by --gc-sections. libcpu, the board and the
+heap given to rt_system_heap_init() are not counted.
+
+usage: footprint.py [bsp/rtconfig.h] [--cc arm-none-eabi-gcc]
+                    [--cflags "-mcpu=cortex-m3 -mthumb -Os"] [--explore]
+"""
+
+import argparse
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+from concurrent.futures import ThreadPoolExecutor
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# sources: (path, option which enables it)
+SOURCES = [
+    ('src/*.c', None),
+    ('components/device/device.c', 'RT_USING_DEVICE'),
+    ('components/finsh/cmd.c', 'RT_USING_FINSH'),
+    ('components/finsh/msh.c', 'RT_USING_FINSH'),
+    ('components/finsh/shell.c', 'RT_USING_FINSH'),
+    ('components/trace/trace.c', 'RT_USING_TRACE'),
+    ('components/binlog/binlog.c', 'RT_USING_BINLOG'),
+]
+
+INCLUDES = ['include', 'components/finsh', 'components/trace', 'components/binlog']
+
+# kernel objects: (name, option which enables it)
+OBJECTS = [
+    ('struct rt_object', None),
+    ('struct rt_thread', None),
+    ('struct rt_timer', None),
+    ('struct rt_semaphore', 'RT_USING_SEMAPHORE'),
+    ('struct rt_mutex', 'RT_USING_MUTEX'),
+    ('struct rt_event', 'RT_USING_EVENT'),
+    ('struct rt_mailbox', 'RT_USING_MAILBOX'),
+    ('struct rt_messagequeue', 'RT_USING_MESSAGEQUEUE'),
+    ('struct rt_mempool', 'RT_USING_MEMPOOL'),
+    ('struct rt_device', 'RT_USING_DEVICE'),
+]
+
+# the static RAM map, the first matched category of a symbol is used
+CATEGORIES = [
+    ('stacks', re.compile(r'stack')),
+    ('TCBs', None),
+    ('scheduler tables', re.compile(r'^rt_thread_(priority_table|ready_table|ready_priority_group)$|'
+                                    r'^rt_sched_latency_table$')),
+    ('timer lists', re.compile(r'timer_list|timeout_list')),
+    ('console buffers', re.compile(r'console|log_buf|shell|finsh')),
+    ('object container', re.compile(r'^rt_object_container$|^_object_cache$')),
+    ('heap management', re.compile(r'heap|mem|magazine|zone|lfree|_region')),
+    ('other', re.compile(r'')),
+]
+
+# the size parameters to be tried by --explore, only the smaller values
+PARAMETERS = {
+    'RT_THREAD_PRIORITY_MAX': [8, 32],
+    'RT_NAME_MAX': [4, 6],
+    'RT_TIMER_SKIP_LIST_LEVEL': [1],
+    'RT_CONSOLEBUF_SIZE': [64, 128],
+}
+
+SHF_WRITE = 0x1
+SHF_ALLOC = 0x2
+SHF_EXECINSTR = 0x4
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHN_COMMON = 0xfff2
+STT_SECTION = 3
+
+
+class ObjectFile(object):
+    """The allocated sections and the data symbols of a relocatable ELF file."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = data = f.read()
+        if data[:4] != b'\x7fELF':
+            raise ValueError('%s is not an ELF file' % path)
+
+        is64 = data[4] == 2
+        self.endian = endian = '<' if data[5] == 1 else '>'
+        if is64:
+            shoff, = struct.unpack_from(endian + 'Q', data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', data, 0x3a)
+            shdr, sym = endian + 'IIQQQQIIQQ', endian + 'IBBHQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', data, 0x2e)
+            shdr, sym = endian + 'IIIIIIIIII', endian + 'IIIBBH'
+
+        headers = [struct.unpack_from(shdr, data, shoff + index * shentsize)
+                   for index in range(shnum)]
+        self.offsets = [header[4] for header in headers]
+
+        # section index -> kind of text, rodata, data or bss
+        self.sections = {}
+        self.size = {'text': 0, 'rodata': 0, 'data': 0, 'bss': 0}
+        for index, (_, stype, flags, _, _, size, _, _, _, _) in enumerate(headers):
+            if not flags & SHF_ALLOC:
+                continue
+            if stype == SHT_NOBITS:
+                kind = 'bss'
+            elif flags & SHF_EXECINSTR:
+                kind = 'text'
+            elif flags & SHF_WRITE:
+                kind = 'data'
+            else:
+                kind = 'rodata'
+            self.sections[index] = kind
+            self.size[kind] += size
+
+        # (name, kind, size, section index, value)
+        self.symbols = []
+        for _, stype, _, _, offset, size, link, _, _, entsize in headers:
+            if stype != SHT_SYMTAB:
+                continue
+            strtab = headers[link][4]
+            for pos in range(offset + entsize, offset + size, entsize):
+                if is64:
+                    name, info, _, shndx, value, length = struct.unpack_from(sym, data, pos)
+                else:
+                    name, value, length, info, _, shndx = struct.unpack_from(sym, data, pos)
+                if info & 0x0f == STT_SECTION or length == 0:
+                    continue
+                name = data[strtab + name:data.index(b'\0', strtab + name)].decode()
+                if shndx == SHN_COMMON:
+                    # the alignment is not counted
+                    self.size['bss'] += length
+                    self.symbols.append((name, 'bss', length, shndx, value))
+                elif shndx in self.sections:
+                    self.symbols.append((name, self.sections[shndx], length, shndx, value))
+
+    def words(self, symbol):
+        """Return the content of a constant symbol as 32 bits words."""
+        for name, kind, size, shndx, value in self.symbols:
+            if name == symbol:
+                start = self.offsets[shndx] + value
+                return struct.unpack_from(self.endian + '%dI' % (size // 4), self.data, start)
+        raise KeyError(symbol)
+
+
+class Build(object):
+    """The objects of the kernel compiled with a configuration."""
+
+    def __init__(self, args, config, defines=(), undefs=()):
+        self.args = args
+        self.workdir = tempfile.mkdtemp(prefix='footprint-')
+        self.files = {}
+        self.failed = []
+
+        # wrap the configuration to override the options without touching it
+        with open(os.path.join(self.workdir, 'rtconfig.h'), 'w') as f:
+            f.write('#ifndef __FOOTPRINT_CFG_H__\n#define __FOOTPRINT_CFG_H__\n')
+            f.write('#include "%s"\n' % os.path.abspath(config).replace('\\', '/'))
+            for name in undefs:
+                f.write('#undef %s\n' % name)
+            for item in defines:
+                name, _, value = item.partition('=')
+                f.write('#undef %s\n#define %s %s\n' % (name, name, value))
+            f.write('#endif\n')
+
+        self.flags = [args.cc] + args.cflags.split() + [
+            '-c', '-w', '-ffunction-sections', '-fdata-sections',
+            '-I', self.workdir, '-I', os.path.dirname(os.path.abspath(config))]
+        for path in INCLUDES:
+            self.flags += ['-I', os.path.join(ROOT, path)]
+
+    def compile(self, source, output):
+        result = subprocess.run(self.flags + [source, '-o', output],
+                                stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        if result.returncode != 0:
+            return result.stdout.decode(errors='replace')
+        return None
+
+    def macros(self):
+        """Return all macros defined by the configuration, name -> value."""
+        command = self.flags[:]
+        command.remove('-c')
+        result = subprocess.run(command + ['-dM', '-E', os.path.join(self.workdir, 'rtconfig.h')],
+                                stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        if result.returncode != 0:
+            raise RuntimeError(result.stderr.decode(errors='replace'))
+
+        macros = {}
+        for line in result.stdout.decode(errors='replace').splitlines():
+            m = re.match(r'#define (\w+)(?: (.*))?$', line)
+            if m:
+                macros[m.group(1)] = (m.group(2) or '').strip()
+        return macros
+
+    def run(self, jobs):
+        # the components are added to project only when they are enabled
+        macros = self.macros()
+        sources = []
+        for pattern, option in SOURCES:
+            if option and option not in macros:
+                continue
+            directory, _, name = pattern.rpartition('/')
+            if name == '*.c':
+                sources += sorted(os.path.join(directory, entry)
+                                  for entry in os.listdir(os.path.join(ROOT, directory))
+                                  if entry.endswith('.c'))
+            else:
+                sources.append(pattern)
+
+        def work(source):
+            output = os.path.join(self.workdir, source.replace('/', '_') + '.o')
+            return source, output, self.compile(os.path.join(ROOT, source), output)
+
+        with ThreadPoolExecutor(jobs) as executor:
+            for source, output, error in executor.map(work, sources):
+                if error is not None:
+                    self.failed.append((source, error))
+                else:
+                    self.files[source] = ObjectFile(output)
+
+        self.objects = self.probe()
+        return self
+
+    def probe(self):
+        """Return the sizes of kernel objects compiled by the target compiler."""
+        source = os.path.join(self.workdir, 'probe.c')
+        with open(source, 'w') as f:
+            f.write('#include <rtthread.h>\n\n')
+            f.write('const rt_uint32_t footprint_probe[] =\n{\n')
+            for name, option in OBJECTS:
+                if option:
+                    f.write('#ifdef %s\n    sizeof(%s),\n#else\n    0,\n#endif\n' % (option, name))
+                else:
+                    f.write('    sizeof(%s),\n' % name)
+            f.write('};\n')
+
+        output = source + '.o'
+        error = self.compile(source, output)
+        if error is not None:
+            self.failed.append(('probe.c', error))
+            return []
+        sizes = ObjectFile(output).words('footprint_probe')
+        return [(name, size) for (name, _), size in zip(OBJECTS, sizes) if size]
+
+    def total(self, kind):
+        return sum(obj.size[kind] for obj in self.files.values())
+
+    def flash(self):
+        return self.total('text') + self.total('rodata') + self.total('data')
+
+    def ram(self):
+        return self.total('data') + self.total('bss')
+
+    def ram_map(self):
+        """Return {category: [(symbol, size, source)]} of the static RAM."""
+        tcb = dict(self.objects).get('struct rt_thread')
+        result = {}
+        for source, obj in self.files.items():
+            for name, kind, size, _, _ in obj.symbols:
+                if kind not in ('data', 'bss'):
+                    continue
+                # the static symbols of function are suffixed by a number
+                name = re.sub(r'\.\d+$', '', name)
+                for category, pattern in CATEGORIES:
+                    if pattern is None:
+                        if size == tcb and 'stack' not in name:
+                            break
+                    elif pattern.search(name):
+                        break
+                result.setdefault(category, []).append((name, size, source))
+        return result
+
+    def clean(self):
+        if not self.args.keep:
+            shutil.rmtree(self.workdir, ignore_errors=True)
+
+
+def config_names(path, names=None):
+    """Return the macros defined in the configuration and its quoted includes."""
+    if names is None:
+        names = set()
+    with open(path, errors='replace') as f:
+        text = f.read()
+    names.update(re.findall(r'^\s*#\s*define\s+(\w+)', text, re.M))
+    for header in re.findall(r'^\s*#\s*include\s+"([^"]+)"', text, re.M):
+        for directory in [os.path.dirname(path)] + [os.path.join(ROOT, entry) for entry in INCLUDES]:
+            candidate = os.path.join(directory, header)
+            if os.path.isfile(candidate):
+                config_names(candidate, names)
+                break
+    return names
+
+
+def report(build, verbose):
+    out = sys.stdout
+
+    if build.objects:
+        out.write('%-28s %8s\n' % ('kernel object', 'bytes'))
+        out.write('%-28s %8s\n' % ('-' * 28, '-' * 8))
+        for name, size in build.objects:
+            out.write('%-28s %8d\n' % (name, size))
+        out.write('\n')
+
+    out.write('%-28s %8s %8s %8s %8s %8s %8s\n' %
+              ('file', 'text', 'rodata', 'data', 'bss', 'flash', 'RAM'))
+    out.write('%-28s %8s %8s %8s %8s %8s %8s\n' % (('-' * 28,) + ('-' * 8,) * 6))
+    for source in sorted(build.files):
+        size = build.files[source].size
+        if not any(size.values()):
+            continue
+        out.write('%-28s %8d %8d %8d %8d %8d %8d\n' %
+                  (source, size['text'], size['rodata'], size['data'], size['bss'],
+                   size['text'] + size['rodata'] + size['data'], size['data'] + size['bss']))
+    out.write('%-28s %8d %8d %8d %8d %8d %8d\n\n' %
+              ('total', build.total('text'), build.total('rodata'), build.total('data'),
+               build.total('bss'), build.flash(), build.ram()))
+
+    ram_map = build.ram_map()
+    out.write('%-28s %8s  %s\n' % ('static RAM', 'bytes', 'symbols'))
+    out.write('%-28s %8s  %s\n' % ('-' * 28, '-' * 8, '-' * 40))
+    for category, _ in CATEGORIES:
+        symbols = sorted(ram_map.get(category, []), key=lambda item: -item[1])
+        if not symbols:
+            continue
+        names = ', '.join('%s %d' % (name, size) for name, size, _ in symbols[:4])
+        if len(symbols) > 4:
+            names += ', ...'
+        out.write('%-28s %8d  %s\n' % (category, sum(item[1] for item in symbols), names))
+        if verbose:
+            for name, size, source in symbols:
+                out.write('    %-24s %8d  %s\n' % (name, size, source))
+    out.write('%-28s %8d\n' % ('total', build.ram()))
+
+
+def explore(args, config, base):
+    """Rebuild with each option off and each parameter reduced."""
+    macros = base.macros()
+    names = config_names(config)
+    macros = dict((name, value) for name, value in macros.items() if name in names)
+    variants = []
+    for name in sorted(macros):
+        if name.startswith('RT_USING_') and macros[name] in ('', '1'):
+            variants.append(('-' + name, (), (name,)))
+    for name, values in sorted(PARAMETERS.items()):
+        try:
+            current = int(macros.get(name, ''), 0)
+        except ValueError:
+            continue
+        for value in values:
+            if value < current:
+                variants.append(('%s=%d' % (name, value), ('%s=%d' % (name, value),), ()))
+
+    out = sys.stdout
+    out.write('\n%-36s %8s %8s\n' % ('option', 'flash', 'RAM'))
+    out.write('%-36s %8s %8s\n' % ('-' * 36, '-' * 8, '-' * 8))
+
+    results, failures = [], []
+    for label, defines, undefs in variants:
+        build = Build(args, config, list(args.define) + list(defines),
+                      list(args.undef) + list(undefs)).run(args.jobs)
+        if build.failed:
+            # the first error, such as the #error of a dependent option
+            source, error = build.failed[0]
+            lines = [line for line in error.splitlines() if 'error' in line] or ['']
+            failures.append((label, '%s: %s' % (source, lines[0].split('error:')[-1].strip())))
+        else:
+            results.append((label, build.flash() - base.flash(), build.ram() - base.ram()))
+        build.clean()
+
+    # the largest saving of RAM first
+    for label, flash, ram in sorted(results, key=lambda item: (item[2], item[1])):
+        out.write('%-36s %+8d %+8d\n' % (label, flash, ram))
+    for label, reason in failures:
+        out.write('%-36s build failed, %s\n' % (label, reason))
+
+def main():
+    parser = argparse.ArgumentParser(description='report the static footprint of RT-Thread kernel')
+    parser.add_argument('config', nargs='?', default=os.path.join(ROOT, 'bsp', 'rtconfig.h'),
+                        help='rtconfig.h of the bsp, default to bsp/rtconfig.h')
+    parser.add_argument('--cc', default='gcc', help='C compiler, default to gcc of host')
+    parser.add_argument('--cflags', default='-Os -fno-pic',
+                        help='compiler flags of target, default to "-Os -fno-pic"')
+    parser.add_argument('-D', '--define', action='append', default=[], metavar='NAME[=VALUE]',
+                        help='define or override an option of the configuration')
+    parser.add_argument('-U', '--undef', action='append', default=[], metavar='NAME',
+                        help='undefine an option of the configuration')
+    parser.add_argument('-e', '--explore', action='store_true',
+                        help='list the savings of each option and parameter')
+    parser.add_argument('-v', '--verbose', action='store_true', help='list every symbol of RAM map')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1,
+                        help='number of parallel compilations')
+    parser.add_argument('-k', '--keep', action='store_true', help='keep the objects for inspection')
+    args = parser.parse_args()
+
+    base = Build(args, args.config, args.define, args.undef).run(args.jobs)
+    if args.keep:
+        sys.stderr.write('objects are kept in %s\n' % base.workdir)
+    for source, error in base.failed:
+        sys.stderr.write('error: failed to compile %s\n%s\n' % (source, error))
+    if base.failed:
+        base.clean()
+        sys.exit(1)
+
+    sys.stdout.write('footprint of %s, %s %s\n\n' % (os.path.relpath(args.config), args.cc, args.cflags))
+    report(base, args.verbose)
+    if args.explore:
+        explore(args, args.config, base)
+    base.clean()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2023, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     agent        first version
+#
+"""Convert the output of msh command `trace dump` to Chrome trace JSON.
+
+The output file can be opened in chrome://tracing or https://ui.perfetto.dev.
+
+usage: trace2json.py console.log [-o trace.json]
+"""
+
+import argparse
+import json
+import re
+import sys
+
+EVENT_SWITCH = 1
+EVENT_IRQ_ENTER = 2
+EVENT_IRQ_LEAVE = 3
+EVENT_IPC_TRYTAKE = 4
+EVENT_IPC_TAKE = 5
+EVENT_IPC_RELEASE = 6
+EVENT_THREAD_SUSPEND = 7
+EVENT_THREAD_RESUME = 8
+EVENT_TIMER_ENTER = 9
+EVENT_TIMER_EXIT = 10
+EVENT_MALLOC = 11
+EVENT_FREE = 12
+
+CLASS_NAMES = {
+    0x01: 'thread', 0x02: 'sem', 0x03: 'mutex', 0x04: 'event',
+    0x05: 'mailbox', 0x06: 'msgqueue', 0x0a: 'timer',
+}
+
+PID = 1
+TID_IRQ = 1
+TID_TIMER = 2
+TID_THREAD_BASE = 16
+
+HEADER_RE = re.compile(r'#RTTRACE\s+(\d+)\s+(\d+)\s+(\d+)')
+NAME_RE = re.compile(r'^N\s+([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+(.*)$')
+EVENT_RE = re.compile(r'^E\s+([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+([0-9a-fA-F]+)'
+                      r'\s+([0-9a-fA-F]+)\s+([0-9a-fA-F]+)')
+END_RE = re.compile(r'#END\s+(\d+)')
+
+
+def parse(lines):
+    """Return (freq, names, events, lost) of the last dump in lines."""
+    freq, names, events, lost = None, {}, [], 0
+
+    for line in lines:
+        line = line.strip()
+        # the console may prefix a dump line with the shell prompt
+        m = HEADER_RE.search(line)
+        if m:
+            if int(m.group(1)) != 1:
+                raise ValueError('unsupported trace version %s' % m.group(1))
+            freq, names, events, lost = int(m.group(2)), {}, [], 0
+            continue
+        if freq is None:
+            continue
+
+        m = NAME_RE.match(line)
+        if m:
+            names[int(m.group(1), 16)] = (int(m.group(2), 16), m.group(3).strip())
+            continue
+        m = EVENT_RE.match(line)
+        if m:
+            events.append(tuple(int(v, 16) for v in m.groups()))
+            continue
+        m = END_RE.search(line)
+        if m:
+            lost = int(m.group(1))
+
+    if freq is None:
+        raise ValueError('no trace dump found')
+    return freq, names, events, lost
+
+
+def convert(freq, names, events):
+    out = []
+    tids = {}
+    current = None
+    heap = {}
+    heap_used = 0
+
+    def name_of(addr):
+        if addr in names:
+            return names[addr][1]
+        return '0x%x' % addr
+
+    def tid_of(thread):
+        if thread not in tids:
+            tids[thread] = TID_THREAD_BASE + len(tids)
+            out.append({'ph': 'M', 'pid': PID, 'tid': tids[thread],
+                        'name': 'thread_name', 'args': {'name': name_of(thread)}})
+        return tids[thread]
+
+    out.append({'ph': 'M', 'pid': PID, 'name': 'process_name', 'args': {'name': 'rt-thread'}})
+    out.append({'ph': 'M', 'pid': PID, 'tid': TID_IRQ, 'name': 'thread_name', 'args': {'name': 'irq'}})
+    out.append({'ph': 'M', 'pid': PID, 'tid': TID_TIMER, 'name': 'thread_name', 'args': {'name': 'timer'}})
+
+    base, last, wrap = None, 0, 0
+    for stamp, etype, data, arg0, arg1 in events:
+        # unwrap the 32 bits timestamp
+        if base is None:
+            base, last = stamp, stamp
+        if stamp < last:
+            wrap += 1 << 32
+        last = stamp
+        ts = (stamp + wrap - base) * 1e6 / freq
+
+        def instant(tid, name, args=None):
+            ev = {'ph': 'i', 's': 't', 'pid': PID, 'tid': tid, 'ts': ts, 'name': name}
+            if args:
+                ev['args'] = args
+            out.append(ev)
+
+        if etype == EVENT_SWITCH:
+            if current is not None:
+                out.append({'ph': 'E', 'pid': PID, 'tid': tid_of(current), 'ts': ts})
+            current = arg1
+            out.append({'ph': 'B', 'pid': PID, 'tid': tid_of(current), 'ts': ts,
+                        'name': name_of(current), 'args': {'priority': data}})
+        elif etype == EVENT_IRQ_ENTER:
+            out.append({'ph': 'B', 'pid': PID, 'tid': TID_IRQ, 'ts': ts,
+                        'name': 'irq', 'args': {'nest': data}})
+        elif etype == EVENT_IRQ_LEAVE:
+            out.append({'ph': 'E', 'pid': PID, 'tid': TID_IRQ, 'ts': ts})
+        elif etype in (EVENT_IPC_TRYTAKE, EVENT_IPC_TAKE, EVENT_IPC_RELEASE):
+            action = {EVENT_IPC_TRYTAKE: 'trytake', EVENT_IPC_TAKE: 'take',
+                      EVENT_IPC_RELEASE: 'release'}[etype]
+            kind = CLASS_NAMES.get(data & 0x7f, 'object')
+            tid = tid_of(current) if current is not None else TID_IRQ
+            instant(tid, '%s %s %s' % (action, kind, name_of(arg0)))
+        elif etype == EVENT_THREAD_SUSPEND:
+            instant(tid_of(arg0), 'block')
+        elif etype == EVENT_THREAD_RESUME:
+            instant(tid_of(arg0), 'wakeup')
+        elif etype == EVENT_TIMER_ENTER:
+            out.append({'ph': 'B', 'pid': PID, 'tid': TID_TIMER, 'ts': ts,
+                        'name': name_of(arg0), 'args': {'func': '0x%x' % arg1}})
+        elif etype == EVENT_TIMER_EXIT:
+            out.append({'ph': 'E', 'pid': PID, 'tid': TID_TIMER, 'ts': ts})
+        elif etype == EVENT_MALLOC:
+            heap[arg0] = arg1
+            heap_used += arg1
+            out.append({'ph': 'C', 'pid': PID, 'ts': ts, 'name': 'heap', 'args': {'used': heap_used}})
+        elif etype == EVENT_FREE:
+            heap_used -= heap.pop(arg0, 0)
+            out.append({'ph': 'C', 'pid': PID, 'ts': ts, 'name': 'heap', 'args': {'used': heap_used}})
+
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description='convert RT-Thread trace dump to Chrome trace JSON')
+    parser.add_argument('input', help='console log which contains the output of "trace dump"')
+    parser.add_argument('-o', '--output', help='output JSON file, default to stdout')
+    args = parser.parse_args()
+
+    with open(args.input, errors='replace') as f:
+        freq, names, events, lost = parse(f)
+
+    if lost:
+        sys.stderr.write('warning: %d events were overwritten before dump\n' % lost)
+
+    trace = {'traceEvents': convert(freq, names, events), 'displayTimeUnit': 'ns'}
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()